@@ -52,6 +52,13 @@
 #ifndef P3M_BRILLOUIN
 #define P3M_BRILLOUIN 0
 #endif
+/** P3M: Number of Brillouin zones taken into account in the optimal
+ *  influence function for analytical differentiation, which depends
+ *  much more on the aliasing sums than the one for i*k differentiation.
+ */
+#ifndef P3M_BRILLOUIN_AD
+#define P3M_BRILLOUIN_AD 1
+#endif
 /** P3M: Maximal mesh size that will be checked. The current setting
  *  limits the memory consumption to below 1GB, which is probably
  *  reasonable for a while.
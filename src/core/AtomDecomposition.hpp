@@ -79,6 +79,7 @@ public:
   Utils::Span<Cell *> ghost_cells() override {
     return Utils::make_span(m_ghost_cells);
   }
+  Utils::Span<Cell *> pair_cells() override { return local_cells(); }
 
   /**
    * @brief Determine which cell a particle id belongs to.
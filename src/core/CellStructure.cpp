@@ -26,7 +26,10 @@
 
 #include <utils/contains.hpp>
 
+#include <boost/algorithm/cxx11/any_of.hpp>
+
 #include <stdexcept>
+#include <unordered_set>
 
 void CellStructure::check_particle_index() {
   auto const max_id = get_max_local_particle_id();
@@ -95,6 +98,7 @@ void CellStructure::remove_particle(int id) {
         it = parts.erase(it);
         update_particle_index(id, nullptr);
         update_particle_index(parts);
+        m_rebuild_soa = true;
       } else {
         remove_all_bonds_to(it->bonds());
         it++;
@@ -103,6 +107,39 @@ void CellStructure::remove_particle(int id) {
   }
 }
 
+void CellStructure::remove_particles(std::vector<int> const &ids) {
+  std::unordered_set<int> const removed(ids.begin(), ids.end());
+  auto const is_removed = [&removed](int id) { return removed.count(id) != 0; };
+
+  for (auto c : decomposition().local_cells()) {
+    auto &parts = c->particles();
+    auto modified = false;
+
+    for (auto it = parts.begin(); it != parts.end();) {
+      if (is_removed(it->identity())) {
+        update_particle_index(it->identity(), nullptr);
+        it = parts.erase(it);
+        modified = true;
+      } else {
+        auto &bl = it->bonds();
+        for (auto bond = bl.begin(); bond != bl.end();) {
+          if (boost::algorithm::any_of(bond->partner_ids(), is_removed)) {
+            bond = bl.erase(bond);
+          } else {
+            std::advance(bond, 1);
+          }
+        }
+        it++;
+      }
+    }
+
+    if (modified) {
+      update_particle_index(parts);
+      m_rebuild_soa = true;
+    }
+  }
+}
+
 Particle *CellStructure::add_local_particle(Particle &&p) {
   auto const sort_cell = particle_to_cell(p);
   if (sort_cell) {
@@ -139,6 +176,7 @@ void CellStructure::remove_all_particles() {
   for (auto c : decomposition().local_cells()) {
     c->particles().clear();
   }
+  m_rebuild_soa = true;
 
   m_particle_index.clear();
 }
@@ -158,19 +196,54 @@ static unsigned map_data_parts(unsigned data_parts) {
   /* clang-format on */
 }
 
+unsigned CellStructure::ghost_data_parts(unsigned data_parts) {
+  auto ghost_parts = map_data_parts(data_parts);
+
+  if (use_ghost_position_deltas and
+      (data_parts & Cells::DATA_PART_POSITION_DELTA) and
+      (ghost_parts & GHOSTTRANS_POSITION)) {
+    if (m_ghost_position_refs) {
+      ghost_parts &= ~GHOSTTRANS_POSITION;
+      ghost_parts |= GHOSTTRANS_POSITION_DELTA;
+    } else {
+      /* First update after a resort, send the references along */
+      ghost_parts |= GHOSTTRANS_POSITION_REF;
+      m_ghost_position_refs = true;
+    }
+  }
+
+  return ghost_parts;
+}
+
 void CellStructure::ghosts_update(unsigned data_parts) {
   ghost_communicator(decomposition().exchange_ghosts_comm(),
-                     map_data_parts(data_parts));
+                     ghost_data_parts(data_parts));
 }
 void CellStructure::ghosts_reduce_forces() {
   ghost_communicator(decomposition().collect_ghost_force_comm(),
                      GHOSTTRANS_FORCE);
 }
+void CellStructure::ghosts_update_begin(unsigned data_parts) {
+  ghost_communicator_begin(decomposition().exchange_ghosts_comm(),
+                           ghost_data_parts(data_parts));
+}
+void CellStructure::ghosts_reduce_forces_begin() {
+  ghost_communicator_begin(decomposition().collect_ghost_force_comm(),
+                           GHOSTTRANS_FORCE);
+}
+void CellStructure::ghosts_finish() { ghost_communicator_finish(); }
+bool CellStructure::ghosts_pending() const {
+  return ghost_communicator_pending();
+}
 
 Utils::Span<Cell *> CellStructure::local_cells() {
   return decomposition().local_cells();
 }
 
+Utils::Span<Cell *> CellStructure::pair_cells() {
+  return decomposition().pair_cells();
+}
+
 ParticleRange CellStructure::local_particles() {
   return Cells::particles(decomposition().local_cells());
 }
@@ -202,6 +275,7 @@ struct UpdateParticleIndexVisitor {
 } // namespace
 
 void CellStructure::resort_particles(int global_flag) {
+  ghosts_finish();
   invalidate_ghosts();
 
   static std::vector<ParticleChange> diff;
@@ -212,12 +286,17 @@ void CellStructure::resort_particles(int global_flag) {
   /* Communication step: number of ghosts and ghost information */
   ghost_communicator(m_decomposition->exchange_ghosts_comm(),
                      GHOSTTRANS_PARTNUM);
+  m_ghost_position_refs = false;
+  update_shared_memory(m_decomposition->exchange_ghosts_comm());
+  update_shared_memory(m_decomposition->collect_ghost_force_comm());
 
   for (auto d : diff) {
     boost::apply_visitor(UpdateParticleIndexVisitor{this}, d);
   }
 
   m_rebuild_verlet_list = true;
+  m_rebuild_soa = true;
+  m_rebuild_cluster_pairs = true;
 
 #ifdef ADDITIONAL_CHECKS
   check_particle_index();
@@ -235,6 +314,18 @@ void CellStructure::set_domain_decomposition(
     boost::mpi::communicator const &comm, double range, BoxGeometry const &box,
     LocalBox<double> const &local_geo) {
   set_particle_decomposition(
-      std::make_unique<DomainDecomposition>(comm, range, box, local_geo));
+      std::make_unique<DomainDecomposition>(comm, range, box, local_geo,
+                                            use_morton_order,
+                                            use_neighbor_collectives,
+                                            use_shared_memory));
   m_type = CELL_STRUCTURE_DOMDEC;
 }
+
+void CellStructure::set_eighth_shell_decomposition(
+    boost::mpi::communicator const &comm, double range, BoxGeometry const &box,
+    LocalBox<double> const &local_geo) {
+  set_particle_decomposition(std::make_unique<DomainDecomposition>(
+      comm, range, box, local_geo, use_morton_order, use_neighbor_collectives,
+      use_shared_memory, true));
+  m_type = CELL_STRUCTURE_EIGHTH_SHELL;
+}
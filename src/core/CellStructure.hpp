@@ -25,21 +25,39 @@
 #include "AtomDecomposition.hpp"
 #include "BoxGeometry.hpp"
 #include "Cell.hpp"
+#include "ClusterPairList.hpp"
 #include "LocalBox.hpp"
 #include "Particle.hpp"
 #include "ParticleDecomposition.hpp"
 #include "ParticleList.hpp"
 #include "ParticleRange.hpp"
+#include "ParticleSoA.hpp"
+#include "algorithm/cell_coloring.hpp"
 #include "algorithm/link_cell.hpp"
 #include "bond_error.hpp"
+#include "config.hpp"
+#include "exclusions.hpp"
 #include "ghosts.hpp"
 
+#include <utils/as_const.hpp>
+
+#include <boost/algorithm/cxx11/all_of.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/container/static_vector.hpp>
 #include <boost/iterator/indirect_iterator.hpp>
+#include <boost/range/algorithm/copy.hpp>
 #include <boost/range/algorithm/find_if.hpp>
 #include <boost/range/algorithm/transform.hpp>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <unordered_set>
 #include <vector>
 
 /** Cell Structure */
@@ -47,7 +65,9 @@ enum CellStructureType : int {
   /** cell structure domain decomposition */
   CELL_STRUCTURE_DOMDEC = 1,
   /** cell structure n square */
-  CELL_STRUCTURE_NSQUARE = 2
+  CELL_STRUCTURE_NSQUARE = 2,
+  /** cell structure domain decomposition with the eighth-shell method */
+  CELL_STRUCTURE_EIGHTH_SHELL = 3
 };
 
 namespace Cells {
@@ -64,6 +84,10 @@ enum DataPart : unsigned {
   DATA_PART_NONE = 0u,       /**< Nothing */
   DATA_PART_PROPERTIES = 1u, /**< Particle::p */
   DATA_PART_POSITION = 2u,   /**< Particle::r */
+  /** Particle::r may be sent as single precision displacement
+   *  since the last resort, see
+   *  @ref CellStructure::use_ghost_position_deltas */
+  DATA_PART_POSITION_DELTA = 4u,
   DATA_PART_MOMENTUM = 8u,   /**< Particle::m */
   DATA_PART_FORCE = 16u,     /**< Particle::f */
   DATA_PART_BONDS = 32u      /**< Particle::bonds */
@@ -91,6 +115,10 @@ struct Distance {
 
   Utils::Vector3d vec21;
   double dist2;
+  /** The pair is excluded from the short-range potentials. This is
+   *  resolved by the pair loops, with neighbor lists only once when
+   *  the lists are built. */
+  bool excluded = false;
 };
 namespace detail {
 struct MinimalImageDistance {
@@ -106,8 +134,30 @@ struct EuclidianDistance {
     return Distance(p1.r.p - p2.r.p);
   }
 };
+
+/** Is the pair excluded from the short-range potentials? */
+inline bool is_excluded(Particle const &p1, Particle const &p2) {
+#ifdef EXCLUSIONS
+  return not do_nonbonded(p1, p2);
+#else
+  return false;
+#endif
+}
 } // namespace detail
 
+/**
+ * @brief Does a pair that passed the Verlet criterion interact
+ *        by the short-range interactions of its particle types?
+ *
+ * Criteria that do not tell the interaction classes apart put
+ * all pairs into the short-range class.
+ */
+template <class Criterion, class Distance>
+bool short_range_class(Criterion const &, Particle const &, Particle const &,
+                       Distance const &) {
+  return true;
+}
+
 /** Describes a cell structure / cell system. Contains information
  *  about the communication of cell contents (particles, ghosts, ...)
  *  between different nodes and the relation between particle
@@ -128,10 +178,69 @@ private:
    */
   unsigned m_resort_particles = Cells::RESORT_NONE;
   bool m_rebuild_verlet_list = true;
-  std::vector<std::pair<Particle *, Particle *>> m_verlet_list;
+  /** Verlet list of every local cell */
+  std::vector<std::vector<std::pair<Particle *, Particle *>>> m_verlet_lists;
+  /** Verlet list of every local cell with the pairs that are only
+   *  within the electrostatic, magnetostatic or collision cutoff,
+   *  if @ref use_pair_class_lists is set. */
+  std::vector<std::vector<std::pair<Particle *, Particle *>>>
+      m_long_cutoff_verlet_lists;
+#ifdef EXCLUSIONS
+  /** Exclusion bit of every pair in @ref m_verlet_lists. The pairs in
+   *  @ref m_long_cutoff_verlet_lists need none, they are beyond the
+   *  range of the short-range potentials anyway. */
+  std::vector<std::vector<bool>> m_verlet_exclusions;
+#endif
+  bool m_rebuild_soa = true;
+  ParticleSoA m_soa;
+  bool m_rebuild_cluster_pairs = true;
+  ClusterPairList m_cluster_pairs;
+  bool m_rebuild_cell_colors = true;
+  /** Local cells by color for the threaded pair loops */
+  std::vector<std::vector<std::size_t>> m_pair_colors;
+  /** Local cells by color for the threaded bond loop */
+  std::vector<std::vector<std::size_t>> m_bond_colors;
+  bool m_rebuild_interior_cells = true;
+  /** Whether all red neighbors of a local cell are local cells,
+   *  so that its pairs need no ghosts, by index */
+  std::vector<bool> m_interior_cells;
+  /** Do the ghosts know the positions of their originals at the
+   *  last resort? */
+  bool m_ghost_position_refs = false;
+
+  /** Ghost communication flags for cell data parts, with positions
+   *  as displacements where allowed and possible. */
+  unsigned ghost_data_parts(unsigned data_parts);
 
 public:
   bool use_verlet_list = true;
+  /** Use a @ref ClusterPairList instead of particle pairs as
+   *  Verlet list, if supported by the decomposition. */
+  bool use_cluster_pair_list = false;
+  /** Use the structure-of-arrays pair kernels where possible. */
+  bool use_soa_kernels = false;
+  /** Keep cells and particles of a domain decomposition in Morton
+   *  order, takes effect when the decomposition is set. */
+  bool use_morton_order = false;
+  /** Exchange the ghosts of a domain decomposition by neighborhood
+   *  collectives, takes effect when the decomposition is set. */
+  bool use_neighbor_collectives = false;
+  /** Exchange the ghosts of a domain decomposition with nodes on the
+   *  same host by shared memory, takes effect when the decomposition
+   *  is set. */
+  bool use_shared_memory = false;
+  /** Keep the pairs that are only within the electrostatic,
+   *  magnetostatic or collision cutoff in separate Verlet lists,
+   *  takes effect with the next rebuild of the lists. */
+  bool use_pair_class_lists = false;
+  /** Overlap the ghost update of the integration steps with the
+   *  pairs that need no ghosts, and the reduction of the ghost
+   *  forces with the long-range forces where possible. */
+  bool use_ghost_overlap = false;
+  /** Send the positions of the ghost updates between resorts as
+   *  single precision displacements from the positions at the last
+   *  resort, where requested by @ref Cells::DATA_PART_POSITION_DELTA. */
+  bool use_ghost_position_deltas = false;
 
   /**
    * @brief Update local particle index.
@@ -193,6 +302,7 @@ private:
      * updated. */
     auto const may_reallocate = pl.size() >= pl.capacity();
     auto &new_part = pl.insert(std::move(p));
+    m_rebuild_soa = true;
 
     if (may_reallocate)
       update_particle_index(pl);
@@ -247,6 +357,7 @@ public:
 
 private:
   Utils::Span<Cell *> local_cells();
+  Utils::Span<Cell *> pair_cells();
 
 public:
   ParticleRange local_particles();
@@ -302,6 +413,16 @@ public:
    */
   void remove_particle(int id);
 
+  /**
+   * @brief Remove several particles at once.
+   *
+   * Removes the local particles with the ids, and all
+   * bonds of the local particles to any of them.
+   *
+   * @param ids Identities of the particles to remove.
+   */
+  void remove_particles(std::vector<int> const &ids);
+
   /**
    * @brief Get the maximal particle id on this node.
    *
@@ -370,6 +491,33 @@ public:
    */
   void ghosts_reduce_forces();
 
+  /**
+   * @brief Start a ghost update, without waiting for the data.
+   *
+   * The update has to be completed by @ref ghosts_finish before
+   * the ghosts are used, see @ref ghost_communicator_begin.
+   *
+   * @param data_parts Particle parts to update, combination of @ref
+   * Cells::DataPart
+   */
+  void ghosts_update_begin(unsigned data_parts);
+
+  /**
+   * @brief Start adding the forces of the ghosts to the real particles.
+   *
+   * The forces of the real particles are complete after @ref
+   * ghosts_finish.
+   */
+  void ghosts_reduce_forces_begin();
+
+  /**
+   * @brief Finish a pending ghost update or force reduction.
+   */
+  void ghosts_finish();
+
+  /** Is a ghost update or force reduction pending? */
+  bool ghosts_pending() const;
+
 private:
   /**
    * @brief Resolve ids to particles.
@@ -416,9 +564,15 @@ private:
             handler(p, bond.bond_id(), Utils::make_span(partners));
 
         if (bond_broken) {
+#ifdef _OPENMP
+#pragma omp critical(bond_broken_error)
+#endif
           bond_broken_error(p.identity(), partner_ids);
         }
       } catch (const BondResolutionError &) {
+#ifdef _OPENMP
+#pragma omp critical(bond_broken_error)
+#endif
         bond_broken_error(p.identity(), partner_ids);
       }
     }
@@ -449,7 +603,12 @@ private:
     clear_particle_index();
 
     /* Swap in new cell system */
+    ghosts_finish();
     std::swap(m_decomposition, decomposition);
+    m_rebuild_soa = true;
+    m_rebuild_cell_colors = true;
+    m_rebuild_interior_cells = true;
+    m_ghost_position_refs = false;
 
     /* Add particles to new system */
     for (auto &p : Cells::particles(decomposition->local_cells())) {
@@ -480,6 +639,19 @@ public:
                                 double range, BoxGeometry const &box,
                                 LocalBox<double> const &local_geo);
 
+  /**
+   * @brief Set the particle decomposition to
+   *        DomainDecomposition with the eighth-shell method,
+   *        which imports the ghosts only from the upper neighbors.
+   *
+   *        @param comm Cartesian communicator to use.
+   *        @param box Box Geometry
+   *        @param local_geo Geometry of the local box.
+   */
+  void set_eighth_shell_decomposition(boost::mpi::communicator const &comm,
+                                      double range, BoxGeometry const &box,
+                                      LocalBox<double> const &local_geo);
+
 public:
   template <class BondKernel> void bond_loop(BondKernel const &bond_kernel) {
     for (auto &p : local_particles()) {
@@ -487,72 +659,338 @@ public:
     }
   }
 
+  /**
+   * @brief Bond loop that runs the kernel in several threads.
+   *
+   * The local cells are processed by color, bonds with all partners
+   * in the cell of the particle or its neighbor cells are evaluated
+   * concurrently. The remaining bonds, e.g. with partners that are
+   * periodic images within the same domain, are evaluated afterwards
+   * by a single thread. Without OpenMP, or with only one thread, this
+   * is the same as @ref bond_loop.
+   *
+   * @param bond_kernel Kernel to apply, it may only modify the
+   *        particles it is called with.
+   */
+  template <class BondKernel>
+  void parallel_bond_loop(BondKernel const &bond_kernel) {
+#ifdef _OPENMP
+    if (omp_get_max_threads() > 1) {
+      struct DeferredBond {
+        Particle *p;
+        int bond_id;
+        boost::container::static_vector<Particle *, 4> partners;
+      };
+      std::vector<DeferredBond> deferred;
+
+      update_cell_colors();
+      auto const cells = local_cells();
+      colored_cell_loop(m_bond_colors, [&](std::size_t index) {
+        auto const cell = cells[index];
+        auto const in_neighborhood = [cell](Particle const *p) {
+          auto const contains = [p](Cell *c) {
+            auto const less = std::less<Particle const *>{};
+            return not less(p, c->particles().begin()) and
+                   less(p, c->particles().end());
+          };
+          return contains(cell) or
+                 boost::algorithm::any_of(cell->neighbors().all(), contains);
+        };
+
+        for (auto &p : cell->particles()) {
+          execute_bond_handler(p, [&](Particle &p1, int bond_id,
+                                      Utils::Span<Particle *> partners) {
+            if (boost::algorithm::all_of(partners, in_neighborhood)) {
+              return bond_kernel(p1, bond_id, partners);
+            }
+#pragma omp critical(parallel_bond_loop)
+            deferred.push_back({&p1, bond_id, {partners.begin(),
+                                               partners.end()}});
+            return false;
+          });
+        }
+      });
+
+      for (auto &bond : deferred) {
+        if (bond_kernel(*bond.p, bond.bond_id,
+                        Utils::make_span(bond.partners))) {
+          boost::container::static_vector<int, 4> partner_ids;
+          boost::transform(bond.partners, std::back_inserter(partner_ids),
+                           [](Particle const *p) { return p->identity(); });
+          bond_broken_error(bond.p->identity(),
+                            Utils::make_const_span(partner_ids));
+        }
+      }
+      return;
+    }
+#endif
+    bond_loop(bond_kernel);
+  }
+
 private:
+  /** @brief Recolor the cells if the decomposition changed. */
+  void update_cell_colors() {
+    if (m_rebuild_cell_colors) {
+      /* The pair kernels of a cell modify the cell and its red
+       * neighbors, bonds can reach into all neighbor cells. */
+      m_pair_colors = Algorithm::color_cells(pair_cells(), [](Cell *cell) {
+        std::vector<Cell *> targets{cell};
+        boost::copy(cell->neighbors().red(), std::back_inserter(targets));
+        return targets;
+      });
+      m_bond_colors = Algorithm::color_cells(local_cells(), [](Cell *cell) {
+        std::vector<Cell *> targets{cell};
+        boost::copy(cell->neighbors().all(), std::back_inserter(targets));
+        return targets;
+      });
+      m_rebuild_cell_colors = false;
+    }
+  }
+
+  /** @brief Classify the pair cells if the decomposition changed. */
+  void update_interior_cells() {
+    if (m_rebuild_interior_cells) {
+      auto const local_cells = this->local_cells();
+      std::unordered_set<Cell const *> const local(local_cells.begin(),
+                                                   local_cells.end());
+      auto const cells = pair_cells();
+      m_interior_cells.resize(cells.size());
+      for (std::size_t i = 0; i < cells.size(); i++) {
+        auto const is_local = [&local](Cell const *cell) {
+          return local.count(cell) != 0;
+        };
+        m_interior_cells[i] =
+            is_local(cells[i]) and
+            boost::algorithm::all_of(cells[i]->neighbors().red(), is_local);
+      }
+      m_rebuild_interior_cells = false;
+    }
+  }
+
+  /**
+   * @brief Run a kernel for the interior or the other pair cells,
+   *        see @ref update_interior_cells.
+   *
+   * @param interior Which of the cells to visit.
+   * @param kernel Callable with the index of a pair cell.
+   * @param parallel Distribute the cells over the threads.
+   */
+  template <class Kernel>
+  void interior_cell_loop(bool interior, Kernel const &kernel,
+                          bool parallel) {
+    auto const filtered_kernel = [&](std::size_t cell) {
+      if (m_interior_cells[cell] == interior)
+        kernel(cell);
+    };
+#ifdef _OPENMP
+    if (parallel and omp_get_max_threads() > 1) {
+      update_cell_colors();
+      colored_cell_loop(m_pair_colors, filtered_kernel);
+      return;
+    }
+#endif
+    for (std::size_t cell = 0; cell < m_interior_cells.size(); cell++) {
+      filtered_kernel(cell);
+    }
+  }
+
+  /**
+   * @brief Run a kernel for all local cells, color by color.
+   *
+   * The cells of one color are distributed over the threads.
+   * An exception thrown by the kernel is rethrown after the loop.
+   *
+   * @param colors Indices of the local cells by color.
+   * @param kernel Callable with the index of a local cell.
+   */
+  template <class Kernel>
+  static void
+  colored_cell_loop(std::vector<std::vector<std::size_t>> const &colors,
+                    Kernel const &kernel) {
+    std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (auto const &color : colors) {
+      auto const n_cells = static_cast<long>(color.size());
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for (long i = 0; i < n_cells; i++) {
+        try {
+          kernel(color[i]);
+        } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(colored_cell_loop)
+#endif
+          if (not error)
+            error = std::current_exception();
+        }
+      }
+    }
+
+    if (error)
+      std::rethrow_exception(error);
+  }
+
   /**
-   * @brief Run link_cell algorithm for local cells.
+   * @brief Run link_cell algorithm for the pair cells.
    *
    * @tparam Kernel Needs to be callable with (Particle, Particle, Distance).
    * @param kernel Pair kernel functor.
    */
   template <class Kernel> void link_cell(Kernel kernel) {
+    link_cell(kernel, 0, pair_cells().size());
+  }
+
+  /**
+   * @brief Run link_cell algorithm for a range of pair cells.
+   *
+   * The pairs within a cell are only visited for the local
+   * cells, the ghost cells only contribute their pairs with
+   * the red neighbors.
+   *
+   * @tparam Kernel Needs to be callable with (Particle, Particle, Distance).
+   * @param kernel Pair kernel functor.
+   * @param first_cell Index of the first pair cell.
+   * @param last_cell Index of one past the last pair cell.
+   */
+  template <class Kernel>
+  void link_cell(Kernel kernel, std::size_t first_cell,
+                 std::size_t last_cell) {
     auto const maybe_box = decomposition().minimum_image_distance();
-    auto const first = boost::make_indirect_iterator(local_cells().begin());
-    auto const last = boost::make_indirect_iterator(local_cells().end());
+    auto const cells = pair_cells();
+    auto const n_local =
+        std::min(std::max(local_cells().size(), first_cell), last_cell);
+    auto const cell = [&cells](std::size_t index) {
+      return boost::make_indirect_iterator(cells.begin() + index);
+    };
+    auto const first = cell(first_cell);
+    auto const ghosts = cell(n_local);
+    auto const last = cell(last_cell);
+
+    auto const run = [&](auto const &pair_kernel) {
+      Algorithm::link_cell(first, ghosts, pair_kernel);
+      Algorithm::link_cell_neighbors(ghosts, last, pair_kernel);
+    };
 
     if (maybe_box) {
-      Algorithm::link_cell(
-          first, last,
-          [&kernel, df = detail::MinimalImageDistance{*maybe_box}](
+      run([&kernel, df = detail::MinimalImageDistance{*maybe_box}](
               Particle &p1, Particle &p2) { kernel(p1, p2, df(p1, p2)); });
     } else {
-      Algorithm::link_cell(
-          first, last,
-          [&kernel, df = detail::EuclidianDistance{}](
+      run([&kernel, df = detail::EuclidianDistance{}](
               Particle &p1, Particle &p2) { kernel(p1, p2, df(p1, p2)); });
     }
   }
 
-  /** Non-bonded pair loop with verlet lists.
+  /** Non-bonded pair loop with the verlet list of one pair cell.
    *
+   * @param cell Index of the pair cell
    * @param pair_kernel Kernel to apply
+   * @param long_cutoff_kernel Kernel to apply to the pairs that are
+   *        not in the short-range class, see @ref use_pair_class_lists.
    * @param verlet_criterion Filter for verlet lists.
    */
-  template <class PairKernel, class VerletCriterion>
-  void verlet_list_loop(PairKernel pair_kernel,
-                        const VerletCriterion &verlet_criterion) {
+  template <class PairKernel, class LongCutoffKernel, class VerletCriterion>
+  void verlet_list_cell_loop(std::size_t cell, PairKernel &pair_kernel,
+                             LongCutoffKernel &long_cutoff_kernel,
+                             const VerletCriterion &verlet_criterion) {
+    auto &verlet_list = m_verlet_lists[cell];
+    auto &long_cutoff_list = m_long_cutoff_verlet_lists[cell];
+#ifdef EXCLUSIONS
+    auto &exclusions = m_verlet_exclusions[cell];
+#endif
+
     /* In this case the verlet list update is attached to
      * the pair kernel, and the verlet list is rebuilt as
-     * we go. */
+     * we go. The exclusions are resolved here once, so
+     * that reusing the list does not look at them. */
     if (m_rebuild_verlet_list) {
-      m_verlet_list.clear();
-
-      link_cell([&](Particle &p1, Particle &p2, Distance const &d) {
-        if (verlet_criterion(p1, p2, d)) {
-          m_verlet_list.emplace_back(&p1, &p2);
+      verlet_list.clear();
+      long_cutoff_list.clear();
+#ifdef EXCLUSIONS
+      exclusions.clear();
+#endif
+
+      link_cell(
+          [&](Particle &p1, Particle &p2, Distance d) {
+            if (verlet_criterion(p1, p2, d)) {
+              if (not use_pair_class_lists or
+                  short_range_class(verlet_criterion, p1, p2, d)) {
+                d.excluded = detail::is_excluded(p1, p2);
+                verlet_list.emplace_back(&p1, &p2);
+#ifdef EXCLUSIONS
+                exclusions.push_back(d.excluded);
+#endif
+                pair_kernel(p1, p2, d);
+              } else {
+                long_cutoff_list.emplace_back(&p1, &p2);
+                long_cutoff_kernel(p1, p2, d);
+              }
+            }
+          },
+          cell, cell + 1);
+    } else {
+      /* In this case the pair kernel is just run over the verlet list. */
+      auto const run = [&](auto const &distance_function) {
+        for (std::size_t k = 0; k < verlet_list.size(); k++) {
+          auto &p1 = *verlet_list[k].first;
+          auto &p2 = *verlet_list[k].second;
+          auto d = distance_function(p1, p2);
+#ifdef EXCLUSIONS
+          d.excluded = exclusions[k];
+#endif
           pair_kernel(p1, p2, d);
         }
-      });
+        for (auto &pair : long_cutoff_list) {
+          long_cutoff_kernel(*pair.first, *pair.second,
+                             distance_function(*pair.first, *pair.second));
+        }
+      };
 
-      m_rebuild_verlet_list = false;
-    } else {
       auto const maybe_box = decomposition().minimum_image_distance();
-      /* In this case the pair kernel is just run over the verlet list. */
       if (maybe_box) {
-        auto const distance_function = detail::MinimalImageDistance{*maybe_box};
-        for (auto &pair : m_verlet_list) {
-          pair_kernel(*pair.first, *pair.second,
-                      distance_function(*pair.first, *pair.second));
-        }
+        run(detail::MinimalImageDistance{*maybe_box});
       } else {
-        auto const distance_function = detail::EuclidianDistance{};
-        for (auto &pair : m_verlet_list) {
-          pair_kernel(*pair.first, *pair.second,
-                      distance_function(*pair.first, *pair.second));
-        }
+        run(detail::EuclidianDistance{});
       }
     }
   }
 
+  /** Resize the verlet lists to the number of pair cells,
+   *  if they are going to be rebuilt. */
+  void prepare_verlet_lists() {
+    if (m_rebuild_verlet_list) {
+      auto const n_cells = pair_cells().size();
+      m_verlet_lists.resize(n_cells);
+      m_long_cutoff_verlet_lists.resize(n_cells);
+#ifdef EXCLUSIONS
+      m_verlet_exclusions.resize(n_cells);
+#endif
+    }
+  }
+
+  /** Non-bonded pair loop with verlet lists.
+   *
+   * @param pair_kernel Kernel to apply
+   * @param long_cutoff_kernel Kernel to apply to the pairs that are
+   *        not in the short-range class.
+   * @param verlet_criterion Filter for verlet lists.
+   */
+  template <class PairKernel, class LongCutoffKernel, class VerletCriterion>
+  void verlet_list_loop(PairKernel pair_kernel,
+                        LongCutoffKernel long_cutoff_kernel,
+                        const VerletCriterion &verlet_criterion) {
+    prepare_verlet_lists();
+
+    for (std::size_t cell = 0; cell < m_verlet_lists.size(); cell++) {
+      verlet_list_cell_loop(cell, pair_kernel, long_cutoff_kernel,
+                            verlet_criterion);
+    }
+
+    m_rebuild_verlet_list = false;
+  }
+
 public:
   /** Non-bonded pair loop.
    * @param pair_kernel Kernel to apply
@@ -561,6 +999,223 @@ public:
     link_cell(pair_kernel);
   }
 
+private:
+  /** Wrap a pair kernel for the loops without neighbor lists,
+   *  which have to look up the exclusions of every pair. */
+  template <class PairKernel>
+  static auto resolving_exclusions(PairKernel &pair_kernel) {
+    return [&pair_kernel](Particle &p1, Particle &p2, Distance d) {
+      d.excluded = detail::is_excluded(p1, p2);
+      pair_kernel(p1, p2, d);
+    };
+  }
+
+  /**
+   * @brief Rebuild the layout of the particle mirror, if
+   *        the particles were resorted since the last call.
+   */
+  void update_soa_layout() {
+    if (m_rebuild_soa) {
+      m_soa.rebuild(decomposition().local_cells(),
+                    decomposition().ghost_cells(),
+                    ClusterPairList::cluster_size);
+      m_rebuild_soa = false;
+      m_rebuild_cluster_pairs = true;
+    }
+  }
+
+  /**
+   * @brief Rebuild the cluster-pair list if needed.
+   *
+   * @param verlet_criterion Filter for the list.
+   */
+  template <class VerletCriterion>
+  void update_cluster_pair_list(const VerletCriterion &verlet_criterion) {
+    update_soa_layout();
+
+    if (m_rebuild_cluster_pairs) {
+      m_cluster_pairs.build(
+          m_soa, [&verlet_criterion, df = detail::EuclidianDistance{}](
+                     Particle const &p1, Particle const &p2) {
+            return verlet_criterion(p1, p2, df(p1, p2));
+          });
+      m_rebuild_cluster_pairs = false;
+    }
+  }
+
+  /** Non-bonded pair loop with cluster-pair lists.
+   *
+   * @param pair_kernel Kernel to apply
+   * @param verlet_criterion Filter for the list.
+   */
+  template <class PairKernel, class VerletCriterion>
+  void cluster_pair_loop(PairKernel pair_kernel,
+                         const VerletCriterion &verlet_criterion) {
+    update_cluster_pair_list(verlet_criterion);
+
+    m_cluster_pairs.for_each_pair(
+        m_soa, [&pair_kernel, df = detail::EuclidianDistance{}](
+                   Particle &p1, Particle &p2, bool excluded) {
+          auto d = df(p1, p2);
+          d.excluded = excluded;
+          pair_kernel(p1, p2, d);
+        });
+  }
+
+  /** Is the cluster-pair list used for Verlet lists? The mirror
+   *  only has the pairs of the local cells, so this is not
+   *  supported by the eighth-shell method. */
+  bool cluster_pair_list_active() const {
+    return use_verlet_list and use_cluster_pair_list and
+           not decomposition().minimum_image_distance() and
+           m_type != CELL_STRUCTURE_EIGHTH_SHELL;
+  }
+
+public:
+  /**
+   * @brief Non-bonded pair loop on the structure-of-arrays mirror.
+   *
+   * The mirror layout is rebuilt if the particles were resorted
+   * since the last call. The kernel is called once with the
+   * mirror, and with the @ref ClusterPairList if Verlet lists
+   * with clusters are in use. It has to accumulate the pair forces
+   * in the mirror, these are added to the particles afterwards.
+   *
+   * Only supported by cell systems that do not need a minimum
+   * image distance.
+   *
+   * @param kernel Callable with (ParticleSoA &) and
+   *        (ParticleSoA &, ClusterPairList const &).
+   * @param verlet_criterion Filter for the cluster-pair list.
+   */
+  template <class Kernel, class VerletCriterion>
+  void non_bonded_soa_loop(Kernel kernel,
+                           const VerletCriterion &verlet_criterion) {
+    assert(not decomposition().minimum_image_distance());
+
+    update_soa_layout();
+    m_soa.gather();
+
+    if (cluster_pair_list_active()) {
+      update_cluster_pair_list(verlet_criterion);
+      kernel(m_soa, Utils::as_const(m_cluster_pairs));
+    } else {
+      kernel(m_soa);
+    }
+
+    m_soa.scatter_forces();
+  }
+
+  /**
+   * @brief Are exclusions resolved by the neighbor list
+   *        used in @ref non_bonded_soa_loop?
+   */
+  bool soa_loop_resolves_exclusions() const {
+    return cluster_pair_list_active();
+  }
+
+  /** Non-bonded pair loop with potential use of verlet lists,
+   * that runs the kernel in several threads.
+   *
+   * The pair cells are processed by color. Without OpenMP, or
+   * with only one thread, this is the same as @ref non_bonded_loop.
+   *
+   * @param pair_kernel Kernel to apply, it may only modify the
+   *        particles it is called with.
+   * @param verlet_criterion Filter for verlet lists.
+   */
+  template <class PairKernel, class VerletCriterion>
+  void parallel_non_bonded_loop(PairKernel pair_kernel,
+                                const VerletCriterion &verlet_criterion) {
+    parallel_non_bonded_loop(pair_kernel, pair_kernel, verlet_criterion);
+  }
+
+  /** Non-bonded pair loop with separate kernels for the interaction
+   * classes, that runs the kernels in several threads.
+   *
+   * See @ref non_bonded_loop(PairKernel, LongCutoffKernel, const
+   * VerletCriterion &) and @ref parallel_non_bonded_loop(PairKernel,
+   * const VerletCriterion &).
+   */
+  template <class PairKernel, class LongCutoffKernel, class VerletCriterion>
+  void parallel_non_bonded_loop(PairKernel pair_kernel,
+                                LongCutoffKernel long_cutoff_kernel,
+                                const VerletCriterion &verlet_criterion) {
+#ifdef _OPENMP
+    if (omp_get_max_threads() > 1 and not cluster_pair_list_active()) {
+      update_cell_colors();
+
+      if (use_verlet_list) {
+        prepare_verlet_lists();
+        colored_cell_loop(m_pair_colors, [&](std::size_t cell) {
+          verlet_list_cell_loop(cell, pair_kernel, long_cutoff_kernel,
+                                verlet_criterion);
+        });
+        m_rebuild_verlet_list = false;
+      } else {
+        /* No verlet lists, just run the kernel with pairs from the cells. */
+        colored_cell_loop(m_pair_colors, [&](std::size_t cell) {
+          link_cell(resolving_exclusions(pair_kernel), cell, cell + 1);
+        });
+      }
+      return;
+    }
+#endif
+    non_bonded_loop(pair_kernel, long_cutoff_kernel, verlet_criterion);
+  }
+
+  /** Non-bonded pair loop that overlaps a pending ghost update,
+   * see @ref use_ghost_overlap.
+   *
+   * The pairs of the interior cells, whose red neighbors are all
+   * local cells, need no ghosts and are done first. Then @p between
+   * is called, which has to finish the ghost update, and after it
+   * the pairs of the other cells. The kernels are the same as for
+   * @ref non_bonded_loop(PairKernel, LongCutoffKernel, const
+   * VerletCriterion &).
+   *
+   * @param pair_kernel Kernel to apply, has to handle all pairs.
+   * @param long_cutoff_kernel Kernel for the pairs that are beyond
+   *        the cutoff of the short-range interactions of their types.
+   * @param verlet_criterion Filter for verlet lists.
+   * @param between Callable without arguments.
+   * @param parallel Run the kernels in several threads, if
+   *        ESPResSo was built with OpenMP.
+   */
+  template <class PairKernel, class LongCutoffKernel, class VerletCriterion,
+            class Between>
+  void split_non_bonded_loop(PairKernel pair_kernel,
+                             LongCutoffKernel long_cutoff_kernel,
+                             const VerletCriterion &verlet_criterion,
+                             Between between, bool parallel) {
+    if (cluster_pair_list_active()) {
+      between();
+      cluster_pair_loop(pair_kernel, verlet_criterion);
+      return;
+    }
+
+    update_interior_cells();
+    if (use_verlet_list) {
+      prepare_verlet_lists();
+    }
+
+    auto const cell_kernel = [&](std::size_t cell) {
+      if (use_verlet_list) {
+        verlet_list_cell_loop(cell, pair_kernel, long_cutoff_kernel,
+                              verlet_criterion);
+      } else {
+        link_cell(resolving_exclusions(pair_kernel), cell, cell + 1);
+      }
+    };
+    interior_cell_loop(true, cell_kernel, parallel);
+    between();
+    interior_cell_loop(false, cell_kernel, parallel);
+
+    if (use_verlet_list) {
+      m_rebuild_verlet_list = false;
+    }
+  }
+
   /** Non-bonded pair loop with potential use
    * of verlet lists.
    * @param pair_kernel Kernel to apply
@@ -569,11 +1224,35 @@ public:
   template <class PairKernel, class VerletCriterion>
   void non_bonded_loop(PairKernel pair_kernel,
                        const VerletCriterion &verlet_criterion) {
-    if (use_verlet_list) {
-      verlet_list_loop(pair_kernel, verlet_criterion);
+    non_bonded_loop(pair_kernel, pair_kernel, verlet_criterion);
+  }
+
+  /** Non-bonded pair loop with potential use of verlet lists,
+   * and separate kernels for the interaction classes.
+   *
+   * If @ref use_pair_class_lists is set, the pairs that pass
+   * the Verlet criterion only because of the electrostatic,
+   * magnetostatic or collision cutoff are kept in separate
+   * lists, and @p long_cutoff_kernel is called for them
+   * instead of @p pair_kernel. Without the particle-pair
+   * Verlet lists, all pairs are handed to @p pair_kernel.
+   *
+   * @param pair_kernel Kernel to apply, has to handle all pairs.
+   * @param long_cutoff_kernel Kernel for the pairs that are beyond
+   *        the cutoff of the short-range interactions of their types.
+   * @param verlet_criterion Filter for verlet lists.
+   */
+  template <class PairKernel, class LongCutoffKernel, class VerletCriterion>
+  void non_bonded_loop(PairKernel pair_kernel,
+                       LongCutoffKernel long_cutoff_kernel,
+                       const VerletCriterion &verlet_criterion) {
+    if (cluster_pair_list_active()) {
+      cluster_pair_loop(pair_kernel, verlet_criterion);
+    } else if (use_verlet_list) {
+      verlet_list_loop(pair_kernel, long_cutoff_kernel, verlet_criterion);
     } else {
       /* No verlet lists, just run the kernel with pairs from the cells. */
-      link_cell(pair_kernel);
+      link_cell(resolving_exclusions(pair_kernel));
     }
   }
 
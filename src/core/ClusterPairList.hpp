@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_CLUSTER_PAIR_LIST_HPP
+#define ESPRESSO_CLUSTER_PAIR_LIST_HPP
+
+#include "Particle.hpp"
+#include "ParticleSoA.hpp"
+#include "config.hpp"
+
+#ifdef EXCLUSIONS
+#include "exclusions.hpp"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Pair of particle clusters in a @ref ClusterPairList.
+ *
+ * Bit (a * @ref ClusterPairList::cluster_size + b) of the masks refers
+ * to the pair of particle a of cluster i and particle b of cluster j.
+ */
+struct ClusterPair {
+  /** First cluster, always in a local cell */
+  std::uint32_t i;
+  /** Second cluster */
+  std::uint32_t j;
+  /** Particle pairs that are in the list */
+  std::uint16_t pair_mask;
+  /** Subset of the pairs that are not excluded from the
+   *  short-range potentials */
+  std::uint16_t nonbonded_mask;
+};
+
+/**
+ * @brief Neighbor list of pairs of particle clusters.
+ *
+ * The entries of a @ref ParticleSoA, built with the cluster
+ * size of this class, are grouped into clusters of consecutive
+ * entries. Instead of every particle pair, the list stores the
+ * pairs of clusters that have at least one pair within the list
+ * range, together with a bitmask of the particle pairs in range.
+ * Compared to a list of particle pointer pairs this needs much
+ * less memory, and kernels can work on whole cluster tiles.
+ */
+class ClusterPairList {
+public:
+  /** Number of particles per cluster */
+  static constexpr std::size_t cluster_size = 4;
+
+private:
+  static_assert(cluster_size * cluster_size <=
+                    8 * sizeof(ClusterPair::pair_mask),
+                "The masks need one bit per particle pair.");
+
+  std::vector<ClusterPair> m_pairs;
+
+public:
+  std::vector<ClusterPair> const &pairs() const { return m_pairs; }
+
+  /**
+   * @brief Rebuild the list.
+   *
+   * Visits all cluster pairs within the cells and with their
+   * (red) neighbor cells, and keeps the particle pairs for which
+   * the criterion is true.
+   *
+   * @param soa Particle mirror, built with @ref cluster_size.
+   * @param criterion Callable with (Particle const &, Particle const &),
+   *        returning true for pairs that belong into the list.
+   */
+  template <class Criterion>
+  void build(ParticleSoA const &soa, Criterion const &criterion) {
+    m_pairs.clear();
+
+    auto const add_pair = [&](std::size_t i, std::size_t j) {
+      ClusterPair cp{static_cast<std::uint32_t>(i),
+                     static_cast<std::uint32_t>(j), 0u, 0u};
+
+      for (std::size_t a = 0; a < cluster_size; a++) {
+        auto const p1 = soa.particles[i * cluster_size + a];
+        if (not p1)
+          continue;
+
+        /* Pairs within a cluster are only visited once */
+        for (std::size_t b = (i == j) ? a + 1 : 0; b < cluster_size; b++) {
+          auto const p2 = soa.particles[j * cluster_size + b];
+          if (not p2 or not criterion(*p1, *p2))
+            continue;
+
+          auto const bit = 1u << (a * cluster_size + b);
+          cp.pair_mask |= bit;
+#ifdef EXCLUSIONS
+          if (do_nonbonded(*p1, *p2))
+#endif
+            cp.nonbonded_mask |= bit;
+        }
+      }
+
+      if (cp.pair_mask)
+        m_pairs.push_back(cp);
+    };
+
+    for (std::size_t c = 0; c < soa.n_local_cells; c++) {
+      auto const first = soa.cell_begin[c] / cluster_size;
+      auto const last = clusters_end(soa, c);
+
+      for (auto i = first; i < last; i++) {
+        /* Pairs in this cell */
+        for (auto j = i; j < last; j++) {
+          add_pair(i, j);
+        }
+
+        /* Pairs with neighbors */
+        for (auto n = soa.neighbor_begin[c]; n < soa.neighbor_begin[c + 1];
+             n++) {
+          auto const neighbor = soa.neighbors[n];
+          for (auto j = soa.cell_begin[neighbor] / cluster_size;
+               j < clusters_end(soa, neighbor); j++) {
+            add_pair(i, j);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Run a kernel for all particle pairs in the list.
+   *
+   * @param soa Particle mirror the list was built for.
+   * @param kernel Callable with (Particle &, Particle &, bool), the
+   *        last argument tells whether the pair is excluded from the
+   *        short-range potentials.
+   */
+  template <class Kernel>
+  void for_each_pair(ParticleSoA const &soa, Kernel kernel) const {
+    for (auto const &cp : m_pairs) {
+      for (std::size_t a = 0; a < cluster_size; a++) {
+        for (std::size_t b = 0; b < cluster_size; b++) {
+          auto const bit = 1u << (a * cluster_size + b);
+          if (cp.pair_mask & bit) {
+            kernel(*soa.particles[cp.i * cluster_size + a],
+                   *soa.particles[cp.j * cluster_size + b],
+                   not(cp.nonbonded_mask & bit));
+          }
+        }
+      }
+    }
+  }
+
+private:
+  /** One past the last cluster of a cell. */
+  static std::size_t clusters_end(ParticleSoA const &soa, std::size_t cell) {
+    return (soa.cell_end[cell] + cluster_size - 1) / cluster_size;
+  }
+};
+
+#endif
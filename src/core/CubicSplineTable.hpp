@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_CUBIC_SPLINE_TABLE_HPP
+#define CORE_CUBIC_SPLINE_TABLE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/** Cubic spline interpolation of a function on a piecewise uniform grid.
+ *
+ *  The range of the table is split into segments at the given
+ *  breakpoints, so that discontinuities of the function (e.g. the
+ *  cutoffs of individual potentials) are not smoothed over. Every
+ *  segment is sampled uniformly and interpolated by a cubic spline
+ *  whose end conditions are estimated from the samples. The
+ *  polynomial coefficients of all intervals are stored contiguously.
+ *  The segment of an argument is found from a uniform grid over the
+ *  table range, which stores the first segment that overlaps every
+ *  grid cell. Outside of the table range the function evaluates to zero.
+ */
+class CubicSplineTable {
+  struct Segment {
+    double begin;
+    double end;
+    double inv_step;
+    std::size_t offset;
+    std::size_t n_intervals;
+  };
+
+  std::vector<Segment> m_segments;
+  /** Four polynomial coefficients per interval. */
+  std::vector<double> m_coeffs;
+  /** First segment that overlaps each cell of the lookup grid. */
+  std::vector<std::size_t> m_lookup;
+  double m_inv_lookup_step = 0.;
+
+public:
+  CubicSplineTable() = default;
+
+  /** Tabulate a function.
+   *
+   *  @param f            Function to tabulate.
+   *  @param breakpoints  Ascending segment boundaries, the first and
+   *                      last one are the table range.
+   *  @param n_intervals  Total number of intervals, distributed over
+   *                      the segments by their length. Every segment
+   *                      gets at least three.
+   */
+  template <class F>
+  CubicSplineTable(F const &f, std::vector<double> const &breakpoints,
+                   std::size_t n_intervals) {
+    assert(std::is_sorted(breakpoints.begin(), breakpoints.end()));
+    if (breakpoints.size() < 2 or breakpoints.back() <= breakpoints.front())
+      return;
+
+    auto const length = breakpoints.back() - breakpoints.front();
+    for (std::size_t i = 0; i + 1 < breakpoints.size(); i++) {
+      auto const a = breakpoints[i];
+      auto const b = breakpoints[i + 1];
+      if (b <= a)
+        continue;
+      auto const share = std::ceil(n_intervals * (b - a) / length);
+      auto const n = std::max<std::size_t>(3, static_cast<std::size_t>(share));
+      add_segment(f, a, b, n);
+    }
+    init_lookup();
+  }
+
+  bool empty() const { return m_segments.empty(); }
+  /** Start of the table range. */
+  double begin() const { return empty() ? 0. : m_segments.front().begin; }
+  /** End of the table range. */
+  double end() const { return empty() ? 0. : m_segments.back().end; }
+  /** Total number of intervals. */
+  std::size_t n_intervals() const { return m_coeffs.size() / 4; }
+
+  /** Interpolated value at @p x, zero outside of the table range. */
+  double operator()(double x) const {
+    if (x < begin() or x >= end())
+      return 0.;
+    auto const cell = std::min(
+        static_cast<std::size_t>((x - begin()) * m_inv_lookup_step),
+        m_lookup.size() - 1);
+    auto s = m_lookup[cell];
+    while (x >= m_segments[s].end)
+      s++;
+    auto const &seg = m_segments[s];
+    auto const t = (x - seg.begin) * seg.inv_step;
+    auto const i = std::min(static_cast<std::size_t>(t), seg.n_intervals - 1);
+    auto const u = t - static_cast<double>(i);
+    auto const c = m_coeffs.data() + 4 * (seg.offset + i);
+    return c[0] + u * (c[1] + u * (c[2] + u * c[3]));
+  }
+
+  /** Maximal weighted deviation from a function, sampled at the
+   *  quarter points of every interval.
+   *
+   *  @param f       Reference function.
+   *  @param weight  Weight of the deviation at a position.
+   */
+  template <class F, class Weight>
+  double max_error(F const &f, Weight const &weight) const {
+    auto error = 0.;
+    for (auto const &seg : m_segments) {
+      auto const step = 1. / seg.inv_step;
+      for (std::size_t i = 0; i < seg.n_intervals; i++) {
+        for (auto const u : {0.25, 0.5, 0.75}) {
+          auto const x = seg.begin + (static_cast<double>(i) + u) * step;
+          error = std::max(error, std::abs((*this)(x)-f(x)) * weight(x));
+        }
+      }
+    }
+    return error;
+  }
+
+private:
+  /** Build the lookup grid with one cell per interval. The cells are
+   *  assigned to segments from half a cell below their start, so that
+   *  rounding of the cell index never skips the segment of an argument.
+   */
+  void init_lookup() {
+    if (empty())
+      return;
+    auto const n_cells = n_intervals();
+    auto const step = (end() - begin()) / static_cast<double>(n_cells);
+    m_inv_lookup_step = 1. / step;
+    m_lookup.resize(n_cells);
+    std::size_t s = 0;
+    for (std::size_t k = 0; k < n_cells; k++) {
+      auto const x = begin() + (static_cast<double>(k) - 0.5) * step;
+      while (x >= m_segments[s].end)
+        s++;
+      m_lookup[k] = s;
+    }
+  }
+
+  template <class F>
+  void add_segment(F const &f, double a, double b, std::size_t n) {
+    auto const step = (b - a) / static_cast<double>(n);
+
+    /* Samples, the end points are taken just inside the segment,
+     * so that a discontinuity on a breakpoint is not sampled. */
+    std::vector<double> y(n + 1);
+    y[0] = f(std::nextafter(a, b));
+    for (std::size_t k = 1; k < n; k++) {
+      y[k] = f(a + static_cast<double>(k) * step);
+    }
+    y[n] = f(std::nextafter(b, a));
+
+    /* Second derivatives in units of the step. The end values are
+     * one-sided second order estimates, the others follow from the
+     * continuity of the first derivative. */
+    std::vector<double> m(n + 1);
+    m[0] = 2. * y[0] - 5. * y[1] + 4. * y[2] - y[3];
+    m[n] = 2. * y[n] - 5. * y[n - 1] + 4. * y[n - 2] - y[n - 3];
+
+    /* Tridiagonal system (1, 4, 1) for m[1] ... m[n - 1] */
+    std::vector<double> c(n), d(n);
+    for (std::size_t k = 1; k < n; k++) {
+      auto rhs = 6. * (y[k + 1] - 2. * y[k] + y[k - 1]);
+      if (k == 1)
+        rhs -= m[0];
+      if (k == n - 1)
+        rhs -= m[n];
+      auto const pivot = (k == 1) ? 4. : 4. - c[k - 1];
+      c[k] = 1. / pivot;
+      d[k] = (k == 1) ? rhs / pivot : (rhs - d[k - 1]) / pivot;
+    }
+    for (std::size_t k = n - 1; k >= 1; k--) {
+      m[k] = d[k] - ((k == n - 1) ? 0. : c[k] * m[k + 1]);
+    }
+
+    auto const offset = n_intervals();
+    for (std::size_t k = 0; k < n; k++) {
+      m_coeffs.push_back(y[k]);
+      m_coeffs.push_back(y[k + 1] - y[k] - (2. * m[k] + m[k + 1]) / 6.);
+      m_coeffs.push_back(0.5 * m[k]);
+      m_coeffs.push_back((m[k + 1] - m[k]) / 6.);
+    }
+    m_segments.push_back({a, b, 1. / step, offset, n});
+  }
+};
+
+#endif
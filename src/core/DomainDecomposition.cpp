@@ -26,6 +26,7 @@
 
 #include <utils/Vector.hpp>
 #include <utils/index.hpp>
+#include <utils/morton.hpp>
 #include <utils/mpi/cart_comm.hpp>
 #include <utils/mpi/sendrecv.hpp>
 
@@ -37,9 +38,11 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 /** Returns pointer to the cell which corresponds to the position if the
  *  position is in the nodes spatial domain otherwise a nullptr pointer.
@@ -48,8 +51,22 @@ Cell *DomainDecomposition::position_to_cell(const Utils::Vector3d &pos) {
   Utils::Vector3i cpos;
 
   for (int i = 0; i < 3; i++) {
-    cpos[i] = static_cast<int>(std::floor(pos[i] * inv_cell_size[i])) + 1 -
-              cell_offset[i];
+    if (m_regular) {
+      cpos[i] = static_cast<int>(std::floor(pos[i] * inv_cell_size[i])) + 1 -
+                cell_offset[i];
+    } else if (pos[i] < m_local_box.my_left()[i]) {
+      cpos[i] = 0;
+    } else if (pos[i] >= m_local_box.my_right()[i]) {
+      cpos[i] = cell_grid[i] + 1;
+    } else {
+      /* The local boxes of neighboring nodes share their boundaries
+         exactly, so ownership is decided by the comparisons above. */
+      cpos[i] = std::min(
+          static_cast<int>(std::floor((pos[i] - m_local_box.my_left()[i]) *
+                                      inv_cell_size[i])) +
+              1,
+          cell_grid[i]);
+    }
 
     /* particles outside our box. Still take them if
        nonperiodic boundary. We also accept the particle if we are at
@@ -233,6 +250,59 @@ void DomainDecomposition::resort(bool global,
       diff.emplace_back(ModifiedList{sort_cell->particles()});
     }
   }
+
+  if (m_morton_order) {
+    sort_particles_in_cells(diff);
+  }
+}
+
+Utils::Vector3i
+DomainDecomposition::cell_grid_position(Cell const *cell) const {
+  auto const index = static_cast<int>(std::distance(cells.data(), cell));
+  return {index % ghost_cell_grid[0],
+          (index / ghost_cell_grid[0]) % ghost_cell_grid[1],
+          index / (ghost_cell_grid[0] * ghost_cell_grid[1])};
+}
+
+void DomainDecomposition::sort_particles_in_cells(
+    std::vector<ParticleChange> &diff) {
+  /* Number of bins per direction within a cell */
+  auto const n_bins = 1u << 10;
+
+  std::vector<std::pair<uint64_t, std::size_t>> keys;
+  std::vector<Particle> sorted;
+
+  for (auto &c : local_cells()) {
+    auto &particles = c->particles();
+    if (particles.size() < 2)
+      continue;
+
+    keys.clear();
+    for (std::size_t i = 0; i < particles.size(); i++) {
+      auto const &pos = particles.begin()[i].r.p;
+      Utils::Vector<unsigned, 3> bin;
+      for (int d = 0; d < 3; d++) {
+        auto const x = (pos[d] - m_local_box.my_left()[d]) * inv_cell_size[d];
+        bin[d] = std::min(n_bins - 1, static_cast<unsigned>(
+                                          n_bins * (x - std::floor(x))));
+      }
+      keys.emplace_back(Utils::morton_index(bin), i);
+    }
+
+    if (std::is_sorted(keys.begin(), keys.end()))
+      continue;
+
+    std::sort(keys.begin(), keys.end());
+
+    sorted.clear();
+    sorted.reserve(particles.size());
+    for (auto const &key : keys) {
+      sorted.emplace_back(std::move(particles.begin()[key.second]));
+    }
+    std::move(sorted.begin(), sorted.end(), particles.begin());
+
+    diff.emplace_back(ModifiedList{particles});
+  }
 }
 
 void DomainDecomposition::mark_cells() {
@@ -247,9 +317,28 @@ void DomainDecomposition::mark_cells() {
         if ((m > 0 && m < ghost_cell_grid[0] - 1 && n > 0 &&
              n < ghost_cell_grid[1] - 1 && o > 0 && o < ghost_cell_grid[2] - 1))
           m_local_cells.push_back(&cells.at(cnt_c++));
-        else
+        /* The lower ghost layer is not used by the eighth-shell method */
+        else if (not(m_eighth_shell and (m == 0 or n == 0 or o == 0)))
           m_ghost_cells.push_back(&cells.at(cnt_c++));
+        else
+          cnt_c++;
       }
+
+  if (m_morton_order) {
+    auto const key = [this](Cell const *cell) {
+      auto const pos = cell_grid_position(cell);
+      return Utils::morton_index(static_cast<unsigned>(pos[0]),
+                                 static_cast<unsigned>(pos[1]),
+                                 static_cast<unsigned>(pos[2]));
+    };
+    std::sort(m_local_cells.begin(), m_local_cells.end(),
+              [&key](Cell const *a, Cell const *b) { return key(a) < key(b); });
+  }
+
+  m_pair_cells = m_local_cells;
+  std::copy_if(m_ghost_cells.begin(), m_ghost_cells.end(),
+               std::back_inserter(m_pair_cells),
+               [](Cell *cell) { return not cell->neighbors().red().empty(); });
 }
 void DomainDecomposition::fill_comm_cell_lists(ParticleList **part_lists,
                                                const Utils::Vector3i &lc,
@@ -271,6 +360,19 @@ Utils::Vector3d DomainDecomposition::max_cutoff() const {
 }
 
 Utils::Vector3d DomainDecomposition::max_range() const { return cell_size; }
+bool DomainDecomposition::local_box_is_regular() const {
+  auto const cart_info = Utils::Mpi::cart_get<3>(m_comm);
+
+  for (int i = 0; i < 3; i++) {
+    /* Same arithmetic as in regular_decomposition() */
+    auto const local_length = m_box.length()[i] / cart_info.dims[i];
+    if (m_local_box.length()[i] != local_length or
+        m_local_box.my_left()[i] != cart_info.coords[i] * local_length)
+      return false;
+  }
+  return true;
+}
+
 int DomainDecomposition::calc_processor_min_num_cells() const {
   /* the minimal number of cells can be lower if there are at least two nodes
      serving a direction,
@@ -305,6 +407,32 @@ void DomainDecomposition::create_cell_grid(double range) {
     cell_grid[2] = cells_per_dir;
 
     n_local_cells = cell_grid[0] * cell_grid[1] * cell_grid[2];
+  } else if (not m_regular) {
+    /* The number of cells in a direction may only depend on the
+       length of the local box in that direction, so that neighboring
+       nodes agree on the cells of their common faces. */
+    auto const max_cells_per_dir = static_cast<int>(std::floor(
+        std::cbrt(static_cast<double>(DomainDecomposition::max_num_cells)) +
+        1e-6));
+    for (int i = 0; i < 3; i++) {
+      cell_grid[i] = std::min(
+          static_cast<int>(std::floor(m_local_box.length()[i] / range)),
+          max_cells_per_dir);
+      if (cell_grid[i] < 1) {
+        runtimeErrorMsg() << "interaction range " << range << " in direction "
+                          << i << " is larger than the local box size "
+                          << m_local_box.length()[i];
+        cell_grid[i] = 1;
+      }
+    }
+    n_local_cells = cell_grid[0] * cell_grid[1] * cell_grid[2];
+
+    if (n_local_cells < min_num_cells) {
+      runtimeErrorMsg()
+          << "number of cells " << n_local_cells << " is smaller than minimum "
+          << min_num_cells
+          << " (interaction range too large or min_num_cells too large)";
+    }
   } else {
     /* Calculate initial cell grid */
     double volume = m_local_box.length()[0];
@@ -418,6 +546,66 @@ void DomainDecomposition::init_cell_interactions() {
       }
 }
 
+void DomainDecomposition::init_eighth_shell_interactions() {
+  auto const is_local = [this](Utils::Vector3i const &pos) {
+    for (int i = 0; i < 3; i++) {
+      if (pos[i] < 1 or pos[i] > cell_grid[i])
+        return false;
+    }
+    return true;
+  };
+  /* Corner of the 2x2x2 block with the bits of e set */
+  auto const corner = [](unsigned e) {
+    return Utils::Vector3i{static_cast<int>(e & 1u),
+                           static_cast<int>((e >> 1u) & 1u),
+                           static_cast<int>((e >> 2u) & 1u)};
+  };
+
+  /* loop the local cells and the upper ghost layer */
+  for (int o = 1; o < cell_grid[2] + 2; o++)
+    for (int n = 1; n < cell_grid[1] + 2; n++)
+      for (int m = 1; m < cell_grid[0] + 2; m++) {
+        Utils::Vector3i const pos{m, n, o};
+        auto const ind1 = get_linear_index(pos, ghost_cell_grid);
+
+        /* The pairs of the block with the local lower corner pos - e1
+         * between its corners e1 and e2. Every pair of neighboring cells
+         * is in exactly one such block with disjoint corners, and it is
+         * assigned to the corner with the lower number. */
+        std::vector<Cell *> red_neighbors;
+        for (unsigned e1 = 0; e1 < 8; e1++) {
+          auto const block = pos - corner(e1);
+          if (not is_local(block))
+            continue;
+          for (unsigned e2 = e1 + 1; e2 < 8; e2++) {
+            if ((e1 & e2) == 0) {
+              auto const ind2 =
+                  get_linear_index(block + corner(e2), ghost_cell_grid);
+              red_neighbors.push_back(&cells.at(ind2));
+            }
+          }
+        }
+
+        /* All other neighbors of local cells are black, as
+         * with the full shell this includes the cell itself */
+        std::vector<Cell *> black_neighbors;
+        if (is_local(pos)) {
+          for (int p = o - 1; p <= o + 1; p++)
+            for (int q = n - 1; q <= n + 1; q++)
+              for (int r = m - 1; r <= m + 1; r++) {
+                auto const neighbor =
+                    &cells.at(get_linear_index(r, q, p, ghost_cell_grid));
+                if (std::find(red_neighbors.begin(), red_neighbors.end(),
+                              neighbor) == red_neighbors.end())
+                  black_neighbors.push_back(neighbor);
+              }
+        }
+
+        cells.at(ind1).m_neighbors =
+            Neighbors<Cell *>(red_neighbors, black_neighbors);
+      }
+}
+
 namespace {
 /** Revert the order of a communicator: After calling this the
  *  communicator is working in reverted order with exchanged
@@ -474,10 +662,13 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
   auto const comm_info = Utils::Mpi::cart_get<3>(m_comm);
   auto const node_neighbors = Utils::Mpi::cart_neighbors<3>(m_comm);
 
+  /* The eighth-shell method only imports from the upper neighbors */
+  int const n_sides = m_eighth_shell ? 1 : 2;
+
   /* calculate number of communications */
   size_t num = 0;
   for (dir = 0; dir < 3; dir++) {
-    for (lr = 0; lr < 2; lr++) {
+    for (lr = 0; lr < n_sides; lr++) {
       /* No communication for border of non periodic direction */
       if (comm_info.dims[dir] == 1)
         num++;
@@ -491,21 +682,18 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
 
   /* number of cells to communicate in a direction */
   n_comm_cells[0] = cell_grid[1] * cell_grid[2];
-  n_comm_cells[1] = cell_grid[2] * ghost_cell_grid[0];
-  n_comm_cells[2] = ghost_cell_grid[0] * ghost_cell_grid[1];
+  n_comm_cells[1] = cell_grid[2] * (cell_grid[0] + n_sides);
+  n_comm_cells[2] = (cell_grid[0] + n_sides) * (cell_grid[1] + n_sides);
 
   cnt = 0;
   /* direction loop: x, y, z */
   for (dir = 0; dir < 3; dir++) {
-    lc[(dir + 1) % 3] = 1 - done[(dir + 1) % 3];
-    lc[(dir + 2) % 3] = 1 - done[(dir + 2) % 3];
+    lc[(dir + 1) % 3] = 1 - (n_sides - 1) * done[(dir + 1) % 3];
+    lc[(dir + 2) % 3] = 1 - (n_sides - 1) * done[(dir + 2) % 3];
     hc[(dir + 1) % 3] = cell_grid[(dir + 1) % 3] + done[(dir + 1) % 3];
     hc[(dir + 2) % 3] = cell_grid[(dir + 2) % 3] + done[(dir + 2) % 3];
-    /* lr loop: left right */
-    /* here we could in principle build in a one sided ghost
-       communication, simply by taking the lr loop only over one
-       value */
-    for (lr = 0; lr < 2; lr++) {
+    /* lr loop: left right, one sided for the eighth-shell method */
+    for (lr = 0; lr < n_sides; lr++) {
       if (comm_info.dims[dir] == 1) {
         /* just copy cells on a single node */
         ghost_comm.communications[cnt].type = GHOST_LOCL;
@@ -573,13 +761,26 @@ GhostCommunicator DomainDecomposition::prepare_comm() {
 DomainDecomposition::DomainDecomposition(boost::mpi::communicator comm,
                                          double range,
                                          const BoxGeometry &box_geo,
-                                         const LocalBox<double> &local_geo)
-    : m_comm(std::move(comm)), m_box(box_geo), m_local_box(local_geo) {
+                                         const LocalBox<double> &local_geo,
+                                         bool morton_order,
+                                         bool neighbor_collectives,
+                                         bool shared_memory,
+                                         bool eighth_shell)
+    : m_comm(std::move(comm)), m_box(box_geo), m_local_box(local_geo),
+      m_morton_order(morton_order),
+      m_neighbor_collectives(neighbor_collectives),
+      m_shared_memory(shared_memory), m_eighth_shell(eighth_shell) {
+  m_regular = boost::mpi::all_reduce(m_comm, local_box_is_regular(),
+                                     std::logical_and<bool>());
+
   /* set up new domain decomposition cell structure */
   create_cell_grid(range);
 
   /* setup cell neighbors */
-  init_cell_interactions();
+  if (m_eighth_shell)
+    init_eighth_shell_interactions();
+  else
+    init_cell_interactions();
 
   /* mark local and ghost cells */
   mark_cells();
@@ -591,6 +792,28 @@ DomainDecomposition::DomainDecomposition(boost::mpi::communicator comm,
   /* collect forces has to be done in reverted order! */
   revert_comm_order(m_collect_ghost_force_comm);
 
-  assign_prefetches(m_exchange_ghosts_comm);
-  assign_prefetches(m_collect_ghost_force_comm);
+  /* With one side per direction the rounds of two communications
+   * do not line up with the directions, and a prefetch could pack
+   * ghosts before they are received. */
+  if (not m_eighth_shell) {
+    assign_prefetches(m_exchange_ghosts_comm);
+    assign_prefetches(m_collect_ghost_force_comm);
+  }
+
+  if (m_neighbor_collectives) {
+    /* The communications of one direction are independent of each
+     * other, so every direction is one stage. */
+    auto const comm_info = Utils::Mpi::cart_get<3>(m_comm);
+    std::vector<std::size_t> stage_sizes;
+    auto const n_sides = m_eighth_shell ? 1u : 2u;
+    for (int dir = 0; dir < 3; dir++) {
+      stage_sizes.push_back(((comm_info.dims[dir] == 1) ? 1u : 2u) * n_sides);
+    }
+    make_neighbor_stages(m_exchange_ghosts_comm, stage_sizes);
+    boost::reverse(stage_sizes);
+    make_neighbor_stages(m_collect_ghost_force_comm, stage_sizes);
+  } else if (m_shared_memory) {
+    make_shared_memory(m_exchange_ghosts_comm);
+    make_shared_memory(m_collect_ghost_force_comm);
+  }
 }
@@ -64,6 +64,12 @@
  * communication! For single sided ghost communication one would need
  * some ghost-ghost cell interaction as well, which we do not need!
  *
+ * Unless the eighth-shell method is used: then the ghost layer is only
+ * imported from the upper neighbors, and every pair of neighboring cells
+ * is handled by the node that owns the cell with the lowest grid position
+ * in every direction of the 2x2x2 block containing both. This needs
+ * pairs between ghost cells, which are provided by @ref pair_cells.
+ *
  */
 struct DomainDecomposition : public ParticleDecomposition {
   /** Grind dimensions per node. */
@@ -85,13 +91,31 @@ private:
   std::vector<Cell> cells;
   std::vector<Cell *> m_local_cells;
   std::vector<Cell *> m_ghost_cells;
+  /** Local cells, followed by the ghost cells with pairs to compute */
+  std::vector<Cell *> m_pair_cells;
   GhostCommunicator m_exchange_ghosts_comm;
   GhostCommunicator m_collect_ghost_force_comm;
+  /** Traverse the cells and store the particles in Morton order */
+  bool m_morton_order;
+  /** Exchange the ghosts by neighborhood collectives */
+  bool m_neighbor_collectives;
+  /** Exchange the ghosts with nodes on the same host by shared memory */
+  bool m_shared_memory;
+  /** Import the ghosts only from the upper neighbors */
+  bool m_eighth_shell;
+  /** Are all local boxes of equal size? Otherwise the cell grid can
+   *  differ between nodes and positions are assigned to cells
+   *  relative to the local box.
+   */
+  bool m_regular;
 
 public:
   DomainDecomposition(boost::mpi::communicator comm, double range,
                       const BoxGeometry &box_geo,
-                      const LocalBox<double> &local_geo);
+                      const LocalBox<double> &local_geo,
+                      bool morton_order = false,
+                      bool neighbor_collectives = false,
+                      bool shared_memory = false, bool eighth_shell = false);
 
   GhostCommunicator const &exchange_ghosts_comm() const override {
     return m_exchange_ghosts_comm;
@@ -106,6 +130,9 @@ public:
   Utils::Span<Cell *> ghost_cells() override {
     return Utils::make_span(m_ghost_cells);
   }
+  Utils::Span<Cell *> pair_cells() override {
+    return Utils::make_span(m_pair_cells);
+  }
 
   Cell *particle_to_cell(Particle const &p) override {
     return position_to_cell(p.r.p);
@@ -119,7 +146,26 @@ public:
     return {};
   }
 
+  /** Are the cells and particles in Morton order? */
+  bool morton_order() const { return m_morton_order; }
+  /** Are the ghosts exchanged by neighborhood collectives? */
+  bool neighbor_collectives() const { return m_neighbor_collectives; }
+  /** Are the ghosts exchanged by shared memory on the same host? */
+  bool shared_memory() const { return m_shared_memory; }
+  /** Is the eighth-shell method used? */
+  bool eighth_shell() const { return m_eighth_shell; }
+
 private:
+  /** Grid position of a cell, including the ghost layer. */
+  Utils::Vector3i cell_grid_position(Cell const *cell) const;
+
+  /** Sort the particles within each local cell in Morton order
+   *  of their position in the cell.
+   *
+   *  @param[out] diff Cells that have been touched.
+   */
+  void sort_particles_in_cells(std::vector<ParticleChange> &diff);
+
   /** Fill local_cells list and ghost_cells list for use with domain
    *  decomposition.
    */
@@ -140,6 +186,9 @@ private:
 
   int calc_processor_min_num_cells() const;
 
+  /** Is the local box the one of the regular decomposition? */
+  bool local_box_is_regular() const;
+
   Cell *position_to_cell(const Utils::Vector3d &pos);
 
   /**
@@ -205,6 +254,11 @@ private:
    */
   void init_cell_interactions();
 
+  /** Init the cell interactions of the eighth-shell method, for the
+   *  local cells and the upper ghost layer.
+   */
+  void init_eighth_shell_interactions();
+
   /** Create communicators for cell structure domain decomposition. (see \ref
    *  GhostCommunicator)
    */
@@ -68,6 +68,11 @@ struct ParticleParametersSwimming {
  *  for all ghosts. Ghosts are particles which are
  *  needed in the interaction calculation, but are just copies of
  *  particles stored on different nodes.
+ *
+ *  Only the properties that are needed in every force calculation or
+ *  integration step are kept here, so that they share a cache line
+ *  at the start of the particle. The rarely used ones are in
+ *  @ref ParticleColdProperties.
  */
 struct ParticleProperties {
   /** unique identifier for the particle. */
@@ -77,20 +82,6 @@ struct ParticleProperties {
   /** particle type, used for non-bonded interactions. */
   int type = 0;
 
-  /** particle mass */
-#ifdef MASS
-  double mass = 1.0;
-#else
-  constexpr static double mass{1.0};
-#endif /* MASS */
-
-  /** rotational inertia */
-#ifdef ROTATIONAL_INERTIA
-  Utils::Vector3d rinertia = {1., 1., 1.};
-#else
-  static constexpr Utils::Vector3d rinertia = {1., 1., 1.};
-#endif
-
   /** bitfield for the particle axes of rotation */
 #ifdef ROTATION
   uint8_t rotation = ROTATION_FIXED;
@@ -98,23 +89,6 @@ struct ParticleProperties {
   static constexpr uint8_t rotation = ROTATION_FIXED;
 #endif
 
-  /** charge. */
-#ifdef ELECTROSTATICS
-  double q = 0.0;
-#else
-  constexpr static double q{0.0};
-#endif
-
-#ifdef LB_ELECTROHYDRODYNAMICS
-  /** electrophoretic mobility times E-field: mu_0 * E */
-  Utils::Vector3d mu_E = {0., 0., 0.};
-#endif
-
-#ifdef DIPOLES
-  /** dipole moment (absolute value) */
-  double dipm = 0.;
-#endif
-
 #ifdef VIRTUAL_SITES
   /** is particle virtual */
   bool is_virtual = false;
@@ -140,12 +114,97 @@ struct ParticleProperties {
       ar &rel_orientation;
       ar &quat;
     }
-  } vs_relative;
+  };
 #endif
 #else  /* VIRTUAL_SITES */
   static constexpr bool is_virtual = false;
 #endif /* VIRTUAL_SITES */
 
+#ifdef EXTERNAL_FORCES
+  /** flag whether to fix a particle in space.
+      Values:
+      <ul> <li> 0 no external influence
+           <li> 1 apply external force \ref ParticleColdProperties::ext_force
+           <li> 2,3,4 fix particle coordinate 0,1,2
+           <li> 5 apply external torque \ref ParticleColdProperties::ext_torque
+      </ul>
+  */
+  uint8_t ext_flag = 0;
+#else
+  static constexpr const uint8_t ext_flag =
+      0; // no external forces and fixed coordinates
+#endif
+
+  /** particle mass */
+#ifdef MASS
+  double mass = 1.0;
+#else
+  constexpr static double mass{1.0};
+#endif /* MASS */
+
+  /** charge. */
+#ifdef ELECTROSTATICS
+  double q = 0.0;
+#else
+  constexpr static double q{0.0};
+#endif
+
+#ifdef DIPOLES
+  /** dipole moment (absolute value) */
+  double dipm = 0.;
+#endif
+
+  /** rotational inertia */
+#ifdef ROTATIONAL_INERTIA
+  Utils::Vector3d rinertia = {1., 1., 1.};
+#else
+  static constexpr Utils::Vector3d rinertia = {1., 1., 1.};
+#endif
+
+  template <class Archive> void serialize(Archive &ar, long int /* version */) {
+    ar &identity;
+    ar &mol_id;
+    ar &type;
+#ifdef ROTATION
+    ar &rotation;
+#endif
+#ifdef VIRTUAL_SITES
+    ar &is_virtual;
+#endif
+#ifdef EXTERNAL_FORCES
+    ar &ext_flag;
+#endif
+#ifdef MASS
+    ar &mass;
+#endif /* MASS */
+#ifdef ELECTROSTATICS
+    ar &q;
+#endif
+#ifdef DIPOLES
+    ar &dipm;
+#endif
+#ifdef ROTATIONAL_INERTIA
+    ar &rinertia;
+#endif
+  }
+};
+
+/** Properties of a particle which are only needed by some
+ *  algorithms. They are stored behind the data that is accessed
+ *  in every force calculation and integration step, and are sent
+ *  to the ghosts together with the @ref ParticleProperties.
+ */
+struct ParticleColdProperties {
+#ifdef LB_ELECTROHYDRODYNAMICS
+  /** electrophoretic mobility times E-field: mu_0 * E */
+  Utils::Vector3d mu_E = {0., 0., 0.};
+#endif
+
+#ifdef VIRTUAL_SITES_RELATIVE
+  /** Placement of a virtual site relative to its reference particle. */
+  ParticleProperties::VirtualSitesRelativeParameters vs_relative;
+#endif
+
 #ifdef THERMOSTAT_PER_PARTICLE
 #ifndef PARTICLE_ANISOTROPY
   double gamma = -1.;
@@ -163,15 +222,6 @@ struct ParticleProperties {
 #endif // THERMOSTAT_PER_PARTICLE
 
 #ifdef EXTERNAL_FORCES
-  /** flag whether to fix a particle in space.
-      Values:
-      <ul> <li> 0 no external influence
-           <li> 1 apply external force \ref ParticleProperties::ext_force
-           <li> 2,3,4 fix particle coordinate 0,1,2
-           <li> 5 apply external torque \ref ParticleProperties::ext_torque
-      </ul>
-  */
-  uint8_t ext_flag = 0;
   /** External force, apply if \ref ParticleProperties::ext_flag == 1. */
   Utils::Vector3d ext_force = {0, 0, 0};
 
@@ -179,9 +229,6 @@ struct ParticleProperties {
   /** External torque, apply if \ref ParticleProperties::ext_flag == 16. */
   Utils::Vector3d ext_torque = {0, 0, 0};
 #endif
-#else
-  static constexpr const uint8_t ext_flag =
-      0; // no external forces and fixed coordinates
 #endif
 
 #ifdef ENGINE
@@ -189,36 +236,12 @@ struct ParticleProperties {
 #endif
 
   template <class Archive> void serialize(Archive &ar, long int /* version */) {
-    ar &identity;
-    ar &mol_id;
-    ar &type;
-#ifdef MASS
-    ar &mass;
-#endif /* MASS */
-#ifdef ROTATIONAL_INERTIA
-    ar &rinertia;
-#endif
-#ifdef ROTATION
-    ar &rotation;
-#endif
-#ifdef ELECTROSTATICS
-    ar &q;
-#endif
-
 #ifdef LB_ELECTROHYDRODYNAMICS
     ar &mu_E;
 #endif
-#ifdef DIPOLES
-    ar &dipm;
-#endif
-
-#ifdef VIRTUAL_SITES
-    ar &is_virtual;
 #ifdef VIRTUAL_SITES_RELATIVE
     ar &vs_relative;
 #endif
-#endif /* VIRTUAL_SITES */
-
 #ifdef THERMOSTAT_PER_PARTICLE
     ar &gamma;
 #ifdef ROTATION
@@ -226,13 +249,11 @@ struct ParticleProperties {
 #endif
 #endif // THERMOSTAT_PER_PARTICLE
 #ifdef EXTERNAL_FORCES
-    ar &ext_flag;
     ar &ext_force;
 #ifdef ROTATION
     ar &ext_torque;
 #endif
 #endif
-
 #ifdef ENGINE
     ar &swim;
 #endif
@@ -371,11 +392,11 @@ struct Particle { // NOLINT(bugprone-exception-escape)
 #ifdef DIPOLES
   Utils::Vector3d calc_dip() const { return r.calc_director() * p.dipm; }
 #endif
-  ///
-  ParticleMomentum m;
   ///
   ParticleForce f;
   ///
+  ParticleMomentum m;
+  ///
   ParticleLocal l;
 
 private:
@@ -411,6 +432,9 @@ public:
 #endif
   }
 
+  /** Rarely used properties, behind all of the frequently used data. */
+  ParticleColdProperties c;
+
 private:
   friend boost::serialization::access;
   template <class Archive> void serialize(Archive &ar, long int /* version */) {
@@ -419,6 +443,7 @@ private:
     ar &m;
     ar &f;
     ar &l;
+    ar &c;
     ar &bl;
 #ifdef EXCLUSIONS
     ar &el;
@@ -104,6 +104,19 @@ public:
    */
   virtual Utils::Span<Cell *> ghost_cells() = 0;
 
+  /**
+   * @brief Get pointer to the cells whose pairs are computed.
+   *
+   * The pairs of a cell are those with the particles of its red
+   * neighbors, and for the local cells also those within the cell.
+   * The local cells come first, in the order of @ref local_cells,
+   * followed by ghost cells, if the decomposition needs pairs
+   * between ghosts.
+   *
+   * @return List of pair cells.
+   */
+  virtual Utils::Span<Cell *> pair_cells() = 0;
+
   /**
    * @brief Determine which cell a particle id belongs to.
    *
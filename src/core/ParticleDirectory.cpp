@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ParticleDirectory.hpp"
+
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/collectives/all_to_all.hpp>
+#include <boost/mpi/operations.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstddef>
+#include <utility>
+
+void ParticleDirectory::update(boost::mpi::communicator const &comm,
+                               std::vector<int> const &local_ids) {
+  auto const n_ranks = comm.size();
+  std::unordered_set<int> current(local_ids.begin(), local_ids.end());
+
+  /* Departures are reported with owner -1, arrivals with this rank. */
+  std::vector<std::vector<std::pair<int, int>>> changes(n_ranks);
+  for (auto const id : m_local_ids) {
+    if (not current.count(id))
+      changes[home(id, n_ranks)].emplace_back(id, -1);
+  }
+  for (auto const id : current) {
+    if (not m_local_ids.count(id))
+      changes[home(id, n_ranks)].emplace_back(id, comm.rank());
+  }
+  m_local_ids = std::move(current);
+
+  std::vector<std::vector<std::pair<int, int>>> received;
+  boost::mpi::all_to_all(comm, changes, received);
+
+  /* A particle can leave one rank and arrive on another one in the
+   * same update, so the departures have to be applied first, and only
+   * if they are from the rank that is currently recorded. */
+  for (int source = 0; source < n_ranks; source++) {
+    for (auto const &change : received[source]) {
+      if (change.second >= 0)
+        continue;
+      auto const it = m_owners.find(change.first);
+      if (it != m_owners.end() and it->second == source)
+        m_owners.erase(it);
+    }
+  }
+  for (auto const &per_rank : received) {
+    for (auto const &change : per_rank) {
+      if (change.second >= 0)
+        m_owners[change.first] = change.second;
+    }
+  }
+}
+
+void ParticleDirectory::add(boost::mpi::communicator const &comm, int id,
+                            bool is_local) {
+  auto const owner = boost::mpi::all_reduce(
+      comm, is_local ? comm.rank() : -1, boost::mpi::maximum<int>());
+
+  if (owner == comm.rank())
+    m_local_ids.insert(id);
+  if (owner >= 0 and home(id, comm.size()) == comm.rank())
+    m_owners[id] = owner;
+}
+
+std::vector<int>
+ParticleDirectory::owners(boost::mpi::communicator const &comm,
+                          std::vector<int> const &ids) const {
+  auto const n_ranks = comm.size();
+
+  std::vector<std::vector<int>> queries(n_ranks);
+  for (auto const id : ids) {
+    queries[home(id, n_ranks)].push_back(id);
+  }
+
+  std::vector<std::vector<int>> received;
+  boost::mpi::all_to_all(comm, queries, received);
+
+  for (auto &per_rank : received) {
+    for (auto &id : per_rank) {
+      id = owner(id);
+    }
+  }
+
+  std::vector<std::vector<int>> answers;
+  boost::mpi::all_to_all(comm, received, answers);
+
+  /* The answers of every home rank are in the order of the queries */
+  std::vector<std::size_t> next(n_ranks, 0);
+  std::vector<int> result(ids.size());
+  for (std::size_t i = 0; i < ids.size(); i++) {
+    auto const h = home(ids[i], n_ranks);
+    result[i] = answers[h][next[h]++];
+  }
+
+  return result;
+}
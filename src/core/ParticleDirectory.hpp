@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_PARTICLE_DIRECTORY_HPP
+#define ESPRESSO_PARTICLE_DIRECTORY_HPP
+
+#include <boost/mpi/communicator.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/** @brief Distributed directory of the ranks that own the particles.
+ *
+ *  The particle ids are distributed over the ranks by their value,
+ *  and every rank stores the owners of the ids it is the home rank
+ *  of. On an update, every rank only reports the particles it gained
+ *  or lost since the previous update to their home ranks, so the work
+ *  and the communication scale with the number of particles that
+ *  migrated. The owner of a particle can then be looked up on its
+ *  home rank alone.
+ */
+class ParticleDirectory {
+  /** Owners of the ids that have this rank as their home rank. */
+  std::unordered_map<int, int> m_owners;
+  /** Ids of the local particles at the last update. */
+  std::unordered_set<int> m_local_ids;
+
+public:
+  /** The rank that stores the owner of a particle. */
+  static int home(int id, int n_ranks) { return id % n_ranks; }
+
+  /** @brief Report the changes of the local particles.
+   *
+   *  Has to be called on all ranks.
+   *
+   *  @param comm Communicator of the ranks.
+   *  @param local_ids Ids of the particles that are now on this rank.
+   */
+  void update(boost::mpi::communicator const &comm,
+              std::vector<int> const &local_ids);
+
+  /** @brief Register a particle that was created on one of the ranks.
+   *
+   *  Has to be called on all ranks.
+   *
+   *  @param comm Communicator of the ranks.
+   *  @param id Id of the particle.
+   *  @param is_local Whether the particle was created on this rank.
+   */
+  void add(boost::mpi::communicator const &comm, int id, bool is_local);
+
+  /** Forget a particle that was deleted, on this rank only. */
+  void remove(int id) {
+    m_owners.erase(id);
+    m_local_ids.erase(id);
+  }
+
+  /** @brief Owner of a particle that has this rank as its home rank.
+   *
+   *  @return The rank of the particle, or -1 if it does not exist.
+   */
+  int owner(int id) const {
+    auto const it = m_owners.find(id);
+    return (it == m_owners.end()) ? -1 : it->second;
+  }
+
+  /** @brief Look up the owners of several particles.
+   *
+   *  Has to be called on all ranks, the queries of all ranks are
+   *  answered by their home ranks.
+   *
+   *  @param comm Communicator of the ranks.
+   *  @param ids Ids to look up on this rank.
+   *  @return The owners of @p ids, -1 for ids that do not exist.
+   */
+  std::vector<int> owners(boost::mpi::communicator const &comm,
+                          std::vector<int> const &ids) const;
+
+  /** Forget all particles, on this rank only. */
+  void clear() {
+    m_owners.clear();
+    m_local_ids.clear();
+  }
+};
+
+#endif
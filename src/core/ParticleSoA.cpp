@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ParticleSoA.hpp"
+
+#include "config.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/morton.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+/**
+ * @brief Order particles such that consecutive particles are close.
+ *
+ * The bounding box of the particles is divided into 4x4x4 bins,
+ * which are traversed in Z-order.
+ */
+void spatial_sort(std::vector<Particle *>::iterator first,
+                  std::vector<Particle *>::iterator last) {
+  if (std::distance(first, last) < 2)
+    return;
+
+  Utils::Vector3d lo = (*first)->r.p;
+  Utils::Vector3d hi = lo;
+  std::for_each(first, last, [&](Particle const *p) {
+    for (int d = 0; d < 3; d++) {
+      lo[d] = std::min(lo[d], p->r.p[d]);
+      hi[d] = std::max(hi[d], p->r.p[d]);
+    }
+  });
+
+  auto key = [&](Particle const *p) {
+    Utils::Vector<unsigned, 3> bin;
+    for (unsigned d = 0; d < 3; d++) {
+      auto const extent = hi[d] - lo[d];
+      bin[d] =
+          (extent > 0.) ? std::min(3u, static_cast<unsigned>(
+                                           4. * (p->r.p[d] - lo[d]) / extent))
+                        : 0u;
+    }
+    return Utils::morton_index(bin);
+  };
+
+  std::stable_sort(first, last, [&](Particle const *a, Particle const *b) {
+    return key(a) < key(b);
+  });
+}
+} // namespace
+
+void ParticleSoA::rebuild(Utils::Span<Cell *> local_cells,
+                          Utils::Span<Cell *> ghost_cells,
+                          std::size_t cluster_size) {
+  assert(cluster_size > 0);
+  particles.clear();
+  cell_begin.clear();
+  cell_end.clear();
+  neighbor_begin.clear();
+  neighbors.clear();
+
+  std::unordered_map<Cell const *, std::size_t> cell_index;
+  auto add_cells = [&](Utils::Span<Cell *> cells) {
+    for (auto cell : cells) {
+      cell_index[cell] = cell_begin.size();
+      cell_begin.push_back(particles.size());
+      for (auto &p : cell->particles()) {
+        particles.push_back(&p);
+      }
+      cell_end.push_back(particles.size());
+
+      if (cluster_size > 1) {
+        spatial_sort(particles.begin() + cell_begin.back(), particles.end());
+        auto const n_padding =
+            (cluster_size - particles.size() % cluster_size) % cluster_size;
+        particles.resize(particles.size() + n_padding, nullptr);
+      }
+    }
+  };
+
+  add_cells(local_cells);
+  add_cells(ghost_cells);
+  n_local_cells = local_cells.size();
+
+  for (auto cell : local_cells) {
+    neighbor_begin.push_back(neighbors.size());
+    for (auto neighbor : cell->neighbors().red()) {
+      assert(cell_index.count(neighbor));
+      neighbors.push_back(cell_index.at(neighbor));
+    }
+  }
+  neighbor_begin.push_back(neighbors.size());
+
+  auto const n_part = particles.size();
+  for (auto v : {&x, &y, &z, &fx, &fy, &fz, &q}) {
+    v->assign(n_part, 0.);
+  }
+  type.assign(n_part, 0);
+}
+
+void ParticleSoA::gather() {
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    if (not particles[i])
+      continue;
+
+    auto const &p = *particles[i];
+    x[i] = p.r.p[0];
+    y[i] = p.r.p[1];
+    z[i] = p.r.p[2];
+    type[i] = p.p.type;
+#ifdef ELECTROSTATICS
+    q[i] = p.p.q;
+#endif
+  }
+
+  std::fill(fx.begin(), fx.end(), 0.);
+  std::fill(fy.begin(), fy.end(), 0.);
+  std::fill(fz.begin(), fz.end(), 0.);
+}
+
+void ParticleSoA::scatter_forces() const {
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    if (not particles[i])
+      continue;
+
+    auto &f = particles[i]->f.f;
+    f[0] += fx[i];
+    f[1] += fy[i];
+    f[2] += fz[i];
+  }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_PARTICLE_SOA_HPP
+#define ESPRESSO_PARTICLE_SOA_HPP
+
+#include "Cell.hpp"
+#include "Particle.hpp"
+
+#include <utils/Span.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Structure-of-arrays mirror of the particle data
+ *        used by the non-bonded pair kernels.
+ *
+ * The particles are stored cell by cell, local cells first and
+ * ghost cells after them, so that every cell occupies a contiguous
+ * index range of the arrays. The pair kernels can then run over
+ * the particles of a neighbor cell with unit stride. Optionally the
+ * range of every cell is padded to a multiple of a cluster size, and
+ * the particles within a cell are ordered such that consecutive
+ * particles are close in space. Padding entries have no particle
+ * and are ignored by @ref ParticleSoA::gather and
+ * @ref ParticleSoA::scatter_forces.
+ *
+ * The layout only depends on the cell contents and has to be
+ * rebuilt by @ref ParticleSoA::rebuild whenever the particles were
+ * resorted. Positions, types and charges are copied in by
+ * @ref ParticleSoA::gather before every force calculation, the
+ * forces are added back to the particles by
+ * @ref ParticleSoA::scatter_forces.
+ */
+struct ParticleSoA {
+  /** Positions */
+  std::vector<double> x, y, z;
+  /** Forces accumulated by the pair kernels */
+  std::vector<double> fx, fy, fz;
+  /** Charges */
+  std::vector<double> q;
+  /** Particle types */
+  std::vector<int> type;
+  /** Particle every entry belongs to, nullptr for padding */
+  std::vector<Particle *> particles;
+
+  /** Particle range [cell_begin[i], cell_end[i]) of cell i */
+  std::vector<std::size_t> cell_begin, cell_end;
+  /** Red neighbors of local cell i are neighbors[neighbor_begin[i]]
+   *  to neighbors[neighbor_begin[i + 1] - 1] */
+  std::vector<std::size_t> neighbor_begin;
+  std::vector<std::size_t> neighbors;
+  /** Number of local cells */
+  std::size_t n_local_cells = 0;
+
+  std::size_t size() const { return particles.size(); }
+
+  /**
+   * @brief Rebuild the layout from the cells.
+   *
+   * @param local_cells Cells with the local particles.
+   * @param ghost_cells Cells with the ghost particles.
+   * @param cluster_size The range of every cell starts at a multiple
+   *        of this, for values larger than one the particles are also
+   *        spatially ordered within the cells.
+   */
+  void rebuild(Utils::Span<Cell *> local_cells,
+               Utils::Span<Cell *> ghost_cells, std::size_t cluster_size = 1);
+
+  /**
+   * @brief Copy positions, types and charges from the
+   *        particles and reset the forces.
+   */
+  void gather();
+
+  /**
+   * @brief Add the accumulated forces to the particles.
+   */
+  void scatter_forces() const;
+};
+
+#endif
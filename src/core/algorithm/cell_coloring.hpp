@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ALGORITHM_CELL_COLORING_HPP
+#define ALGORITHM_CELL_COLORING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Algorithm {
+
+/**
+ * @brief Partition cells into colors, such that the work items of
+ *        cells of the same color can be processed concurrently.
+ *
+ * The work item of a cell may modify the particles of all cells in
+ * its write set. Two cells get different colors if their write sets
+ * overlap. The colors are assigned greedily in the order of the cells.
+ *
+ * @param cells Range of cell references.
+ * @param write_set Callable that returns a range with the cell
+ *        references modified by the work item of a cell.
+ * @return For every color the indices of its cells in @p cells.
+ */
+template <typename CellRange, typename WriteSet>
+std::vector<std::vector<std::size_t>> color_cells(CellRange const &cells,
+                                                  WriteSet &&write_set) {
+  using CellRef = std::decay_t<decltype(*std::begin(cells))>;
+
+  std::vector<std::vector<std::size_t>> colors;
+  /* Colors of the cells which modify a cell */
+  std::unordered_map<CellRef, std::vector<std::size_t>> modified_by;
+
+  std::size_t index = 0;
+  for (auto const &cell : cells) {
+    auto const targets = write_set(cell);
+
+    std::vector<bool> forbidden(colors.size(), false);
+    for (auto const &target : targets) {
+      auto const it = modified_by.find(target);
+      if (it != modified_by.end()) {
+        for (auto const color : it->second) {
+          forbidden[color] = true;
+        }
+      }
+    }
+
+    auto const color = static_cast<std::size_t>(std::distance(
+        forbidden.begin(),
+        std::find(forbidden.begin(), forbidden.end(), false)));
+    if (color == colors.size()) {
+      colors.emplace_back();
+    }
+    colors[color].push_back(index++);
+
+    for (auto const &target : targets) {
+      modified_by[target].push_back(color);
+    }
+  }
+
+  return colors;
+}
+} // namespace Algorithm
+
+#endif
@@ -50,6 +50,25 @@ void link_cell(CellIterator first, CellIterator last,
     }
   }
 }
+
+/**
+ * @brief Iterates over all pairs of the particles in the cell
+ *        range with the particles of their neighbors, but not
+ *        over the pairs within the cells.
+ */
+template <typename CellIterator, typename PairKernel>
+void link_cell_neighbors(CellIterator first, CellIterator last,
+                         PairKernel &&pair_kernel) {
+  for (; first != last; ++first) {
+    for (auto &p1 : first->particles()) {
+      for (auto &neighbor : first->neighbors().red()) {
+        for (auto &p2 : neighbor->particles()) {
+          pair_kernel(p1, p2);
+        }
+      }
+    }
+  }
+}
 } // namespace Algorithm
 
 #endif
@@ -27,6 +27,7 @@
 #include "cells.hpp"
 
 #include "Particle.hpp"
+#include "collision.hpp"
 #include "communication.hpp"
 #include "errorhandling.hpp"
 #include "event.hpp"
@@ -173,6 +174,10 @@ void cells_re_init(int new_cs) {
   case CELL_STRUCTURE_NSQUARE:
     cell_structure.set_atom_decomposition(comm_cart, box_geo);
     break;
+  case CELL_STRUCTURE_EIGHTH_SHELL:
+    cell_structure.set_eighth_shell_decomposition(
+        comm_cart, interaction_range(), box_geo, local_geo);
+    break;
   default:
     throw std::runtime_error("Unknown cell system type");
   }
@@ -198,7 +203,32 @@ void check_resort_particles() {
   cell_structure.set_resort_particles(level);
 }
 
-void cells_update_ghosts(unsigned data_parts) {
+void cells_sanity_checks() {
+  if (cell_structure.decomposition_type() != CELL_STRUCTURE_EIGHTH_SHELL)
+    return;
+
+  auto const particles = cell_structure.local_particles();
+  auto const has_partners =
+      std::any_of(particles.begin(), particles.end(), [](Particle const &p) {
+#ifdef VIRTUAL_SITES
+        if (p.p.is_virtual)
+          return true;
+#endif
+        return not p.bonds().empty();
+      });
+  if (boost::mpi::all_reduce(comm_cart, has_partners, std::logical_or<>())) {
+    runtimeErrorMsg() << "The eighth-shell decomposition does not support "
+                         "bonds and virtual sites";
+  }
+#ifdef COLLISION_DETECTION
+  if (collision_params.mode != COLLISION_MODE_OFF) {
+    runtimeErrorMsg() << "The eighth-shell decomposition does not support "
+                         "collision detection";
+  }
+#endif
+}
+
+bool cells_update_ghosts(unsigned data_parts, bool split_phase) {
   /* data parts that are only updated on resort */
   auto constexpr resort_only_parts =
       Cells::DATA_PART_PROPERTIES | Cells::DATA_PART_BONDS;
@@ -228,8 +258,13 @@ void cells_update_ghosts(unsigned data_parts) {
     cell_structure.clear_resort_particles();
   } else {
     /* Communication step: ghost information */
-    cell_structure.ghosts_update(data_parts & ~resort_only_parts);
+    if (split_phase and cell_structure.use_ghost_overlap)
+      cell_structure.ghosts_update_begin(data_parts & ~resort_only_parts);
+    else
+      cell_structure.ghosts_update(data_parts & ~resort_only_parts);
   }
+
+  return global_resort != Cells::RESORT_NONE;
 }
 
 Cell *find_current_cell(const Particle &p) {
@@ -250,3 +285,85 @@ REGISTER_CALLBACK(mpi_set_use_verlet_lists_local)
 void mpi_set_use_verlet_lists(bool use_verlet_lists) {
   mpi_call_all(mpi_set_use_verlet_lists_local, use_verlet_lists);
 }
+
+void mpi_set_use_cluster_pair_list_local(bool use_cluster_pair_list) {
+  cell_structure.use_cluster_pair_list = use_cluster_pair_list;
+}
+
+REGISTER_CALLBACK(mpi_set_use_cluster_pair_list_local)
+
+void mpi_set_use_cluster_pair_list(bool use_cluster_pair_list) {
+  mpi_call_all(mpi_set_use_cluster_pair_list_local, use_cluster_pair_list);
+}
+
+void mpi_set_use_pair_class_lists_local(bool use_pair_class_lists) {
+  cell_structure.use_pair_class_lists = use_pair_class_lists;
+}
+
+REGISTER_CALLBACK(mpi_set_use_pair_class_lists_local)
+
+void mpi_set_use_pair_class_lists(bool use_pair_class_lists) {
+  mpi_call_all(mpi_set_use_pair_class_lists_local, use_pair_class_lists);
+}
+
+void mpi_set_use_ghost_overlap_local(bool use_ghost_overlap) {
+  cell_structure.use_ghost_overlap = use_ghost_overlap;
+}
+
+REGISTER_CALLBACK(mpi_set_use_ghost_overlap_local)
+
+void mpi_set_use_ghost_overlap(bool use_ghost_overlap) {
+  mpi_call_all(mpi_set_use_ghost_overlap_local, use_ghost_overlap);
+}
+
+void mpi_set_use_ghost_position_deltas_local(bool use_ghost_position_deltas) {
+  cell_structure.use_ghost_position_deltas = use_ghost_position_deltas;
+}
+
+REGISTER_CALLBACK(mpi_set_use_ghost_position_deltas_local)
+
+void mpi_set_use_ghost_position_deltas(bool use_ghost_position_deltas) {
+  mpi_call_all(mpi_set_use_ghost_position_deltas_local,
+               use_ghost_position_deltas);
+}
+
+void mpi_set_use_morton_order_local(bool use_morton_order) {
+  cell_structure.use_morton_order = use_morton_order;
+}
+
+REGISTER_CALLBACK(mpi_set_use_morton_order_local)
+
+void mpi_set_use_morton_order(bool use_morton_order) {
+  mpi_call_all(mpi_set_use_morton_order_local, use_morton_order);
+}
+
+void mpi_set_use_neighbor_collectives_local(bool use_neighbor_collectives) {
+  cell_structure.use_neighbor_collectives = use_neighbor_collectives;
+}
+
+REGISTER_CALLBACK(mpi_set_use_neighbor_collectives_local)
+
+void mpi_set_use_neighbor_collectives(bool use_neighbor_collectives) {
+  mpi_call_all(mpi_set_use_neighbor_collectives_local,
+               use_neighbor_collectives);
+}
+
+void mpi_set_use_shared_memory_local(bool use_shared_memory) {
+  cell_structure.use_shared_memory = use_shared_memory;
+}
+
+REGISTER_CALLBACK(mpi_set_use_shared_memory_local)
+
+void mpi_set_use_shared_memory(bool use_shared_memory) {
+  mpi_call_all(mpi_set_use_shared_memory_local, use_shared_memory);
+}
+
+void mpi_set_use_soa_kernels_local(bool use_soa_kernels) {
+  cell_structure.use_soa_kernels = use_soa_kernels;
+}
+
+REGISTER_CALLBACK(mpi_set_use_soa_kernels_local)
+
+void mpi_set_use_soa_kernels(bool use_soa_kernels) {
+  mpi_call_all(mpi_set_use_soa_kernels_local, use_soa_kernels);
+}
@@ -76,10 +76,88 @@ void mpi_bcast_cell_structure(int cs);
  */
 void mpi_set_use_verlet_lists(bool use_verlet_lists);
 
+/**
+ * @brief Set @ref CellStructure::use_cluster_pair_list
+ * "cell_structure::use_cluster_pair_list"
+ *
+ * @param use_cluster_pair_list Should cluster pairs be used
+ *        for the Verlet lists?
+ */
+void mpi_set_use_cluster_pair_list(bool use_cluster_pair_list);
+
+/**
+ * @brief Set @ref CellStructure::use_pair_class_lists
+ * "cell_structure::use_pair_class_lists"
+ *
+ * @param use_pair_class_lists Should the pairs that only interact
+ *        via the long-range methods be kept in separate lists?
+ */
+void mpi_set_use_pair_class_lists(bool use_pair_class_lists);
+
+/**
+ * @brief Set @ref CellStructure::use_ghost_overlap
+ * "cell_structure::use_ghost_overlap"
+ *
+ * @param use_ghost_overlap Should the ghost communication of the
+ *        integration steps overlap the force calculation?
+ */
+void mpi_set_use_ghost_overlap(bool use_ghost_overlap);
+
+/**
+ * @brief Set @ref CellStructure::use_ghost_position_deltas
+ * "cell_structure::use_ghost_position_deltas"
+ *
+ * @param use_ghost_position_deltas Should the ghost positions between
+ *        resorts be sent as single precision displacements?
+ */
+void mpi_set_use_ghost_position_deltas(bool use_ghost_position_deltas);
+
+/**
+ * @brief Set @ref CellStructure::use_morton_order
+ * "cell_structure::use_morton_order"
+ *
+ * @param use_morton_order Should the domain decomposition keep
+ *        cells and particles in Morton order?
+ */
+void mpi_set_use_morton_order(bool use_morton_order);
+
+/**
+ * @brief Set @ref CellStructure::use_neighbor_collectives
+ * "cell_structure::use_neighbor_collectives"
+ *
+ * @param use_neighbor_collectives Should the domain decomposition
+ *        exchange the ghosts by neighborhood collectives?
+ */
+void mpi_set_use_neighbor_collectives(bool use_neighbor_collectives);
+
+/**
+ * @brief Set @ref CellStructure::use_shared_memory
+ * "cell_structure::use_shared_memory"
+ *
+ * @param use_shared_memory Should the domain decomposition exchange
+ *        the ghosts with nodes on the same host by shared memory?
+ */
+void mpi_set_use_shared_memory(bool use_shared_memory);
+
+/**
+ * @brief Set @ref CellStructure::use_soa_kernels
+ * "cell_structure::use_soa_kernels"
+ *
+ * @param use_soa_kernels Should the structure-of-arrays
+ *        pair kernels be used?
+ */
+void mpi_set_use_soa_kernels(bool use_soa_kernels);
+
 /** Update ghost information. If needed,
  *  the particles are also resorted.
+ *  @param data_parts  Particle parts to update.
+ *  @param split_phase Only start the update if the particles were not
+ *                     resorted and @ref CellStructure::use_ghost_overlap
+ *                     is set. It then has to be finished by @ref
+ *                     CellStructure::ghosts_finish.
+ *  @return Whether the particles were resorted.
  */
-void cells_update_ghosts(unsigned data_parts);
+bool cells_update_ghosts(unsigned data_parts, bool split_phase = false);
 
 /**
  * @brief Get pairs closer than @p distance from the cells.
@@ -99,6 +177,13 @@ mpi_get_pairs_of_types(double distance, std::vector<int> const &types);
 /** Check if a particle resorting is required. */
 void check_resort_particles();
 
+/** Check that the cell system supports the interactions in use.
+ *  The eighth-shell decomposition has no ghosts beyond the lower
+ *  boundaries of the local box, so it cannot resolve the partners of
+ *  bonds, virtual sites and collisions.
+ */
+void cells_sanity_checks();
+
 /**
  * @brief Resort the particles.
  *
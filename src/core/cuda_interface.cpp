@@ -56,7 +56,7 @@ static void pack_particles(ParticleRange particles,
 #endif
 
 #if defined(LB_ELECTROHYDRODYNAMICS) && defined(CUDA)
-    buffer[i].mu_E = static_cast<Vector3f>(part.p.mu_E);
+    buffer[i].mu_E = static_cast<Vector3f>(part.c.mu_E);
 #endif
 
 #ifdef ELECTROSTATICS
@@ -72,14 +72,14 @@ static void pack_particles(ParticleRange particles,
 #endif
 
 #ifdef ENGINE
-    buffer[i].swim.v_swim = static_cast<float>(part.p.swim.v_swim);
-    buffer[i].swim.f_swim = static_cast<float>(part.p.swim.f_swim);
+    buffer[i].swim.v_swim = static_cast<float>(part.c.swim.v_swim);
+    buffer[i].swim.f_swim = static_cast<float>(part.c.swim.f_swim);
     buffer[i].swim.director = buffer[i].director;
 
-    buffer[i].swim.push_pull = part.p.swim.push_pull;
+    buffer[i].swim.push_pull = part.c.swim.push_pull;
     buffer[i].swim.dipole_length =
-        static_cast<float>(part.p.swim.dipole_length);
-    buffer[i].swim.swimming = part.p.swim.swimming;
+        static_cast<float>(part.c.swim.dipole_length);
+    buffer[i].swim.swimming = part.c.swim.swimming;
 #endif
     i++;
   }
@@ -248,29 +248,33 @@ void init() {
   }
 }
 
-void calc_long_range_force(const ParticleRange &particles) {
+void calc_long_range_force(const ParticleRange &particles, bool method,
+                           bool corrections) {
   switch (coulomb.method) {
 #ifdef P3M
   case COULOMB_ELC_P3M:
-    if (elc_params.dielectric_contrast_on) {
-      ELC_P3M_modify_p3m_sums_both(particles);
-      ELC_p3m_charge_assign_both(particles);
-      ELC_P3M_self_forces(particles);
-    } else
-      p3m_charge_assign(particles);
+    if (method) {
+      if (elc_params.dielectric_contrast_on) {
+        ELC_P3M_modify_p3m_sums_both(particles);
+        ELC_p3m_charge_assign_both(particles);
+        ELC_P3M_self_forces(particles);
+      } else
+        p3m_charge_assign(particles);
 
-    p3m_calc_kspace_forces(true, false, particles);
+      p3m_calc_kspace_forces(true, false, particles);
 
-    if (elc_params.dielectric_contrast_on)
-      ELC_P3M_restore_p3m_sums(particles);
+      if (elc_params.dielectric_contrast_on)
+        ELC_P3M_restore_p3m_sums(particles);
+    }
 
-    ELC_add_force(particles);
+    if (corrections)
+      ELC_add_force(particles);
 
     break;
 #endif
 #ifdef CUDA
   case COULOMB_P3M_GPU:
-    if (this_node == 0) {
+    if (method and this_node == 0) {
       p3m_gpu_add_farfield_force();
     }
     /* there is no NPT handling here as long as we cannot compute energies.
@@ -280,6 +284,8 @@ void calc_long_range_force(const ParticleRange &particles) {
 #endif
 #ifdef P3M
   case COULOMB_P3M:
+    if (not method)
+      break;
     p3m_charge_assign(particles);
 #ifdef NPT
     if (integ_switch == INTEG_METHOD_NPT_ISO) {
@@ -292,7 +298,8 @@ void calc_long_range_force(const ParticleRange &particles) {
 #endif
 #ifdef SCAFACOS
   case COULOMB_SCAFACOS:
-    Scafacos::fcs_coulomb()->add_long_range_force();
+    if (method)
+      Scafacos::fcs_coulomb()->add_long_range_force();
     break;
 #endif
   default:
@@ -301,7 +308,7 @@ void calc_long_range_force(const ParticleRange &particles) {
 
   /* Add fields from EK if enabled */
 #ifdef ELECTROKINETICS
-  if (this_node == 0) {
+  if (method and this_node == 0) {
     ek_calculate_electrostatic_coupling();
   }
 #endif
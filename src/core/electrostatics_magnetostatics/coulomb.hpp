@@ -71,7 +71,13 @@ void on_coulomb_change();
 void on_boxl_change();
 void init();
 
-void calc_long_range_force(const ParticleRange &particles);
+/** Add the long-range forces.
+ *  @param particles    Local particles
+ *  @param method       Add the forces of the method itself
+ *  @param corrections  Add the ELC corrections
+ */
+void calc_long_range_force(const ParticleRange &particles, bool method = true,
+                           bool corrections = true);
 
 double calc_energy_long_range(const ParticleRange &particles);
 
@@ -163,13 +163,17 @@ void init() {
   }
 }
 
-void calc_long_range_force(const ParticleRange &particles) {
+void calc_long_range_force(const ParticleRange &particles, bool method,
+                           bool corrections) {
   switch (dipole.method) {
 #ifdef DP3M
   case DIPOLAR_MDLC_P3M:
-    add_mdlc_force_corrections(particles);
+    if (corrections)
+      add_mdlc_force_corrections(particles);
     // fall through
   case DIPOLAR_P3M:
+    if (not method)
+      break;
     dp3m_dipole_assign(particles);
 #ifdef NPT
     if (integ_switch == INTEG_METHOD_NPT_ISO) {
@@ -183,15 +187,18 @@ void calc_long_range_force(const ParticleRange &particles) {
     break;
 #endif
   case DIPOLAR_ALL_WITH_ALL_AND_NO_REPLICA:
-    dawaanr_calculations(true, false, particles);
+    if (method)
+      dawaanr_calculations(true, false, particles);
     break;
 #ifdef DP3M
   case DIPOLAR_MDLC_DS:
-    add_mdlc_force_corrections(particles);
+    if (corrections)
+      add_mdlc_force_corrections(particles);
     // fall through
 #endif
   case DIPOLAR_DS:
-    magnetic_dipolar_direct_sum_calculations(true, false, particles);
+    if (method)
+      magnetic_dipolar_direct_sum_calculations(true, false, particles);
     break;
   case DIPOLAR_DS_GPU: // NOLINT(bugprone-branch-clone)
     // do nothing: it's an actor
@@ -203,7 +210,8 @@ void calc_long_range_force(const ParticleRange &particles) {
 #endif
 #ifdef SCAFACOS_DIPOLES
   case DIPOLAR_SCAFACOS:
-    Scafacos::fcs_dipoles()->add_long_range_force();
+    if (method)
+      Scafacos::fcs_dipoles()->add_long_range_force();
 #endif
   case DIPOLAR_NONE:
     break;
@@ -42,6 +42,7 @@
 #include <fftw3.h>
 #include <mpi.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -247,7 +248,9 @@ int calc_send_block(const int *pos1, const int *grid1, const int *pos2,
     last1[i] = first1[i] + mesh1[i] - 1;
     last2[i] = first2[i] + mesh2[i] - 1;
     block[i] = std::max(first1[i], first2[i]) - first1[i];
-    block[i + 3] = (std::min(last1[i], last2[i]) - first1[i]) - block[i] + 1;
+    /* empty if the local meshes do not overlap */
+    block[i + 3] = std::max(
+        0, (std::min(last1[i], last2[i]) - first1[i]) - block[i] + 1);
     size *= block[i + 3];
   }
   return size;
@@ -350,6 +353,71 @@ void pack_block_permute2(double const *const in, double *const out,
   }
 }
 
+/** Communicate the grid data to all nodes at once. This is used
+ *  instead of the pairwise communication within a group for node
+ *  grids that do not fit to each other. The block of the calling
+ *  node is unpacked while the blocks of the other nodes are in
+ *  flight.
+ *  \param pack_function  Packing function for the send blocks.
+ *  \param send_block     Send block specifications, for every node.
+ *  \param send_size      Send block sizes, for every node.
+ *  \param old_mesh       Size of the input mesh.
+ *  \param recv_block     Recv block specifications, for every node.
+ *  \param recv_size      Recv block sizes, for every node.
+ *  \param new_mesh       Size of the output mesh.
+ *  \param element        Size of a grid element.
+ *  \param in             input mesh.
+ *  \param out            output mesh.
+ *  \param fft            FFT communication plan.
+ *  \param comm           MPI communicator.
+ */
+void all_to_all_grid_comm(
+    void (*pack_function)(double const *const, double *const, int const *,
+                          int const *, int const *, int),
+    std::vector<int> const &send_block, std::vector<int> const &send_size,
+    int const *old_mesh, std::vector<int> const &recv_block,
+    std::vector<int> const &recv_size, int const *new_mesh, int element,
+    const double *in, double *out, fft_data_struct &fft,
+    const boost::mpi::communicator &comm) {
+  auto const n_nodes = comm.size();
+  std::vector<int> send_count(send_size), send_displ(n_nodes);
+  std::vector<int> recv_count(recv_size), recv_displ(n_nodes);
+
+  int send_offset = 0, recv_offset = 0;
+  for (int node = 0; node < n_nodes; node++) {
+    send_displ[node] = send_offset;
+    recv_displ[node] = recv_offset;
+    send_offset += send_size[node];
+    recv_offset += recv_size[node];
+    if (send_size[node] > 0)
+      pack_function(in, fft.send_buf.data() + send_displ[node],
+                    &(send_block[6 * node]), &(send_block[6 * node + 3]),
+                    old_mesh, element);
+  }
+
+  /* The own block is not sent, but unpacked directly. */
+  auto const self = comm.rank();
+  send_count[self] = 0;
+  recv_count[self] = 0;
+
+  MPI_Request request;
+  MPI_Ialltoallv(fft.send_buf.data(), send_count.data(), send_displ.data(),
+                 MPI_DOUBLE, fft.recv_buf.data(), recv_count.data(),
+                 recv_displ.data(), MPI_DOUBLE, comm, &request);
+  if (recv_size[self] > 0)
+    fft_unpack_block(fft.send_buf.data() + send_displ[self], out,
+                     &(recv_block[6 * self]), &(recv_block[6 * self + 3]),
+                     new_mesh, element);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+  for (int node = 0; node < n_nodes; node++) {
+    if (node != self and recv_size[node] > 0)
+      fft_unpack_block(fft.recv_buf.data() + recv_displ[node], out,
+                       &(recv_block[6 * node]), &(recv_block[6 * node + 3]),
+                       new_mesh, element);
+  }
+}
+
 /** Communicate the grid data according to the given forward FFT plan.
  *  \param plan   FFT communication plan.
  *  \param in     input mesh.
@@ -360,6 +428,13 @@ void pack_block_permute2(double const *const in, double *const out,
 void forw_grid_comm(fft_forw_plan plan, const double *in, double *out,
                     fft_data_struct &fft,
                     const boost::mpi::communicator &comm) {
+  if (plan.all_to_all) {
+    all_to_all_grid_comm(plan.pack_function, plan.send_block, plan.send_size,
+                         plan.old_mesh, plan.recv_block, plan.recv_size,
+                         plan.new_mesh, plan.element, in, out, fft, comm);
+    return;
+  }
+
   for (int i = 0; i < plan.group.size(); i++) {
     plan.pack_function(in, fft.send_buf.data(), &(plan.send_block[6 * i]),
                        &(plan.send_block[6 * i + 3]), plan.old_mesh,
@@ -393,6 +468,13 @@ void back_grid_comm(fft_forw_plan plan_f, fft_back_plan plan_b,
   /* Back means: Use the send/receive stuff from the forward plan but
      replace the receive blocks by the send blocks and vice
      versa. Attention then also new_mesh and old_mesh are exchanged */
+  if (plan_f.all_to_all) {
+    all_to_all_grid_comm(plan_b.pack_function, plan_f.recv_block,
+                         plan_f.recv_size, plan_f.new_mesh, plan_f.send_block,
+                         plan_f.send_size, plan_f.old_mesh, plan_f.element,
+                         in, out, fft, comm);
+    return;
+  }
 
   for (int i = 0; i < plan_f.group.size(); i++) {
     plan_b.pack_function(in, fft.send_buf.data(), &(plan_f.recv_block[6 * i]),
@@ -468,6 +550,37 @@ int map_3don2d_grid(int const g3d[3], int g2d[3], int mult[3]) {
   return row_dir;
 }
 
+/** Place the nodes on a node grid in the order of their identity. This
+ *  is used for node grids that do not fit to the previous one (see
+ *  \ref find_comm_groups), which then have to be changed by communication
+ *  between all nodes.
+ *
+ *  \param[in]  grid       The node grid.
+ *  \param[out] node_list  Linear node index list for @p grid.
+ *  \param[out] pos        Positions of the nodes in @p grid.
+ *  \param[out] my_pos     Position of comm.rank() in @p grid.
+ *  \param[in]  comm       MPI communicator.
+ *  \return All nodes, as communication group.
+ */
+std::vector<int> place_nodes(Utils::Vector3i const &grid,
+                             Utils::Span<int> node_list, Utils::Span<int> pos,
+                             Utils::Span<int> my_pos,
+                             boost::mpi::communicator const &comm) {
+  std::vector<int> group(comm.size());
+  for (int n = 0; n < comm.size(); n++) {
+    int const p[3] = {n % grid[0], (n / grid[0]) % grid[1],
+                      n / (grid[0] * grid[1])};
+    node_list[get_linear_index(p[0], p[1], p[2], grid)] = n;
+    for (int i = 0; i < 3; i++) {
+      pos[3 * n + i] = p[i];
+      if (n == comm.rank())
+        my_pos[i] = p[i];
+    }
+    group[n] = n;
+  }
+  return group;
+}
+
 /** Calculate most square 2D grid. */
 void calc_2d_grid(int n, int grid[3]) {
   for (auto i = static_cast<int>(std::sqrt(n)); i >= 1; i--) {
@@ -522,6 +635,11 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
   calc_2d_grid(comm.size(), n_grid[1]);
   /* resort n_grid[1] dimensions if necessary */
   fft.plan[1].row_dir = map_3don2d_grid(n_grid[0], n_grid[1], mult);
+  if (fft.plan[1].row_dir < 0) {
+    /* no 2D grid fits to the real space grid, keep the most square one,
+       it is reached by communication between all nodes */
+    fft.plan[1].row_dir = 2;
+  }
   fft.plan[0].n_permute = 0;
   for (i = 1; i < 4; i++)
     fft.plan[i].n_permute = (fft.plan[1].row_dir + i) % 3;
@@ -529,8 +647,8 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
     n_grid[2][i] = n_grid[1][(i + 1) % 3];
     n_grid[3][i] = n_grid[1][(i + 2) % 3];
   }
-  fft.plan[2].row_dir = (fft.plan[1].row_dir - 1) % 3;
-  fft.plan[3].row_dir = (fft.plan[1].row_dir - 2) % 3;
+  fft.plan[2].row_dir = (fft.plan[1].row_dir + 2) % 3;
+  fft.plan[3].row_dir = (fft.plan[1].row_dir + 1) % 3;
 
   /* === communication groups === */
   /* copy local mesh off real space charge assignment grid */
@@ -539,11 +657,14 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
 
   for (i = 1; i < 4; i++) {
     using Utils::make_span;
-    auto group = find_comm_groups(
-        {n_grid[i - 1][0], n_grid[i - 1][1], n_grid[i - 1][2]},
-        {n_grid[i][0], n_grid[i][1], n_grid[i][2]}, n_id[i - 1],
-        make_span(n_id[i]), make_span(n_pos[i]), my_pos[i], comm);
-    if (not group) {
+    boost::optional<std::vector<int>> group;
+    if (not fft.force_all_to_all) {
+      group = find_comm_groups(
+          {n_grid[i - 1][0], n_grid[i - 1][1], n_grid[i - 1][2]},
+          {n_grid[i][0], n_grid[i][1], n_grid[i][2]}, n_id[i - 1],
+          make_span(n_id[i]), make_span(n_pos[i]), my_pos[i], comm);
+    }
+    if (not group and not fft.force_all_to_all) {
       /* try permutation */
       std::swap(n_grid[i][(fft.plan[i].row_dir + 1) % 3],
                 n_grid[i][(fft.plan[i].row_dir + 2) % 3]);
@@ -552,10 +673,13 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
           {n_grid[i - 1][0], n_grid[i - 1][1], n_grid[i - 1][2]},
           {n_grid[i][0], n_grid[i][1], n_grid[i][2]}, make_span(n_id[i - 1]),
           make_span(n_id[i]), make_span(n_pos[i]), my_pos[i], comm);
-
-      if (not group) {
-        throw std::runtime_error("INTERNAL ERROR: fft_find_comm_groups error");
-      }
+    }
+    /* the grids do not fit to each other, communicate with all nodes */
+    fft.plan[i].all_to_all = not group;
+    if (fft.plan[i].all_to_all) {
+      group = place_nodes({n_grid[i][0], n_grid[i][1], n_grid[i][2]},
+                          make_span(n_id[i]), make_span(n_pos[i]), my_pos[i],
+                          comm);
     }
 
     fft.plan[i].group = *group;
@@ -573,6 +697,7 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
     fft.plan[i].n_ffts = fft.plan[i].new_mesh[0] * fft.plan[i].new_mesh[1];
 
     /* === send/recv block specifications === */
+    int send_total = 0, recv_total = 0;
     for (j = 0; j < fft.plan[i].group.size(); j++) {
       /* send block: comm.rank() to comm-group-node i (identity: node) */
       int node = fft.plan[i].group[j];
@@ -602,7 +727,13 @@ int fft_init(const Utils::Vector3i &ca_mesh_dim, int const *ca_mesh_margin,
                      -(fft.plan[i].n_permute));
       if (fft.plan[i].recv_size[j] > fft.max_comm_size)
         fft.max_comm_size = fft.plan[i].recv_size[j];
+      send_total += fft.plan[i].send_size[j];
+      recv_total += fft.plan[i].recv_size[j];
     }
+    /* all blocks are communicated at once */
+    if (fft.plan[i].all_to_all)
+      fft.max_comm_size =
+          std::max({fft.max_comm_size, send_total, recv_total});
 
     for (j = 0; j < 3; j++)
       fft.plan[i].old_mesh[j] = fft.plan[i - 1].new_mesh[j];
@@ -29,7 +29,10 @@
  *  distributed in such a way, that for the actual direction of the
  *  FFT each node has a certain number of rows for which it performs a
  *  1D-FFT. After performing the FFT on that direction the data is
- *  redistributed.
+ *  redistributed. Where the node grids of two directions are multiples
+ *  of each other, this is done in small groups of nodes, otherwise
+ *  by one all-to-all communication, so the FFT works for any number
+ *  of nodes and any real space node grid.
  *
  *  For simplicity at the moment I have implemented a full complex to
  *  complex FFT (even though a real to complex FFT would be
@@ -113,6 +116,9 @@ struct fft_forw_plan {
 
   /** group of nodes which have to communicate with each other. */
   std::vector<int> group;
+  /** whether all nodes communicate at once, because the node grids
+   *  do not fit to each other. @ref group then contains all nodes. */
+  bool all_to_all;
 
   /** packing function for send blocks. */
   void (*pack_function)(double const *const, double *const, int const *,
@@ -157,6 +163,10 @@ struct fft_data_struct {
   /** Whether FFT is initialized or not. */
   bool init_tag = false;
 
+  /** Change all node grids by communication between all nodes, even
+   *  where the grids fit to each other. */
+  bool force_all_to_all = false;
+
   /** Maximal size of the communication buffers. */
   int max_comm_size = 0;
 
@@ -132,6 +132,10 @@ typedef struct {
 
   /** epsilon of the "surrounding dielectric". */
   double epsilon = P3M_EPSILON_METALLIC;
+  /** calculate the forces by analytical differentiation of the charge
+   *  assignment function instead of by i*k differentiation
+   *  (charge P3M only). */
+  bool analytic_diff = false;
   /** cutoff for charge assignment. */
   double cao_cut[3] = {};
   /** mesh constant. */
@@ -153,7 +157,7 @@ typedef struct {
 
   template <typename Archive> void serialize(Archive &ar, long int) {
     ar &tuning &alpha_L &r_cut_iL &mesh;
-    ar &mesh_off &cao &accuracy &epsilon &cao_cut;
+    ar &mesh_off &cao &accuracy &epsilon &analytic_diff &cao_cut;
     ar &a &ai &alpha &r_cut &cao3 &additional_mesh;
   }
 
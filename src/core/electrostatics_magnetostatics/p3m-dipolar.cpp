@@ -41,9 +41,11 @@
 #include "electrostatics_magnetostatics/common.hpp"
 #include "electrostatics_magnetostatics/dp3m_influence_function.hpp"
 #include "electrostatics_magnetostatics/fft.hpp"
+#include "electrostatics_magnetostatics/mdlc_correction.hpp"
 #include "electrostatics_magnetostatics/p3m-common.hpp"
 #include "electrostatics_magnetostatics/p3m_interpolation.hpp"
 #include "electrostatics_magnetostatics/p3m_send_mesh.hpp"
+#include "electrostatics_magnetostatics/p3m_tuning_cache.hpp"
 
 #include "Particle.hpp"
 #include "ParticleRange.hpp"
@@ -64,12 +66,15 @@
 
 #include <boost/mpi/collectives/all_reduce.hpp>
 #include <boost/mpi/collectives/reduce.hpp>
+#include <boost/optional.hpp>
 #include <boost/range/algorithm/min_element.hpp>
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdio>
 #include <functional>
+#include <string>
 #include <vector>
 
 /************************************************
@@ -1080,7 +1085,53 @@ static double dp3m_m_time(int mesh, int cao_min, int cao_max, int *_cao,
   return best_time;
 }
 
-int dp3m_adaptive_tune(bool verbose) {
+/** Properties of the current system that the tuning result depends on,
+ *  for the tuning cache. Includes the parameters fixed by the user.
+ */
+static P3MTuningKey dp3m_tuning_cache_key() {
+  P3MTuningKey key;
+  key.method = "dp3m";
+  key.box_l = box_geo.length();
+  key.node_grid = node_grid;
+  key.n_part = dp3m.sum_dip_part;
+  key.sum_sq = dp3m.sum_mu2;
+  key.accuracy = dp3m.params.accuracy;
+  key.prefactor = dipole.prefactor;
+  key.options = {static_cast<double>(dp3m.params.mesh[0]),
+                 static_cast<double>(dp3m.params.cao), dp3m.params.r_cut_iL,
+                 dp3m.params.epsilon, skin};
+  /* the MDLC correction is part of the timed force calculation */
+  if (dipole.method == DIPOLAR_MDLC_P3M) {
+    key.method = "mdlc_dp3m";
+    key.options.insert(key.options.end(), {dlc_params.gap_size,
+                                           dlc_params.maxPWerror,
+                                           dlc_params.far_cut});
+  }
+  return key;
+}
+
+/** Set and broadcast tuned parameters. */
+static void dp3m_set_tuned_params(P3MTuningResult const &result,
+                                  bool verbose) {
+  dp3m.params.r_cut_iL = result.r_cut_iL;
+  dp3m.params.mesh[0] = dp3m.params.mesh[1] = dp3m.params.mesh[2] =
+      result.mesh[0];
+  dp3m.params.cao = result.cao;
+  dp3m.params.alpha_L = result.alpha_L;
+  dp3m.params.accuracy = result.accuracy;
+  /* broadcast tuned p3m parameters */
+  mpi_bcast_coulomb_params();
+  /* Tell the user about the outcome */
+  if (verbose) {
+    std::printf(
+        "\nresulting parameters: mesh: %d, cao: %d, r_cut_iL: %.4e,"
+        "\n                      alpha_L: %.4e, accuracy: %.4e, time: %.0f\n",
+        result.mesh[0], result.cao, result.r_cut_iL, result.alpha_L,
+        result.accuracy, result.time);
+  }
+}
+
+int dp3m_adaptive_tune(bool verbose, std::string const &cache_file) {
   /** Tuning of dipolar P3M. The algorithm basically determines the mesh, cao
    *  and then the real space cutoff, in this nested order.
    *
@@ -1099,6 +1150,9 @@ int dp3m_adaptive_tune(bool verbose) {
    *  known optimum.
    */
   int mesh_max, mesh = -1, tmp_mesh;
+  /* whether the mesh range starts at the optimum of a similar system */
+  bool warm_start = false;
+  int cold_mesh_min = 0;
   double r_cut_iL_min, r_cut_iL_max, r_cut_iL = -1, tmp_r_cut_iL = 0.0;
   int cao_min, cao_max, cao = -1, tmp_cao;
 
@@ -1123,6 +1177,20 @@ int dp3m_adaptive_tune(bool verbose) {
                 dp3m.sum_dip_part, dp3m.sum_mu2);
   }
 
+  auto const cache_key = dp3m_tuning_cache_key();
+  auto const cache = cache_file.empty()
+                         ? std::vector<P3MTuningCacheEntry>{}
+                         : p3m_tuning_cache_read(cache_file);
+  if (auto const cached = p3m_tuning_cache_find(cache, cache_key)) {
+    if (verbose) {
+      std::printf("using tuning result from %s\n", cache_file.c_str());
+    }
+    dp3m_set_tuned_params(*cached, verbose);
+    return ES_OK;
+  }
+  /* otherwise start from the optimum of the most similar system */
+  auto similar = p3m_tuning_cache_find_similar(cache, cache_key);
+
   /* parameter ranges */
   if (dp3m.params.mesh[0] == 0) {
     double expo;
@@ -1136,6 +1204,20 @@ int dp3m_adaptive_tune(bool verbose) {
     /* avoid using more than 1 GB of FFT arrays (per default, see config.hpp) */
     if (mesh_max > P3M_MAX_MESH)
       mesh_max = P3M_MAX_MESH;
+    /* Start two steps of the mesh loop below the similar system's
+     * optimum, rescaled to the box and by the largest relative
+     * difference that the distance of the systems allows. */
+    if (similar) {
+      auto const scale =
+          box_geo.length()[0] / similar->key.box_l[0] *
+          std::exp(
+              -std::sqrt(p3m_tuning_cache_distance(similar->key, cache_key)));
+      auto const warm_mesh_min =
+          2 * static_cast<int>(similar->result.mesh[0] * scale / 2.) - 4;
+      cold_mesh_min = tmp_mesh;
+      warm_start = warm_mesh_min > tmp_mesh;
+      tmp_mesh = std::max(tmp_mesh, warm_mesh_min);
+    }
   } else {
     tmp_mesh = mesh_max = dp3m.params.mesh[0];
 
@@ -1163,7 +1245,7 @@ int dp3m_adaptive_tune(bool verbose) {
   if (dp3m.params.cao == 0) {
     cao_min = 1;
     cao_max = 7;
-    cao = 3;
+    cao = similar ? similar->result.cao : 3;
   } else {
     cao_min = cao_max = cao = dp3m.params.cao;
 
@@ -1178,34 +1260,59 @@ int dp3m_adaptive_tune(bool verbose) {
   }
 
   /* mesh loop */
-  for (; tmp_mesh <= mesh_max; tmp_mesh += 2) {
-    tmp_cao = cao;
-    tmp_time = dp3m_m_time(tmp_mesh, cao_min, cao_max, &tmp_cao, r_cut_iL_min,
-                           r_cut_iL_max, &tmp_r_cut_iL, &tmp_alpha_L,
-                           &tmp_accuracy, verbose);
-    /* some error occurred during the tuning force evaluation */
-    if (tmp_time == -P3M_TUNE_FAIL || tmp_time == -DP3M_RTBISECTION_ERROR)
-      return ES_ERROR;
-    /* this mesh does not work at all */
-    if (tmp_time < 0)
-      continue;
-
-    /* the optimum r_cut for this mesh is the upper limit for higher meshes,
-       everything else is slower */
-    r_cut_iL_max = tmp_r_cut_iL;
-
-    /* new optimum */
-    if (tmp_time < time_best) {
-      time_best = tmp_time;
-      mesh = tmp_mesh;
-      cao = tmp_cao;
-      r_cut_iL = tmp_r_cut_iL;
-      alpha_L = tmp_alpha_L;
-      accuracy = tmp_accuracy;
+  auto const r_cut_iL_max_start = r_cut_iL_max;
+  auto mesh_min = tmp_mesh;
+  for (;;) {
+    bool best_at_first_mesh = false;
+    for (tmp_mesh = mesh_min; tmp_mesh <= mesh_max; tmp_mesh += 2) {
+      auto const first_mesh = (tmp_mesh == mesh_min);
+      tmp_cao = cao;
+      tmp_time = dp3m_m_time(tmp_mesh, cao_min, cao_max, &tmp_cao, r_cut_iL_min,
+                             r_cut_iL_max, &tmp_r_cut_iL, &tmp_alpha_L,
+                             &tmp_accuracy, verbose);
+      /* some error occurred during the tuning force evaluation */
+      if (tmp_time == -P3M_TUNE_FAIL || tmp_time == -DP3M_RTBISECTION_ERROR)
+        return ES_ERROR;
+      /* this mesh does not work at all */
+      if (tmp_time < 0)
+        continue;
+
+      /* the optimum r_cut for this mesh is the upper limit for higher meshes,
+         everything else is slower */
+      r_cut_iL_max = tmp_r_cut_iL;
+
+      /* new optimum */
+      if (tmp_time < time_best) {
+        best_at_first_mesh = first_mesh;
+        time_best = tmp_time;
+        mesh = tmp_mesh;
+        cao = tmp_cao;
+        r_cut_iL = tmp_r_cut_iL;
+        alpha_L = tmp_alpha_L;
+        accuracy = tmp_accuracy;
+      }
+      /* no hope of further optimisation */
+      else if (tmp_time > time_best + P3M_TIME_GRAN)
+        break;
     }
-    /* no hope of further optimisation */
-    else if (tmp_time > time_best + P3M_TIME_GRAN)
+
+    /* The optimum of the similar system is misleading if the accuracy
+     * was not reached, or if the best mesh is the lowest one of the
+     * window. Then the search is repeated over the full ranges. */
+    auto const retry = similar and (time_best == 1e20 or
+                                    (warm_start and best_at_first_mesh));
+    if (not retry)
       break;
+    if (verbose) {
+      std::printf("repeating the search without the cached result\n");
+    }
+    if (warm_start)
+      mesh_min = cold_mesh_min;
+    similar = boost::none;
+    warm_start = false;
+    r_cut_iL_max = r_cut_iL_max_start;
+    cao = (dp3m.params.cao == 0) ? 3 : dp3m.params.cao;
+    time_best = 1e20;
   }
 
   if (time_best == 1e20) {
@@ -1213,20 +1320,14 @@ int dp3m_adaptive_tune(bool verbose) {
     return ES_ERROR;
   }
 
-  /* set tuned p3m parameters */
-  dp3m.params.r_cut_iL = r_cut_iL;
-  dp3m.params.mesh[0] = dp3m.params.mesh[1] = dp3m.params.mesh[2] = mesh;
-  dp3m.params.cao = cao;
-  dp3m.params.alpha_L = alpha_L;
-  dp3m.params.accuracy = accuracy;
-  /* broadcast tuned p3m parameters */
-  mpi_bcast_coulomb_params();
-  /* Tell the user about the outcome */
-  if (verbose) {
-    std::printf(
-        "\nresulting parameters: mesh: %d, cao: %d, r_cut_iL: %.4e,"
-        "\n                      alpha_L: %.4e, accuracy: %.4e, time: %.0f\n",
-        mesh, cao, r_cut_iL, alpha_L, accuracy, time_best);
+  P3MTuningResult const result = {
+      {mesh, mesh, mesh}, cao, r_cut_iL, alpha_L, accuracy, time_best};
+  dp3m_set_tuned_params(result, verbose);
+
+  if (not cache_file.empty() and
+      not p3m_tuning_cache_write(cache_file, {cache_key, result})) {
+    runtimeWarningMsg() << "could not write the dipolar P3M tuning result to "
+                        << cache_file;
   }
   return ES_OK;
 }
@@ -1429,7 +1530,8 @@ bool dp3m_sanity_checks(const Utils::Vector3i &grid) {
     ret = true;
   }
 
-  if (cell_structure.decomposition_type() != CELL_STRUCTURE_DOMDEC) {
+  if (cell_structure.decomposition_type() != CELL_STRUCTURE_DOMDEC and
+      cell_structure.decomposition_type() != CELL_STRUCTURE_EIGHTH_SHELL) {
     runtimeErrorMsg() << "dipolar P3M at present requires the domain "
                          "decomposition cell system";
     ret = true;
@@ -53,6 +53,7 @@
 
 #include <array>
 #include <cmath>
+#include <string>
 #include <vector>
 
 struct dp3m_data_struct : public p3m_data_struct_base {
@@ -157,11 +158,15 @@ void dp3m_deactivate();
  *  The function is based on routines of the program HE_Q.cpp for charges
  *  written by M. Deserno.
  *
+ *  If @p cache_file is given, the result is looked up there first,
+ *  and new results are added to it, see p3m_adaptive_tune().
+ *
  *  @param verbose printf output
+ *  @param cache_file file of the tuning cache, none if empty
  *  @retval ES_OK
  *  @retval ES_ERROR
  */
-int dp3m_adaptive_tune(bool verbose);
+int dp3m_adaptive_tune(bool verbose, std::string const &cache_file);
 
 /** Compute the k-space part of forces and energies for the magnetic
  *  dipole-dipole interaction
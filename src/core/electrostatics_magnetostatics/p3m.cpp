@@ -30,6 +30,7 @@
 #include "electrostatics_magnetostatics/coulomb.hpp"
 #include "electrostatics_magnetostatics/elc.hpp"
 #include "electrostatics_magnetostatics/p3m_influence_function.hpp"
+#include "electrostatics_magnetostatics/p3m_tuning_cache.hpp"
 
 #include "Particle.hpp"
 #include "ParticleRange.hpp"
@@ -61,11 +62,15 @@
 #include <boost/range/numeric.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <complex>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
+#include <string>
+#include <vector>
 
 using Utils::sinc;
 
@@ -132,6 +137,8 @@ static double p3m_real_space_error(double prefac, double r_cut_iL, int n_c_part,
  *  P3M method in @cite hockney88a (eq. 8-23 p. 275) in
  *  order to obtain the rms error in the force for a system of N
  *  randomly distributed particles in a cubic box (k-space part).
+ *  With analytical differentiation, the corresponding estimate of
+ *  @cite ballenegger12a is used.
  *  \param prefac   Prefactor of Coulomb interaction.
  *  \param mesh     number of mesh points in one direction.
  *  \param cao      charge assignment order.
@@ -149,6 +156,15 @@ static void p3m_tune_aliasing_sums(int nx, int ny, int nz, const int mesh[3],
                                    double alpha_L_i, double *alias1,
                                    double *alias2);
 
+/** Aliasing sums used by \ref p3m_k_space_error for analytical
+ *  differentiation, see @cite ballenegger12a.
+ */
+static void p3m_tune_aliasing_sums_ad(int nx, int ny, int nz,
+                                      const int mesh[3],
+                                      const double mesh_i[3], int cao,
+                                      double alpha_L_i, double *alias1,
+                                      double *alias2, double *alias3);
+
 /**@}*/
 
 p3m_data_struct::p3m_data_struct() {
@@ -162,6 +178,37 @@ p3m_data_struct::p3m_data_struct() {
   ks_pnum = 0;
 }
 
+void p3m_tune_aliasing_sums_ad(int nx, int ny, int nz, const int mesh[3],
+                               const double mesh_i[3], int cao,
+                               double alpha_L_i, double *alias1,
+                               double *alias2, double *alias3) {
+
+  auto const factor1 = Utils::sqr(Utils::pi() * alpha_L_i);
+
+  *alias1 = *alias2 = *alias3 = 0.0;
+  for (int mx = -P3M_BRILLOUIN_AD; mx <= P3M_BRILLOUIN_AD; mx++) {
+    auto const nmx = nx + mx * mesh[0];
+    auto const fnmx = mesh_i[0] * nmx;
+    for (int my = -P3M_BRILLOUIN_AD; my <= P3M_BRILLOUIN_AD; my++) {
+      auto const nmy = ny + my * mesh[1];
+      auto const fnmy = mesh_i[1] * nmy;
+      for (int mz = -P3M_BRILLOUIN_AD; mz <= P3M_BRILLOUIN_AD; mz++) {
+        auto const nmz = nz + mz * mesh[2];
+        auto const fnmz = mesh_i[2] * nmz;
+
+        auto const nm2 = Utils::sqr(nmx) + Utils::sqr(nmy) + Utils::sqr(nmz);
+        auto const ex = exp(-factor1 * nm2);
+
+        auto const U2 = pow(sinc(fnmx) * sinc(fnmy) * sinc(fnmz), 2.0 * cao);
+
+        *alias1 += Utils::sqr(ex) / nm2;
+        *alias2 += U2 * ex;
+        *alias3 += U2 * nm2;
+      }
+    }
+  }
+}
+
 void p3m_init() {
   if (coulomb.prefactor <= 0.0) {
     // prefactor is zero: electrostatics switched off
@@ -193,9 +240,12 @@ void p3m_init() {
                p3m.params.mesh_off, p3m.ks_pnum, p3m.fft, node_grid, comm_cart);
   p3m.rs_mesh.resize(ca_mesh_size);
 
+  /* With analytical differentiation, only the potential is transformed
+     back, otherwise the three components of the electric field. */
   for (auto &e : p3m.E_mesh) {
-    e.resize(ca_mesh_size);
+    e.resize(p3m.params.analytic_diff ? 0 : ca_mesh_size);
   }
+  p3m.phi_mesh.resize(p3m.params.analytic_diff ? ca_mesh_size : 0);
 
   p3m.calc_differential_operator();
 
@@ -292,7 +342,29 @@ int p3m_set_eps(double eps) {
   return ES_OK;
 }
 
+int p3m_set_analytic_diff(bool analytic_diff) {
+  p3m.params.analytic_diff = analytic_diff;
+
+  mpi_bcast_coulomb_params();
+
+  return ES_OK;
+}
+
 namespace {
+/** Add a charge to the rows of the charge assignment mesh. */
+template <size_t cao> struct ChargeRowKernel {
+  double *mesh;
+  double q;
+
+  void operator()(int ind, double w, Utils::Array<double, cao> const &w_z) {
+    auto const qw = q * w;
+    auto row = mesh + ind;
+    for (size_t i = 0; i < cao; i++) {
+      row[i] += qw * w_z[i];
+    }
+  }
+};
+
 template <size_t cao> struct AssignCharge {
   void operator()(double q, const Utils::Vector3d &real_pos,
                   const Utils::Vector3d &ai, p3m_local_mesh const &local_mesh,
@@ -302,16 +374,16 @@ template <size_t cao> struct AssignCharge {
 
     inter_weights.store(w);
 
-    p3m_interpolate(local_mesh, w,
-                    [q](int ind, double w) { p3m.rs_mesh[ind] += w * q; });
+    p3m_interpolate_rows(local_mesh, w,
+                         ChargeRowKernel<cao>{p3m.rs_mesh.data(), q});
   }
 
   void operator()(double q, const Utils::Vector3d &real_pos,
                   const Utils::Vector3d &ai, p3m_local_mesh const &local_mesh) {
-    p3m_interpolate(
+    p3m_interpolate_rows(
         local_mesh,
         p3m_calculate_interpolation_weights<cao>(real_pos, ai, local_mesh),
-        [q](int ind, double w) { p3m.rs_mesh[ind] += w * q; });
+        ChargeRowKernel<cao>{p3m.rs_mesh.data(), q});
   }
 
   void operator()(const ParticleRange &particles) {
@@ -356,6 +428,9 @@ template <size_t cao> struct AssignForces {
 
     assert(cao == p3m.inter_weights.cao());
 
+    std::array<double const *, 3> const E_mesh = {
+        p3m.E_mesh[0].data(), p3m.E_mesh[1].data(), p3m.E_mesh[2].data()};
+
     /* charged particle counter */
     int cp_cnt = 0;
 
@@ -365,13 +440,79 @@ template <size_t cao> struct AssignForces {
         auto const pref = q * force_prefac;
         auto const w = p3m.inter_weights.load<cao>(cp_cnt++);
 
-        Utils::Vector3d E{};
-        p3m_interpolate(p3m.local_mesh, w, [&E](int ind, double w) {
-          E += w * Utils::Vector3d{p3m.E_mesh[0][ind], p3m.E_mesh[1][ind],
-                                   p3m.E_mesh[2][ind]};
-        });
+        double E[3] = {0., 0., 0.};
+        p3m_interpolate_rows(
+            p3m.local_mesh, w,
+            [&E, E_mesh](int ind, double w,
+                         Utils::Array<double, cao> const &w_z) {
+              for (int d = 0; d < 3; d++) {
+                auto const row = E_mesh[d] + ind;
+                double E_row = 0.;
+                for (size_t i = 0; i < cao; i++) {
+                  E_row += w_z[i] * row[i];
+                }
+                E[d] += w * E_row;
+              }
+            });
+
+        p.f.f -= pref * Utils::Vector3d{E[0], E[1], E[2]};
+      }
+    }
+  }
+};
+
+/** Forces from the gradient of the charge assignment function
+ *  and the potential mesh (analytical differentiation). */
+template <size_t cao> struct AssignForcesAD {
+  void operator()(double force_prefac, const ParticleRange &particles) const {
+    assert(cao == p3m.inter_weights.cao());
+
+    auto const phi_mesh = p3m.phi_mesh.data();
+    auto const &local_mesh = p3m.local_mesh;
+
+    /* charged particle counter */
+    int cp_cnt = 0;
 
-        p.f.f -= pref * E;
+    for (auto &p : particles) {
+      auto const q = p.p.q;
+      if (q != 0.0) {
+        auto const w = p3m.inter_weights.load<cao>(cp_cnt++);
+        auto const dw = p3m_calculate_interpolation_derivatives<cao>(
+            p.r.p, p3m.params.ai, local_mesh);
+        assert(w.ind == dw.ind);
+
+        /* The gradient of the assignment function is the derivative
+           in one and the weights in the other two directions. */
+        Utils::Vector3d grad_phi{};
+        auto q_ind = w.ind;
+        for (int i0 = 0; i0 < cao; i0++) {
+          for (int i1 = 0; i1 < cao; i1++) {
+            auto const row = phi_mesh + q_ind;
+            double phi_row = 0., dphi_row = 0.;
+            for (size_t i2 = 0; i2 < cao; i2++) {
+              phi_row += w.w_z[i2] * row[i2];
+              dphi_row += dw.w_z[i2] * row[i2];
+            }
+            grad_phi[0] += dw.w_x[i0] * w.w_y[i1] * phi_row;
+            grad_phi[1] += w.w_x[i0] * dw.w_y[i1] * phi_row;
+            grad_phi[2] += w.w_x[i0] * w.w_y[i1] * dphi_row;
+            q_ind += local_mesh.dim[2];
+          }
+          q_ind += local_mesh.q_21_off;
+        }
+
+        /* subtract the self force, which is periodic in the
+           position relative to the mesh points */
+        auto const &c = p3m.self_force_coeff;
+        Utils::Vector3d self_grad;
+        for (int d = 0; d < 3; d++) {
+          auto const s = 2. * Utils::pi() *
+                         (p.r.p[d] * p3m.params.ai[d] - p3m.params.mesh_off[d]);
+          self_grad[d] = 2. * Utils::pi() * p3m.params.ai[d] *
+                         (c[d] * sin(s) + 2. * c[3 + d] * sin(2. * s));
+        }
+
+        p.f.f -= q * force_prefac * (grad_phi + q * self_grad);
       }
     }
   }
@@ -493,7 +634,27 @@ double p3m_calc_kspace_forces(bool force_flag, bool energy_flag,
                               : boost::none;
 
   /* === k-space force calculation  === */
-  if (force_flag) {
+  if (force_flag and p3m.params.analytic_diff) {
+    /* analytical differentiation: only the potential is needed */
+    for (int i = 0; i < p3m.fft.plan[3].new_size; i++) {
+      p3m.phi_mesh[2 * i + 0] = p3m.g_force[i] * p3m.rs_mesh[2 * i + 0];
+      p3m.phi_mesh[2 * i + 1] = p3m.g_force[i] * p3m.rs_mesh[2 * i + 1];
+    }
+
+    fft_perform_back(p3m.phi_mesh.data(),
+                     /* check_complex */ !p3m.params.tuning, p3m.fft,
+                     comm_cart);
+
+    p3m.sm.spread_grid(p3m.phi_mesh.data(), comm_cart, p3m.local_mesh.dim);
+
+    auto const force_prefac = coulomb.prefactor / box_geo.volume();
+    Utils::integral_parameter<AssignForcesAD, 2, 7>(p3m.params.cao,
+                                                    force_prefac, particles);
+
+    if (p3m.params.epsilon != P3M_EPSILON_METALLIC) {
+      add_dipole_correction(box_dipole.value(), particles);
+    }
+  } else if (force_flag) {
     /* sqrt(-1)*k differentiation */
     int j[3];
     int ind = 0;
@@ -583,8 +744,18 @@ void p3m_calc_influence_function_force() {
   auto const start = Utils::Vector3i{p3m.fft.plan[3].start};
   auto const size = Utils::Vector3i{p3m.fft.plan[3].new_mesh};
 
-  p3m.g_force = grid_influence_function<1>(p3m.params, start, start + size,
-                                           box_geo.length());
+  if (p3m.params.analytic_diff) {
+    p3m.g_force = grid_influence_function_ad<P3M_BRILLOUIN_AD>(
+        p3m.params, start, start + size, box_geo.length());
+    p3m.self_force_coeff = boost::mpi::all_reduce(
+        comm_cart,
+        self_force_coefficients_ad<P3M_BRILLOUIN_AD>(
+            p3m.params, start, start + size, box_geo.length(), p3m.g_force),
+        std::plus<>());
+  } else {
+    p3m.g_force = grid_influence_function<1>(p3m.params, start, start + size,
+                                             box_geo.length());
+  }
 }
 
 void p3m_calc_influence_function_energy() {
@@ -948,7 +1119,68 @@ static double p3m_m_time(const int mesh[3], int cao_min, int cao_max, int *_cao,
   return best_time;
 }
 
-int p3m_adaptive_tune(bool verbose) {
+/** Properties of the current system that the tuning result depends on,
+ *  for the tuning cache. Includes the parameters fixed by the user.
+ */
+static P3MTuningKey p3m_tuning_cache_key() {
+  P3MTuningKey key;
+  key.method = "p3m";
+  if (coulomb.method == COULOMB_P3M_GPU)
+    key.method = "p3m_gpu";
+  key.box_l = box_geo.length();
+  key.node_grid = node_grid;
+  key.n_part = p3m.sum_qpart;
+  key.sum_sq = p3m.sum_q2;
+  key.accuracy = p3m.params.accuracy;
+  key.prefactor = coulomb.prefactor;
+  key.options = {static_cast<double>(p3m.params.mesh[0]),
+                 static_cast<double>(p3m.params.mesh[1]),
+                 static_cast<double>(p3m.params.mesh[2]),
+                 static_cast<double>(p3m.params.cao),
+                 p3m.params.r_cut_iL,
+                 p3m.params.epsilon,
+                 static_cast<double>(p3m.params.analytic_diff),
+                 skin};
+  /* the ELC correction is part of the timed force calculation */
+  if (coulomb.method == COULOMB_ELC_P3M) {
+    key.method = "elc_p3m";
+    key.options.insert(
+        key.options.end(),
+        {elc_params.gap_size, elc_params.maxPWerror, elc_params.far_cut,
+         elc_params.delta_mid_top, elc_params.delta_mid_bot,
+         static_cast<double>(elc_params.const_pot), elc_params.pot_diff,
+         static_cast<double>(elc_params.neutralize)});
+  }
+  return key;
+}
+
+/** Set and broadcast tuned parameters. */
+static void p3m_set_tuned_params(P3MTuningResult const &result,
+                                 bool verbose) {
+  p3m.params.tuning = false;
+  p3m.params.r_cut = result.r_cut_iL * box_geo.length()[0];
+  p3m.params.r_cut_iL = result.r_cut_iL;
+  p3m.params.mesh[0] = result.mesh[0];
+  p3m.params.mesh[1] = result.mesh[1];
+  p3m.params.mesh[2] = result.mesh[2];
+  p3m.params.cao = result.cao;
+  p3m.params.alpha_L = result.alpha_L;
+  p3m.params.alpha = p3m.params.alpha_L * (1. / box_geo.length()[0]);
+  p3m.params.accuracy = result.accuracy;
+  /* broadcast tuned p3m parameters */
+  mpi_bcast_coulomb_params();
+
+  /* Tell the user about the outcome */
+  if (verbose) {
+    std::printf(
+        "\nresulting parameters: mesh: (%d %d %d), cao: %d, r_cut_iL: %.4e,"
+        "\n                      alpha_L: %.4e, accuracy: %.4e, time: %.2f\n",
+        result.mesh[0], result.mesh[1], result.mesh[2], result.cao,
+        result.r_cut_iL, result.alpha_L, result.accuracy, result.time);
+  }
+}
+
+int p3m_adaptive_tune(bool verbose, std::string const &cache_file) {
   double r_cut_iL_min, r_cut_iL_max, r_cut_iL = -1, tmp_r_cut_iL = 0.0;
   int cao_min, cao_max, cao = -1, tmp_cao;
   double alpha_L = -1, tmp_alpha_L = 0.0;
@@ -956,6 +1188,9 @@ int p3m_adaptive_tune(bool verbose) {
   double time_best = 1e20;
   double mesh_density_min, mesh_density_max;
   bool tune_mesh = false; // indicates if mesh should be tuned
+  /* whether the mesh range starts at the optimum of a similar system */
+  bool warm_start = false;
+  double cold_mesh_density_min = 0.;
 
   if (p3m.params.epsilon != P3M_EPSILON_METALLIC) {
     if (!((box_geo.length()[0] == box_geo.length()[1]) &&
@@ -985,6 +1220,20 @@ int p3m_adaptive_tune(bool verbose) {
                 p3m.sum_qpart, p3m.sum_q2);
   }
 
+  auto const cache_key = p3m_tuning_cache_key();
+  auto const cache = cache_file.empty()
+                         ? std::vector<P3MTuningCacheEntry>{}
+                         : p3m_tuning_cache_read(cache_file);
+  if (auto const cached = p3m_tuning_cache_find(cache, cache_key)) {
+    if (verbose) {
+      std::printf("using tuning result from %s\n", cache_file.c_str());
+    }
+    p3m_set_tuned_params(*cached, verbose);
+    return ES_OK;
+  }
+  /* otherwise start from the optimum of the most similar system */
+  auto similar = p3m_tuning_cache_find_similar(cache, cache_key);
+
   /* Activate tuning mode */
   p3m.params.tuning = true;
 
@@ -997,6 +1246,18 @@ int p3m_adaptive_tune(bool verbose) {
     mesh_density_min = pow(p3m.sum_qpart / box_geo.volume(), 1.0 / 3.0);
     mesh_density_max = 512 / pow(box_geo.volume(), 1.0 / 3.0);
     tune_mesh = true;
+    /* Start two steps of the mesh loop below the similar system's
+     * optimum, rescaled by the largest relative difference that the
+     * distance of the systems allows. */
+    if (similar) {
+      auto const density = similar->result.mesh[0] / similar->key.box_l[0];
+      auto const scale = std::exp(
+          -std::sqrt(p3m_tuning_cache_distance(similar->key, cache_key)));
+      auto const density_min = density * scale - 0.2;
+      cold_mesh_density_min = mesh_density_min;
+      warm_start = density_min > mesh_density_min;
+      mesh_density_min = std::max(mesh_density_min, density_min);
+    }
     /* this limits the tried meshes if the accuracy cannot
        be obtained with smaller meshes, but normally not all these
        meshes have to be tested */
@@ -1045,9 +1306,14 @@ int p3m_adaptive_tune(bool verbose) {
   }
 
   if (p3m.params.cao == 0) {
-    cao_min = 1;
+    /* with analytical differentiation, cao 1 has no gradient, and
+       the self force correction is too inaccurate for cao 2 */
+    cao_min = p3m.params.analytic_diff ? 3 : 1;
     cao_max = 7;
     cao = cao_max;
+    if (similar) {
+      cao = std::max(cao_min, std::min(similar->result.cao, cao_max));
+    }
   } else {
     cao_min = cao_max = cao = p3m.params.cao;
 
@@ -1065,61 +1331,86 @@ int p3m_adaptive_tune(bool verbose) {
   /* we're tuning the density of mesh points, which is the same in every
    * direction. */
   int mesh[3] = {0, 0, 0};
-  for (auto mesh_density = mesh_density_min; mesh_density <= mesh_density_max;
-       mesh_density += 0.1) {
-    tmp_cao = cao;
-
-    int tmp_mesh[3];
-    if (tune_mesh) {
-      tmp_mesh[0] =
-          static_cast<int>(std::round(box_geo.length()[0] * mesh_density));
-      tmp_mesh[1] =
-          static_cast<int>(std::round(box_geo.length()[1] * mesh_density));
-      tmp_mesh[2] =
-          static_cast<int>(std::round(box_geo.length()[2] * mesh_density));
-    } else {
-      tmp_mesh[0] = p3m.params.mesh[0];
-      tmp_mesh[1] = p3m.params.mesh[1];
-      tmp_mesh[2] = p3m.params.mesh[2];
-    }
+  auto const r_cut_iL_max_start = r_cut_iL_max;
+  for (;;) {
+    bool best_at_first_mesh = false;
+    for (auto mesh_density = mesh_density_min; mesh_density <= mesh_density_max;
+         mesh_density += 0.1) {
+      auto const first_mesh = (mesh_density == mesh_density_min);
+      tmp_cao = cao;
+
+      int tmp_mesh[3];
+      if (tune_mesh) {
+        tmp_mesh[0] =
+            static_cast<int>(std::round(box_geo.length()[0] * mesh_density));
+        tmp_mesh[1] =
+            static_cast<int>(std::round(box_geo.length()[1] * mesh_density));
+        tmp_mesh[2] =
+            static_cast<int>(std::round(box_geo.length()[2] * mesh_density));
+      } else {
+        tmp_mesh[0] = p3m.params.mesh[0];
+        tmp_mesh[1] = p3m.params.mesh[1];
+        tmp_mesh[2] = p3m.params.mesh[2];
+      }
 
-    if (tmp_mesh[0] % 2) // Make sure that the mesh is even in all directions
-      tmp_mesh[0]++;
-    if (tmp_mesh[1] % 2)
-      tmp_mesh[1]++;
-    if (tmp_mesh[2] % 2)
-      tmp_mesh[2]++;
-
-    auto const tmp_time = p3m_m_time(tmp_mesh, cao_min, cao_max, &tmp_cao,
-                                     r_cut_iL_min, r_cut_iL_max, &tmp_r_cut_iL,
-                                     &tmp_alpha_L, &tmp_accuracy, verbose);
-    /* some error occurred during the tuning force evaluation */
-    if (tmp_time == -P3M_TUNE_FAIL)
-      return ES_ERROR;
-    /* this mesh does not work at all */
-    if (tmp_time < 0.0)
-      continue;
-
-    /* the optimum r_cut for this mesh is the upper limit for higher meshes,
-       everything else is slower */
-    if (coulomb.method == COULOMB_P3M)
-      r_cut_iL_max = tmp_r_cut_iL;
-
-    /* new optimum */
-    if (tmp_time < time_best) {
-      time_best = tmp_time;
-      mesh[0] = tmp_mesh[0];
-      mesh[1] = tmp_mesh[1];
-      mesh[2] = tmp_mesh[2];
-      cao = tmp_cao;
-      r_cut_iL = tmp_r_cut_iL;
-      alpha_L = tmp_alpha_L;
-      accuracy = tmp_accuracy;
+      if (tmp_mesh[0] % 2) // Make sure that the mesh is even in all directions
+        tmp_mesh[0]++;
+      if (tmp_mesh[1] % 2)
+        tmp_mesh[1]++;
+      if (tmp_mesh[2] % 2)
+        tmp_mesh[2]++;
+
+      auto const tmp_time =
+          p3m_m_time(tmp_mesh, cao_min, cao_max, &tmp_cao, r_cut_iL_min,
+                     r_cut_iL_max, &tmp_r_cut_iL, &tmp_alpha_L, &tmp_accuracy,
+                     verbose);
+      /* some error occurred during the tuning force evaluation */
+      if (tmp_time == -P3M_TUNE_FAIL)
+        return ES_ERROR;
+      /* this mesh does not work at all */
+      if (tmp_time < 0.0)
+        continue;
+
+      /* the optimum r_cut for this mesh is the upper limit for higher meshes,
+         everything else is slower */
+      if (coulomb.method == COULOMB_P3M)
+        r_cut_iL_max = tmp_r_cut_iL;
+
+      /* new optimum */
+      if (tmp_time < time_best) {
+        best_at_first_mesh = first_mesh;
+        time_best = tmp_time;
+        mesh[0] = tmp_mesh[0];
+        mesh[1] = tmp_mesh[1];
+        mesh[2] = tmp_mesh[2];
+        cao = tmp_cao;
+        r_cut_iL = tmp_r_cut_iL;
+        alpha_L = tmp_alpha_L;
+        accuracy = tmp_accuracy;
+      }
+      /* no hope of further optimisation */
+      else if (tmp_time > time_best + P3M_TIME_GRAN) {
+        break;
+      }
     }
-    /* no hope of further optimisation */
-    else if (tmp_time > time_best + P3M_TIME_GRAN) {
+
+    /* The optimum of the similar system is misleading if the accuracy
+     * was not reached, or if the best mesh is the lowest one of the
+     * window. Then the search is repeated over the full ranges. */
+    auto const retry = similar and (time_best == 1e20 or
+                                    (warm_start and best_at_first_mesh));
+    if (not retry)
       break;
+    if (verbose) {
+      std::printf("repeating the search without the cached result\n");
     }
+    if (warm_start)
+      mesh_density_min = cold_mesh_density_min;
+    similar = boost::none;
+    warm_start = false;
+    r_cut_iL_max = r_cut_iL_max_start;
+    cao = cao_max;
+    time_best = 1e20;
   }
 
   if (time_best == 1e20) {
@@ -1127,26 +1418,15 @@ int p3m_adaptive_tune(bool verbose) {
     return ES_ERROR;
   }
 
-  /* set tuned p3m parameters */
-  p3m.params.tuning = false;
-  p3m.params.r_cut = r_cut_iL * box_geo.length()[0];
-  p3m.params.r_cut_iL = r_cut_iL;
-  p3m.params.mesh[0] = mesh[0];
-  p3m.params.mesh[1] = mesh[1];
-  p3m.params.mesh[2] = mesh[2];
-  p3m.params.cao = cao;
-  p3m.params.alpha_L = alpha_L;
-  p3m.params.alpha = p3m.params.alpha_L * (1. / box_geo.length()[0]);
-  p3m.params.accuracy = accuracy;
-  /* broadcast tuned p3m parameters */
-  mpi_bcast_coulomb_params();
+  P3MTuningResult const result = {
+      {mesh[0], mesh[1], mesh[2]}, cao, r_cut_iL, alpha_L, accuracy,
+      time_best};
+  p3m_set_tuned_params(result, verbose);
 
-  /* Tell the user about the outcome */
-  if (verbose) {
-    std::printf(
-        "\nresulting parameters: mesh: (%d %d %d), cao: %d, r_cut_iL: %.4e,"
-        "\n                      alpha_L: %.4e, accuracy: %.4e, time: %.2f\n",
-        mesh[0], mesh[1], mesh[2], cao, r_cut_iL, alpha_L, accuracy, time_best);
+  if (not cache_file.empty() and
+      not p3m_tuning_cache_write(cache_file, {cache_key, result})) {
+    runtimeWarningMsg() << "could not write the P3M tuning result to "
+                        << cache_file;
   }
   return ES_OK;
 }
@@ -1195,11 +1475,17 @@ double p3m_k_space_error(double prefac, const int mesh[3], int cao,
           auto const n2 = Utils::sqr(nx) + Utils::sqr(ny) + Utils::sqr(nz);
           auto const cs =
               p3m_analytic_cotangent_sum(nz, mesh_i[2], cao) * ctan_y;
-          double alias1, alias2;
-          p3m_tune_aliasing_sums(nx, ny, nz, mesh, mesh_i, cao, alpha_L_i,
-                                 &alias1, &alias2);
-
-          auto const d = alias1 - Utils::sqr(alias2 / cs) / n2;
+          double alias1, alias2, alias3;
+          double d;
+          if (p3m.params.analytic_diff) {
+            p3m_tune_aliasing_sums_ad(nx, ny, nz, mesh, mesh_i, cao, alpha_L_i,
+                                      &alias1, &alias2, &alias3);
+            d = alias1 - Utils::sqr(alias2) / (cs * alias3);
+          } else {
+            p3m_tune_aliasing_sums(nx, ny, nz, mesh, mesh_i, cao, alpha_L_i,
+                                   &alias1, &alias2);
+            d = alias1 - Utils::sqr(alias2 / cs) / n2;
+          }
           /* at high precision, d can become negative due to extinction;
              also, don't take values that have no significant digits left*/
           if (d > 0 && (fabs(d / alias1) > ROUND_ERROR_PREC))
@@ -1284,7 +1570,8 @@ bool p3m_sanity_checks_system(const Utils::Vector3i &grid) {
     ret = true;
   }
 
-  if (cell_structure.decomposition_type() != CELL_STRUCTURE_DOMDEC) {
+  if (cell_structure.decomposition_type() != CELL_STRUCTURE_DOMDEC and
+      cell_structure.decomposition_type() != CELL_STRUCTURE_EIGHTH_SHELL) {
     runtimeErrorMsg()
         << "P3M at present requires the domain decomposition cell system";
     ret = true;
@@ -1317,6 +1604,11 @@ bool p3m_sanity_checks_parameters() {
     runtimeErrorMsg() << "P3M_init: cao is not yet set";
     ret = true;
   }
+  if (p3m.params.analytic_diff and p3m.params.cao == 1) {
+    runtimeErrorMsg()
+        << "P3M_init: analytical differentiation requires cao >= 2";
+    ret = true;
+  }
   if (p3m.params.alpha < 0.0) {
     runtimeErrorMsg() << "P3M_init: alpha must be >0";
     ret = true;
@@ -51,6 +51,7 @@
 
 #include <array>
 #include <cmath>
+#include <string>
 
 /************************************************
  * data types
@@ -65,6 +66,11 @@ struct p3m_data_struct : public p3m_data_struct_base {
   fft_vector<double> rs_mesh;
   /** mesh (local) for the electric field.*/
   std::array<fft_vector<double>, 3> E_mesh;
+  /** mesh (local) for the potential, with analytical differentiation. */
+  fft_vector<double> phi_mesh;
+  /** amplitudes of the first two harmonics of the self force,
+   *  with analytical differentiation. */
+  Utils::Vector6d self_force_coeff;
 
   /** number of charged particles (only on master node). */
   int sum_qpart;
@@ -118,11 +124,17 @@ extern p3m_data_struct p3m;
  *  The function is based on routines of the program HE_Q.cpp written by M.
  *  Deserno.
  *
+ *  If @p cache_file is given, the result is looked up there first,
+ *  see p3m_tuning_cache.hpp. If there is none for the same system,
+ *  the search starts from the result for the most similar one, and
+ *  the new result is added to the file.
+ *
  *  @param verbose printf output
+ *  @param cache_file file of the tuning cache, none if empty
  *  @retval ES_OK
  *  @retval ES_ERROR
  */
-int p3m_adaptive_tune(bool verbose);
+int p3m_adaptive_tune(bool verbose, std::string const &cache_file);
 
 /** Initialize all structures, parameters and arrays needed for the
  *  P3M algorithm for charge-charge interactions.
@@ -228,6 +240,12 @@ int p3m_set_mesh_offset(double x, double y, double z);
  */
 int p3m_set_eps(double eps);
 
+/** Set @ref P3MParameters::analytic_diff "analytic_diff" parameter
+ *
+ *  @param[in]  analytic_diff  @copybrief P3MParameters::analytic_diff
+ */
+int p3m_set_analytic_diff(bool analytic_diff);
+
 /** Calculate real space contribution of Coulomb pair energy. */
 inline double p3m_pair_energy(double chgfac, double dist) {
   if (dist < p3m.params.r_cut && dist != 0) {
@@ -30,8 +30,11 @@
 
 #include <boost/range/numeric.hpp>
 
+#include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <tuple>
+#include <vector>
 
 namespace detail {
 template <typename T> T g_ewald(T alpha, T k2) {
@@ -56,9 +59,11 @@ std::pair<double, double> aliasing_sums_ik(size_t cao, double alpha,
   double numerator = 0.0;
   double denominator = 0.0;
 
-  for (int mx = -m; mx <= m; mx++) {
-    for (int my = -m; my <= m; my++) {
-      for (int mz = -m; mz <= m; mz++) {
+  auto constexpr m_max = static_cast<int>(m);
+
+  for (int mx = -m_max; mx <= m_max; mx++) {
+    for (int my = -m_max; my <= m_max; my++) {
+      for (int mz = -m_max; mz <= m_max; mz++) {
         auto const km =
             k + two_pi * Vector3d{mx / h[RX], my / h[RY], mz / h[RZ]};
         auto const U2 = std::pow(sinc(km[RX] * h[RX] * two_pi_i) *
@@ -73,6 +78,91 @@ std::pair<double, double> aliasing_sums_ik(size_t cao, double alpha,
   }
   return {numerator, denominator};
 }
+
+template <size_t m>
+std::tuple<double, double, double>
+aliasing_sums_ad(size_t cao, double alpha, const Utils::Vector3d &k,
+                 const Utils::Vector3d &h) {
+  using namespace detail::FFT_indexing;
+  using Utils::sinc;
+  using Utils::Vector3d;
+
+  constexpr double two_pi = 2 * Utils::pi();
+  constexpr double two_pi_i = 1 / two_pi;
+
+  double numerator = 0.0;
+  double sum_U2 = 0.0;
+  double sum_U2_km2 = 0.0;
+
+  auto constexpr m_max = static_cast<int>(m);
+
+  for (int mx = -m_max; mx <= m_max; mx++) {
+    for (int my = -m_max; my <= m_max; my++) {
+      for (int mz = -m_max; mz <= m_max; mz++) {
+        auto const km =
+            k + two_pi * Vector3d{mx / h[RX], my / h[RY], mz / h[RZ]};
+        auto const U2 = std::pow(sinc(km[RX] * h[RX] * two_pi_i) *
+                                     sinc(km[RY] * h[RY] * two_pi_i) *
+                                     sinc(km[RZ] * h[RZ] * two_pi_i),
+                                 2 * cao);
+        auto const km2 = km.norm2();
+
+        numerator += U2 * g_ewald(alpha, km2) * km2;
+        sum_U2 += U2;
+        sum_U2_km2 += U2 * km2;
+      }
+    }
+  }
+  return std::make_tuple(numerator, sum_U2, sum_U2_km2);
+}
+
+/**
+ * @brief Aliasing sums for the self force with analytical differentiation.
+ *
+ * The products of the charge assignment functions of two aliased k
+ * vectors that are @p n Brillouin zones apart in one direction,
+ * summed over the aliasing terms. The sum factorizes into the
+ * directions, so only one-dimensional sums have to be evaluated.
+ *
+ * @return The sums for n = 1 in the first and for n = 2
+ *         in the last three components, one per direction.
+ */
+template <size_t m>
+Utils::Vector6d self_force_sums_ad(size_t cao, const Utils::Vector3d &k,
+                                   const Utils::Vector3d &h) {
+  using Utils::sinc;
+
+  constexpr double two_pi_i = 1 / (2 * Utils::pi());
+  auto constexpr m_max = static_cast<int>(m);
+
+  /* The sign of the assignment function matters here */
+  auto const U = [cao](double x) {
+    return std::pow(sinc(x), static_cast<double>(cao));
+  };
+
+  Utils::Vector3d sum_U2{}, sum_U1{}, sum_U2n{};
+  for (int d = 0; d < 3; d++) {
+    auto const x = k[d] * h[d] * two_pi_i;
+    for (int mi = -m_max; mi <= m_max; mi++) {
+      sum_U2[d] += Utils::sqr(U(x + mi));
+    }
+    /* symmetric around the midpoint of the pairs */
+    for (int mi = -m_max; mi <= m_max + 1; mi++) {
+      sum_U1[d] += U(x + mi) * U(x + mi - 1);
+    }
+    for (int mi = -m_max; mi <= m_max + 2; mi++) {
+      sum_U2n[d] += U(x + mi) * U(x + mi - 2);
+    }
+  }
+
+  Utils::Vector6d ret;
+  for (int d = 0; d < 3; d++) {
+    auto const others = sum_U2[(d + 1) % 3] * sum_U2[(d + 2) % 3];
+    ret[d] = sum_U1[d] * others;
+    ret[3 + d] = sum_U2n[d] * others;
+  }
+  return ret;
+}
 } // namespace detail
 
 /**
@@ -107,26 +197,48 @@ double G_opt(size_t cao, T alpha, const Utils::Vector3<T> &k,
 }
 
 /**
- * @brief Map influence function over a grid.
+ * @brief Optimal influence function for analytical differentiation.
  *
- * This evaluates the optimal influence function @ref G_opt
- * over a regular grid of k vectors, and returns the values as a vector.
+ *  This implements the influence function of @cite ballenegger12a
+ *  that minimizes the force error if the forces are calculated from
+ *  the gradient of the charge assignment function instead of by
+ *  differentiation in k-space.
  *
- * @tparam S Order of the differential operator, e.g. 0 for potential,
- *          1 for electric field...
  * @tparam m Number of aliasing terms to take into account.
+ * @tparam T Floating-point type.
+ *
+ * @param cao Charge assignment order.
+ * @param alpha Ewald splitting parameter.
+ * @param k k Vector to evaluate the function for.
+ * @param h Grid spacing.
+ */
+template <size_t m, class T>
+double G_opt_ad(size_t cao, T alpha, const Utils::Vector3<T> &k,
+                const Utils::Vector3<T> &h) {
+  if (k.norm2() == 0.0) {
+    return 0.0;
+  }
+
+  auto const as = detail::aliasing_sums_ad<m>(cao, alpha, k, h);
+  return std::get<0>(as) / (std::get<1>(as) * std::get<2>(as));
+}
+
+namespace detail {
+/**
+ * @brief Map an influence function over a grid.
  *
  * @param params P3M parameters
  * @param n_start Lower left corner of the grid
  * @param n_end Upper right corner of the grid.
  * @param box_l Box size
- * @return Values of G_opt at regular grid points.
+ * @param G Influence function of the k vector and the grid spacing.
+ * @return Values of @p G at regular grid points.
  */
-template <size_t S, size_t m = 0>
-std::vector<double> grid_influence_function(const P3MParameters &params,
-                                            const Utils::Vector3i &n_start,
-                                            const Utils::Vector3i &n_end,
-                                            const Utils::Vector3d &box_l) {
+template <class InfluenceFunction>
+auto map_influence_function(const P3MParameters &params,
+                            const Utils::Vector3i &n_start,
+                            const Utils::Vector3i &n_end,
+                            const Utils::Vector3d &box_l, InfluenceFunction G) {
   using namespace detail::FFT_indexing;
 
   auto const shifts =
@@ -134,9 +246,11 @@ std::vector<double> grid_influence_function(const P3MParameters &params,
 
   auto const size = n_end - n_start;
 
+  using value_type = decltype(G(Utils::Vector3d{}, Utils::Vector3d{}));
+
   /* The influence function grid */
-  auto g =
-      std::vector<double>(boost::accumulate(size, 1, std::multiplies<>()), 0.);
+  auto g = std::vector<value_type>(
+      boost::accumulate(size, 1, std::multiplies<>()), value_type{});
 
   /* Skip influence function calculation in tuning mode,
      the results need not be correct for timing. */
@@ -155,14 +269,14 @@ std::vector<double> grid_influence_function(const P3MParameters &params,
         if ((n[KX] % (params.mesh[RX] / 2) == 0) &&
             (n[KY] % (params.mesh[RY] / 2) == 0) &&
             (n[KZ] % (params.mesh[RZ] / 2) == 0)) {
-          g[ind] = 0.0;
+          g[ind] = value_type{};
         } else {
           auto const k = 2 * Utils::pi() *
                          Utils::Vector3d{shifts[RX][n[KX]] / box_l[RX],
                                          shifts[RY][n[KY]] / box_l[RY],
                                          shifts[RZ][n[KZ]] / box_l[RZ]};
 
-          g[ind] = G_opt<S, m>(params.cao, params.alpha, k, h);
+          g[ind] = G(k, h);
         }
       }
     }
@@ -170,5 +284,99 @@ std::vector<double> grid_influence_function(const P3MParameters &params,
 
   return g;
 }
+} // namespace detail
+
+/**
+ * @brief Map influence function over a grid.
+ *
+ * This evaluates the optimal influence function @ref G_opt
+ * over a regular grid of k vectors, and returns the values as a vector.
+ *
+ * @tparam S Order of the differential operator, e.g. 0 for potential,
+ *          1 for electric field...
+ * @tparam m Number of aliasing terms to take into account.
+ *
+ * @param params P3M parameters
+ * @param n_start Lower left corner of the grid
+ * @param n_end Upper right corner of the grid.
+ * @param box_l Box size
+ * @return Values of G_opt at regular grid points.
+ */
+template <size_t S, size_t m = 0>
+std::vector<double> grid_influence_function(const P3MParameters &params,
+                                            const Utils::Vector3i &n_start,
+                                            const Utils::Vector3i &n_end,
+                                            const Utils::Vector3d &box_l) {
+  return detail::map_influence_function(
+      params, n_start, n_end, box_l,
+      [&params](Utils::Vector3d const &k, Utils::Vector3d const &h) {
+        return G_opt<S, m>(params.cao, params.alpha, k, h);
+      });
+}
+
+/**
+ * @brief Map influence function for analytical differentiation over a grid.
+ *
+ * Like @ref grid_influence_function, but for @ref G_opt_ad.
+ *
+ * @tparam m Number of aliasing terms to take into account.
+ *
+ * @param params P3M parameters
+ * @param n_start Lower left corner of the grid
+ * @param n_end Upper right corner of the grid.
+ * @param box_l Box size
+ * @return Values of G_opt_ad at regular grid points.
+ */
+template <size_t m>
+std::vector<double> grid_influence_function_ad(const P3MParameters &params,
+                                               const Utils::Vector3i &n_start,
+                                               const Utils::Vector3i &n_end,
+                                               const Utils::Vector3d &box_l) {
+  return detail::map_influence_function(
+      params, n_start, n_end, box_l,
+      [&params](Utils::Vector3d const &k, Utils::Vector3d const &h) {
+        return G_opt_ad<m>(params.cao, params.alpha, k, h);
+      });
+}
+
+/**
+ * @brief Self force coefficients for analytical differentiation.
+ *
+ * With analytical differentiation, a charge feels a force from its own
+ * contribution to the mesh that depends on its position relative to the
+ * mesh points @cite ballenegger12a. This calculates the amplitudes of the
+ * first two harmonics of this force from the influence function, so that
+ * it can be subtracted. The contributions of all k vectors of the grid
+ * have to be summed up.
+ *
+ * @tparam m Number of aliasing terms to take into account.
+ *
+ * @param params P3M parameters
+ * @param n_start Lower left corner of the grid
+ * @param n_end Upper right corner of the grid.
+ * @param box_l Box size
+ * @param g Values of the influence function on the grid.
+ * @return Amplitudes of the first harmonic in the first and of the
+ *         second harmonic in the last three components.
+ */
+template <size_t m>
+Utils::Vector6d self_force_coefficients_ad(const P3MParameters &params,
+                                           const Utils::Vector3i &n_start,
+                                           const Utils::Vector3i &n_end,
+                                           const Utils::Vector3d &box_l,
+                                           std::vector<double> const &g) {
+  auto const sums = detail::map_influence_function(
+      params, n_start, n_end, box_l,
+      [&params](Utils::Vector3d const &k, Utils::Vector3d const &h) {
+        return detail::self_force_sums_ad<m>(params.cao, k, h);
+      });
+
+  assert(sums.size() == g.size());
+  Utils::Vector6d ret{};
+  for (std::size_t i = 0; i < g.size(); i++) {
+    ret += g[i] * sums[i];
+  }
+  return ret;
+}
 
 #endif // ESPRESSO_P3M_INFLUENCE_FUNCTION_HPP
@@ -83,10 +83,9 @@ public:
     assert(cao == m_cao);
 
     ca_fmp.push_back(w.ind);
-    auto it = std::back_inserter(ca_frac);
-    boost::copy(w.w_x, it);
-    boost::copy(w.w_y, it);
-    boost::copy(w.w_z, it);
+    ca_frac.insert(ca_frac.end(), w.w_x.begin(), w.w_x.end());
+    ca_frac.insert(ca_frac.end(), w.w_y.begin(), w.w_y.end());
+    ca_frac.insert(ca_frac.end(), w.w_z.begin(), w.w_z.end());
   }
 
   /**
@@ -129,19 +128,21 @@ public:
   }
 };
 
+namespace detail {
 /**
- * @brief Calculate the P-th order interpolation weights.
+ * @brief Calculate interpolation weights from a spline.
  *
- * As described in from @cite hockney88a 5-189 (or 8-61).
- * The weights are also tabulated in @cite deserno98a @cite deserno98b.
+ * @param spline Function of the point index, the distance to the nearest
+ *        mesh point and the direction that calculates the weight.
  */
-template <int cao>
+template <int cao, class Spline>
 InterpolationWeights<cao>
-p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
-                                    const Utils::Vector3d &ai,
-                                    p3m_local_mesh const &local_mesh) {
+calculate_interpolation_weights(const Utils::Vector3d &position,
+                                const Utils::Vector3d &ai,
+                                p3m_local_mesh const &local_mesh,
+                                Spline spline) {
   /** position shift for calc. of first assignment mesh point. */
-  static auto const pos_shift = std::floor((cao - 1) / 2.0) - (cao % 2) / 2.0;
+  auto const pos_shift = std::floor((cao - 1) / 2.0) - (cao % 2) / 2.0;
 
   /* distance to nearest mesh point */
   Utils::Vector3d dist;
@@ -167,15 +168,49 @@ p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
 
   assert((nmp + Utils::Vector3i::broadcast(cao)) <= local_mesh.dim);
   for (int i = 0; i < cao; i++) {
-    using Utils::bspline;
-
-    ret.w_x[i] = bspline<cao>(i, dist[0]);
-    ret.w_y[i] = bspline<cao>(i, dist[1]);
-    ret.w_z[i] = bspline<cao>(i, dist[2]);
+    ret.w_x[i] = spline(i, dist[0], 0);
+    ret.w_y[i] = spline(i, dist[1], 1);
+    ret.w_z[i] = spline(i, dist[2], 2);
   }
 
   return ret;
 }
+} // namespace detail
+
+/**
+ * @brief Calculate the P-th order interpolation weights.
+ *
+ * As described in from @cite hockney88a 5-189 (or 8-61).
+ * The weights are also tabulated in @cite deserno98a @cite deserno98b.
+ */
+template <int cao>
+InterpolationWeights<cao>
+p3m_calculate_interpolation_weights(const Utils::Vector3d &position,
+                                    const Utils::Vector3d &ai,
+                                    p3m_local_mesh const &local_mesh) {
+  return detail::calculate_interpolation_weights<cao>(
+      position, ai, local_mesh,
+      [](int i, double x, int) { return Utils::bspline<cao>(i, x); });
+}
+
+/**
+ * @brief Calculate the derivatives of the P-th order interpolation weights.
+ *
+ * The weights in every direction are the derivatives of the weights of
+ * @ref p3m_calculate_interpolation_weights with respect to the position
+ * in that direction, as needed for the analytical differentiation
+ * of the charge assignment function.
+ */
+template <int cao>
+InterpolationWeights<cao>
+p3m_calculate_interpolation_derivatives(const Utils::Vector3d &position,
+                                        const Utils::Vector3d &ai,
+                                        p3m_local_mesh const &local_mesh) {
+  return detail::calculate_interpolation_weights<cao>(
+      position, ai, local_mesh, [&ai](int i, double x, int d) {
+        return Utils::bspline_d<cao>(i, x) * ai[d];
+      });
+}
 
 /**
  * @brief P3M grid interpolation.
@@ -207,4 +242,33 @@ void p3m_interpolate(p3m_local_mesh const &local_mesh,
   }
 }
 
+/**
+ * @brief P3M grid interpolation, row by row.
+ *
+ * Like @ref p3m_interpolate, but the kernel is run only once for
+ * every row of @p cao consecutive grid points in z direction, with
+ * the linear grid index of the first point of the row, the product
+ * of the weights in x and y direction, and the weights in z direction
+ * as arguments. Because the order is a compile time constant, the
+ * kernel can process the contiguous points of a row as one vector.
+ *
+ * @param local_mesh Mesh info.
+ * @param weights Set of weights
+ * @param kernel The kernel to run.
+ */
+template <int cao, class Kernel>
+void p3m_interpolate_rows(p3m_local_mesh const &local_mesh,
+                          InterpolationWeights<cao> const &weights,
+                          Kernel kernel) {
+  auto q_ind = weights.ind;
+  for (int i0 = 0; i0 < cao; i0++) {
+    auto const tmp0 = weights.w_x[i0];
+    for (int i1 = 0; i1 < cao; i1++) {
+      kernel(q_ind, tmp0 * weights.w_y[i1], weights.w_z);
+      q_ind += local_mesh.dim[2];
+    }
+    q_ind += local_mesh.q_21_off;
+  }
+}
+
 #endif // ESPRESSO_P3M_INTERPOLATION_HPP
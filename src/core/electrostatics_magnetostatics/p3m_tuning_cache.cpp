@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "electrostatics_magnetostatics/p3m_tuning_cache.hpp"
+
+#include <utils/math/sqr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+/* Line format: method, box_l, node_grid, n_part, sum_sq, accuracy,
+ * prefactor, number of options, options, mesh, cao, r_cut_iL, alpha_L,
+ * accuracy estimate and time, separated by white space. */
+
+namespace {
+/** Relative tolerance for the floating point properties to be equal.
+ *  The values are written with full precision, but sums over the
+ *  particles can differ in the last digits between runs. */
+constexpr double tolerance = 1e-10;
+
+bool close(double a, double b) {
+  return std::abs(a - b) <= tolerance * std::max(std::abs(a), std::abs(b));
+}
+
+bool same_setup(P3MTuningKey const &a, P3MTuningKey const &b) {
+  if (a.method != b.method or a.node_grid != b.node_grid or
+      a.options.size() != b.options.size())
+    return false;
+  for (std::size_t i = 0; i < a.options.size(); i++) {
+    if (not close(a.options[i], b.options[i]))
+      return false;
+  }
+  return close(a.prefactor, b.prefactor);
+}
+
+bool same_system(P3MTuningKey const &a, P3MTuningKey const &b) {
+  for (int i = 0; i < 3; i++) {
+    if (not close(a.box_l[i], b.box_l[i]))
+      return false;
+  }
+  return same_setup(a, b) and a.n_part == b.n_part and
+         close(a.sum_sq, b.sum_sq) and close(a.accuracy, b.accuracy);
+}
+
+double log_ratio2(double a, double b) { return Utils::sqr(std::log(a / b)); }
+
+bool parse(std::string const &line, P3MTuningCacheEntry &entry) {
+  std::istringstream in(line);
+  auto &key = entry.key;
+  auto &result = entry.result;
+  std::size_t n_options;
+
+  in >> key.method >> key.box_l[0] >> key.box_l[1] >> key.box_l[2] >>
+      key.node_grid[0] >> key.node_grid[1] >> key.node_grid[2] >>
+      key.n_part >> key.sum_sq >> key.accuracy >> key.prefactor >> n_options;
+  if (not in or n_options > 64)
+    return false;
+  key.options.resize(n_options);
+  for (auto &option : key.options) {
+    in >> option;
+  }
+  in >> result.mesh[0] >> result.mesh[1] >> result.mesh[2] >> result.cao >>
+      result.r_cut_iL >> result.alpha_L >> result.accuracy >> result.time;
+
+  return static_cast<bool>(in);
+}
+} // namespace
+
+std::vector<P3MTuningCacheEntry>
+p3m_tuning_cache_read(std::string const &filename) {
+  std::vector<P3MTuningCacheEntry> entries;
+  std::ifstream file(filename);
+  std::string line;
+  while (std::getline(file, line)) {
+    P3MTuningCacheEntry entry;
+    if (not line.empty() and line[0] != '#' and parse(line, entry)) {
+      entries.push_back(entry);
+    }
+  }
+
+  return entries;
+}
+
+bool p3m_tuning_cache_write(std::string const &filename,
+                            P3MTuningCacheEntry const &entry) {
+  auto const &key = entry.key;
+  auto const &result = entry.result;
+
+  /* assemble the line first, so that it is appended in one piece */
+  std::ostringstream line;
+  line.precision(std::numeric_limits<double>::max_digits10);
+  line << key.method << ' ' << key.box_l[0] << ' ' << key.box_l[1] << ' '
+       << key.box_l[2] << ' ' << key.node_grid[0] << ' ' << key.node_grid[1]
+       << ' ' << key.node_grid[2] << ' ' << key.n_part << ' ' << key.sum_sq
+       << ' ' << key.accuracy << ' ' << key.prefactor << ' '
+       << key.options.size();
+  for (auto const option : key.options) {
+    line << ' ' << option;
+  }
+  line << ' ' << result.mesh[0] << ' ' << result.mesh[1] << ' '
+       << result.mesh[2] << ' ' << result.cao << ' ' << result.r_cut_iL << ' '
+       << result.alpha_L << ' ' << result.accuracy << ' ' << result.time
+       << '\n';
+
+  std::ofstream file(filename, std::ios::app);
+  file << line.str();
+  file.close();
+
+  return static_cast<bool>(file);
+}
+
+boost::optional<P3MTuningResult>
+p3m_tuning_cache_find(std::vector<P3MTuningCacheEntry> const &entries,
+                      P3MTuningKey const &key) {
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    if (same_system(it->key, key))
+      return it->result;
+  }
+
+  return {};
+}
+
+double p3m_tuning_cache_distance(P3MTuningKey const &a,
+                                 P3MTuningKey const &b) {
+  auto const volume = [](Utils::Vector3d const &l) {
+    return l[0] * l[1] * l[2];
+  };
+  return log_ratio2(volume(a.box_l), volume(b.box_l)) +
+         log_ratio2(a.n_part, b.n_part) + log_ratio2(a.sum_sq, b.sum_sq) +
+         log_ratio2(a.accuracy, b.accuracy);
+}
+
+boost::optional<P3MTuningCacheEntry>
+p3m_tuning_cache_find_similar(std::vector<P3MTuningCacheEntry> const &entries,
+                              P3MTuningKey const &key) {
+  boost::optional<P3MTuningCacheEntry> ret;
+  auto min_distance = std::numeric_limits<double>::infinity();
+  for (auto const &entry : entries) {
+    if (not same_setup(entry.key, key))
+      continue;
+    auto const d = p3m_tuning_cache_distance(entry.key, key);
+    if (d <= min_distance) {
+      min_distance = d;
+      ret = entry;
+    }
+  }
+
+  return ret;
+}
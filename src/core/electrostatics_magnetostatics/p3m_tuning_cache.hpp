@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *  Persistent cache of P3M tuning results.
+ *
+ *  The tuning of the (dipolar) P3M parameters times the force calculation
+ *  for many parameter sets, which takes long for large systems. The results
+ *  are stored in a text file, one per line, together with the properties
+ *  of the system they were obtained for. A run of the same system can then
+ *  reuse them directly, and a run of a similar system can start the search
+ *  from the optimum found for it.
+ *
+ *  The cache is only read and written on the head node.
+ *
+ *  Implementation in p3m_tuning_cache.cpp.
+ */
+
+#ifndef ESPRESSO_P3M_TUNING_CACHE_HPP
+#define ESPRESSO_P3M_TUNING_CACHE_HPP
+
+#include <utils/Vector.hpp>
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+/** Properties of the system the tuning result depends on. */
+struct P3MTuningKey {
+  /** Name of the method, e.g. @c p3m or @c dp3m. */
+  std::string method;
+  /** Box length. */
+  Utils::Vector3d box_l;
+  /** Node grid. */
+  Utils::Vector3i node_grid;
+  /** Number of charged or magnetic particles. */
+  int n_part;
+  /** Sum of the squared charges or dipole moments. */
+  double sum_sq;
+  /** Requested accuracy. */
+  double accuracy;
+  /** Prefactor of the interaction. */
+  double prefactor;
+  /** Further parameters that have to match exactly, like the
+   *  parameters fixed by the user. */
+  std::vector<double> options;
+};
+
+/** Tuned parameters. */
+struct P3MTuningResult {
+  /** Number of mesh points. */
+  Utils::Vector3i mesh;
+  /** Charge assignment order. */
+  int cao;
+  /** Real space cutoff in units of the box length. */
+  double r_cut_iL;
+  /** Ewald splitting parameter in units of the inverse box length. */
+  double alpha_L;
+  /** Accuracy estimate. */
+  double accuracy;
+  /** Time of the force calculation in milliseconds. */
+  double time;
+};
+
+struct P3MTuningCacheEntry {
+  P3MTuningKey key;
+  P3MTuningResult result;
+};
+
+/** Read all entries of a cache file.
+ *  A missing file is an empty cache, malformed lines are skipped.
+ */
+std::vector<P3MTuningCacheEntry>
+p3m_tuning_cache_read(std::string const &filename);
+
+/** Append an entry to a cache file.
+ *  @return Whether the entry could be written.
+ */
+bool p3m_tuning_cache_write(std::string const &filename,
+                            P3MTuningCacheEntry const &entry);
+
+/** Result stored for the same system, the most recent one if there
+ *  are several.
+ */
+boost::optional<P3MTuningResult>
+p3m_tuning_cache_find(std::vector<P3MTuningCacheEntry> const &entries,
+                      P3MTuningKey const &key);
+
+/** Distance between two systems: the sum of the squared logarithms of
+ *  the ratios of the volumes, the numbers of particles, the sums of the
+ *  squared charges and the accuracies.
+ */
+double p3m_tuning_cache_distance(P3MTuningKey const &a,
+                                 P3MTuningKey const &b);
+
+/** Entry of the most similar system with the same method, node grid
+ *  and options, as a starting point for the tuning.
+ *  The similarity is measured by @ref p3m_tuning_cache_distance.
+ */
+boost::optional<P3MTuningCacheEntry>
+p3m_tuning_cache_find_similar(std::vector<P3MTuningCacheEntry> const &entries,
+                              P3MTuningKey const &key);
+
+#endif
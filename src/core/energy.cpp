@@ -81,7 +81,7 @@ void energy_calc(const double time) {
       },
       [](Particle const &p1, Particle const &p2, Distance const &d) {
         add_non_bonded_pair_energy(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
-                                   obs_energy);
+                                   d.excluded, obs_energy);
       },
       maximal_cutoff());
 
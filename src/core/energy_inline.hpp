@@ -69,7 +69,6 @@
 #include "Particle.hpp"
 #include "cells.hpp"
 #include "errorhandling.hpp"
-#include "exclusions.hpp"
 
 #include <utils/Span.hpp>
 #include <utils/Vector.hpp>
@@ -183,17 +182,17 @@ inline double calc_non_bonded_pair_energy(Particle const &p1,
  *  @param d         vector between p1 and p2.
  *  @param dist      distance between p1 and p2.
  *  @param dist2     distance squared between p1 and p2.
+ *  @param excluded  the pair is excluded from the pair potentials.
  *  @param[in,out] obs_energy   energy observable.
  */
 inline void add_non_bonded_pair_energy(Particle const &p1, Particle const &p2,
                                        Utils::Vector3d const &d,
                                        double const dist, double const dist2,
+                                       bool excluded,
                                        Observable_stat &obs_energy) {
   IA_parameters const &ia_params = *get_ia_param(p1.p.type, p2.p.type);
 
-#ifdef EXCLUSIONS
-  if (do_nonbonded(p1, p2))
-#endif
+  if (not excluded)
     obs_energy.add_non_bonded_contribution(
         p1.p.type, p2.p.type,
         calc_non_bonded_pair_energy(p1, p2, ia_params, d, dist));
@@ -43,9 +43,11 @@
 #include "immersed_boundaries.hpp"
 #include "integrate.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "nonbonded_interactions/pair_spline_tables.hpp"
 #include "npt.hpp"
 #include "partCfg_global.hpp"
 #include "particle_data.hpp"
+#include "rattle.hpp"
 #include "thermostat.hpp"
 #include "virtual_sites.hpp"
 
@@ -106,6 +108,7 @@ void on_integration_start() {
   integrator_npt_sanity_checks();
 #endif
   interactions_sanity_checks();
+  cells_sanity_checks();
   lb_lbfluid_on_integration_start();
 
   /********************************************/
@@ -218,6 +221,7 @@ void on_coulomb_change() {
 }
 
 void on_short_range_ia_change() {
+  pair_spline_tables_invalidate();
   cells_re_init(cell_structure.decomposition_type());
 
   recalc_forces = true;
@@ -330,6 +334,9 @@ void on_parameter_change(int field) {
   case FIELD_RIGIDBONDS:
   case FIELD_THERMALIZEDBONDS:
     break;
+  case FIELD_INTEG_SWITCH:
+    /* The forces of the previous integrator may contain multiples of
+     * the long range forces (multiple time stepping) */
   case FIELD_SIMTIME:
     recalc_forces = true;
     break;
@@ -345,6 +352,12 @@ unsigned global_ghost_flags() {
   /* Position and Properties are always requested. */
   unsigned data_parts = Cells::DATA_PART_POSITION | Cells::DATA_PART_PROPERTIES;
 
+  /* The displacements are relative to the positions at the last resort,
+   * which the NpT integrator rescales. The rigid bonds need the old
+   * positions of the ghosts. */
+  if (integ_switch != INTEG_METHOD_NPT_ISO and n_rigidbonds == 0)
+    data_parts |= Cells::DATA_PART_POSITION_DELTA;
+
   if (lattice_switch == ActiveLB::CPU)
     data_parts |= Cells::DATA_PART_MOMENTUM;
 
@@ -34,6 +34,7 @@
 #include "electrostatics_magnetostatics/dipole.hpp"
 #include "electrostatics_magnetostatics/icc.hpp"
 #include "electrostatics_magnetostatics/p3m_gpu.hpp"
+#include "event.hpp"
 #include "forcecap.hpp"
 #include "forces_inline.hpp"
 #include "grid_based_algorithms/electrokinetics.hpp"
@@ -41,15 +42,25 @@
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
 #include "immersed_boundaries.hpp"
 #include "integrate.hpp"
+#include "load_balancing.hpp"
 #include "nonbonded_interactions/VerletCriterion.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "nonbonded_interactions/soa_pair_kernels.hpp"
 #include "npt.hpp"
 #include "short_range_loop.hpp"
 #include "virtual_sites.hpp"
+#include "virtual_sites/VirtualSitesOff.hpp"
 
 #include <profiler/profiler.hpp>
 
+#include <boost/mpi/operations.hpp>
+
+#include <mpi.h>
+
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <vector>
 
 ActorList forceActors;
 
@@ -84,7 +95,38 @@ void init_forces_ghosts(const ParticleRange &particles) {
   }
 }
 
-void force_calc(CellStructure &cell_structure, double time_step) {
+/** Check if the short-range force kernels may run in several threads.
+ *  This is not the case if they collect the NpT virial or
+ *  collision candidates.
+ */
+static bool short_range_forces_thread_safe() {
+#ifdef NPT
+  if (integ_switch == INTEG_METHOD_NPT_ISO)
+    return false;
+#endif
+#ifdef COLLISION_DETECTION
+  if (collision_params.mode != COLLISION_MODE_OFF)
+    return false;
+#endif
+  return true;
+}
+
+/** Check if the forces on the ghosts are complete after the short-range
+ *  loop, so that their reduction can overlap the long-range forces.
+ *  This is not the case if any of the modules that run after it
+ *  adds forces to the ghosts.
+ */
+static bool ghost_forces_complete_after_short_range() {
+#ifdef VIRTUAL_SITES
+  if (not dynamic_cast<VirtualSitesOff const *>(virtual_sites().get()))
+    return false;
+#endif
+  return max_oif_objects == 0 and lattice_switch == ActiveLB::NONE and
+         not immersed_boundaries.volume_conservation_active();
+}
+
+void force_calc(CellStructure &cell_structure, double time_step,
+                LongRangeForceWeights long_range_weights) {
   ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
 
   espressoSystemInterface.update();
@@ -95,7 +137,16 @@ void force_calc(CellStructure &cell_structure, double time_step) {
 
   auto particles = cell_structure.local_particles();
   auto ghost_particles = cell_structure.ghost_particles();
+
+  /* A ghost update started by the integrator is finished in the
+   * short-range loop, after the pairs that need no ghosts. */
+  auto const split_ghost_update = cell_structure.ghosts_pending();
+  auto const split_force_reduction =
+      split_ghost_update and ghost_forces_complete_after_short_range();
+
 #ifdef ELECTROSTATICS
+  if (iccp3m_cfg.n_ic > 0)
+    cell_structure.ghosts_finish();
   iccp3m_iteration(particles, cell_structure.ghost_particles());
 #endif
   init_forces(particles, time_step);
@@ -107,7 +158,8 @@ void force_calc(CellStructure &cell_structure, double time_step) {
 #endif
   }
 
-  calc_long_range_forces(particles);
+  if (not split_force_reduction)
+    calc_long_range_forces(particles, long_range_weights);
 
 #ifdef ELECTROSTATICS
   auto const coulomb_cutoff = Coulomb::cutoff(box_geo.length());
@@ -121,20 +173,74 @@ void force_calc(CellStructure &cell_structure, double time_step) {
   auto const dipole_cutoff = INACTIVE_CUTOFF;
 #endif
 
-  short_range_loop(
-      add_bonded_force,
-      [](Particle &p1, Particle &p2, Distance const &d) {
-        add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
+  auto const verlet_criterion =
+      VerletCriterion{skin, interaction_range(), coulomb_cutoff, dipole_cutoff,
+                      collision_detection_cutoff()};
+
+  auto const long_cutoff_kernel = [](Particle &p1, Particle &p2,
+                                     Distance const &d) {
+    add_long_cutoff_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
 #ifdef COLLISION_DETECTION
-        if (collision_params.mode != COLLISION_MODE_OFF)
-          detect_collision(p1, p2, d.dist2);
+    if (collision_params.mode != COLLISION_MODE_OFF)
+      detect_collision(p1, p2, d.dist2);
 #endif
-      },
-      maximal_cutoff(),
-      VerletCriterion{skin, interaction_range(), coulomb_cutoff, dipole_cutoff,
-                      collision_detection_cutoff()});
+  };
+  auto const thread_safe = short_range_forces_thread_safe();
+  auto const short_range_start = MPI_Wtime();
+
+  if (cell_structure.use_soa_kernels and
+      cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC and
+      soa_pair_forces_applicable(
+          particles, cell_structure.soa_loop_resolves_exclusions())) {
+    cell_structure.ghosts_finish();
+    if (thread_safe)
+      cell_structure.parallel_bond_loop(add_bonded_force);
+    else
+      cell_structure.bond_loop(add_bonded_force);
+    cell_structure.non_bonded_soa_loop(
+        [](auto &... args) { soa_pair_forces(args...); }, verlet_criterion);
+  } else {
+    /* The pair kernel is instantiated for the potentials in use,
+     * so that the others are not branched over for every pair. */
+    update_pair_spline_tables();
+    dispatch_nonbonded_potentials(
+        active_nonbonded_potentials(), pair_spline_tables_active(),
+        [&](auto potentials_constant) {
+          constexpr unsigned potentials = decltype(potentials_constant)::value;
+          auto const pair_kernel = [](Particle &p1, Particle &p2,
+                                      Distance const &d) {
+            add_non_bonded_pair_force<potentials>(
+                p1, p2, d.vec21, sqrt(d.dist2), d.dist2, d.excluded);
+#ifdef COLLISION_DETECTION
+            if (collision_params.mode != COLLISION_MODE_OFF)
+              detect_collision(p1, p2, d.dist2);
+#endif
+          };
+          if (split_ghost_update) {
+            split_short_range_loop(add_bonded_force, pair_kernel,
+                                   long_cutoff_kernel, maximal_cutoff(),
+                                   verlet_criterion, thread_safe);
+          } else if (thread_safe) {
+            parallel_short_range_loop(add_bonded_force, pair_kernel,
+                                      long_cutoff_kernel, maximal_cutoff(),
+                                      verlet_criterion);
+          } else {
+            short_range_loop(add_bonded_force, pair_kernel,
+                             long_cutoff_kernel, maximal_cutoff(),
+                             verlet_criterion);
+          }
+        });
+  }
 
   Constraints::constraints.add_forces(particles, sim_time);
+  load_balancing_add_force_time(MPI_Wtime() - short_range_start);
+
+  /* The ghost forces are sent while the long-range forces,
+   * which only need the real particles, are calculated. */
+  if (split_force_reduction) {
+    cell_structure.ghosts_reduce_forces_begin();
+    calc_long_range_forces(particles, long_range_weights);
+  }
 
   if (max_oif_objects) {
     // There are two global quantities that need to be evaluated:
@@ -167,7 +273,10 @@ void force_calc(CellStructure &cell_structure, double time_step) {
 #endif
 
   // Communication Step: ghost forces
-  cell_structure.ghosts_reduce_forces();
+  if (split_force_reduction)
+    cell_structure.ghosts_finish();
+  else
+    cell_structure.ghosts_reduce_forces();
 
   // should be pretty late, since it needs to zero out the total force
   comfixed.apply(comm_cart, particles);
@@ -179,20 +288,153 @@ void force_calc(CellStructure &cell_structure, double time_step) {
   recalc_forces = false;
 }
 
-void calc_long_range_forces(const ParticleRange &particles) {
-  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+/** Add the forces of @p kernel multiplied by @p weight to the particles.
+ *  The kernel is not called for a weight of zero.
+ */
+template <class Kernel>
+static void add_weighted_forces(const ParticleRange &particles, int weight,
+                                Kernel kernel) {
+  if (weight == 0)
+    return;
+  if (weight == 1) {
+    kernel();
+    return;
+  }
+
+  std::vector<ParticleForce> old_forces;
+  old_forces.reserve(particles.size());
+  for (auto const &p : particles) {
+    old_forces.push_back(p.f);
+  }
+
+  kernel();
+
+  auto old = old_forces.begin();
+  for (auto &p : particles) {
+    p.f.f = old->f + weight * (p.f.f - old->f);
+#ifdef ROTATION
+    p.f.torque = old->torque + weight * (p.f.torque - old->torque);
+#endif
+    ++old;
+  }
+}
+
+/** Add the long range forces of the methods and their corrections. */
+static void add_long_range_forces(const ParticleRange &particles, bool method,
+                                  bool corrections) {
 #ifdef ELECTROSTATICS
   /* calculate k-space part of electrostatic interaction. */
-  Coulomb::calc_long_range_force(particles);
+  Coulomb::calc_long_range_force(particles, method, corrections);
 
 #endif /*ifdef ELECTROSTATICS */
 
 #ifdef DIPOLES
   /* calculate k-space part of the magnetostatic interaction. */
-  Dipole::calc_long_range_force(particles);
+  Dipole::calc_long_range_force(particles, method, corrections);
 #endif /*ifdef DIPOLES */
 }
 
+void calc_long_range_forces(const ParticleRange &particles,
+                            LongRangeForceWeights weights) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+  if (weights.method == weights.corrections) {
+    add_weighted_forces(particles, weights.method, [&particles]() {
+      add_long_range_forces(particles, true, true);
+    });
+  } else {
+    add_weighted_forces(particles, weights.method, [&particles]() {
+      add_long_range_forces(particles, true, false);
+    });
+    add_weighted_forces(particles, weights.corrections, [&particles]() {
+      add_long_range_forces(particles, false, true);
+    });
+  }
+}
+
+/** Short-range forces on the local particles in the current state,
+ *  without the side effects of @ref force_calc: the forces are only
+ *  accumulated in the particles, which the caller has to restore.
+ */
+static std::vector<Utils::Vector3d> short_range_forces() {
+  for (auto &p : cell_structure.local_particles()) {
+    p.f = ParticleForce{};
+  }
+  init_forces_ghosts(cell_structure.ghost_particles());
+
+#ifdef ELECTROSTATICS
+  auto const coulomb_cutoff = Coulomb::cutoff(box_geo.length());
+#else
+  auto const coulomb_cutoff = INACTIVE_CUTOFF;
+#endif
+#ifdef DIPOLES
+  auto const dipole_cutoff = Dipole::cutoff(box_geo.length());
+#else
+  auto const dipole_cutoff = INACTIVE_CUTOFF;
+#endif
+
+  short_range_loop(
+      add_bonded_force,
+      [](Particle &p1, Particle &p2, Distance const &d) {
+        add_non_bonded_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2,
+                                  d.excluded);
+      },
+      [](Particle &p1, Particle &p2, Distance const &d) {
+        add_long_cutoff_pair_force(p1, p2, d.vec21, sqrt(d.dist2), d.dist2);
+      },
+      maximal_cutoff(),
+      VerletCriterion{skin, interaction_range(), coulomb_cutoff,
+                      dipole_cutoff, collision_detection_cutoff()});
+  cell_structure.ghosts_reduce_forces();
+
+  std::vector<Utils::Vector3d> forces;
+  for (auto const &p : cell_structure.local_particles()) {
+    forces.push_back(p.f.f);
+  }
+  return forces;
+}
+
+static double ghost_position_deltas_force_error_local() {
+  std::vector<ParticleForce> saved_forces;
+  for (auto const &p : cell_structure.local_particles()) {
+    saved_forces.push_back(p.f);
+  }
+#ifdef NPT
+  auto const saved_p_vir = nptiso.p_vir;
+#endif
+
+  cells_update_ghosts(global_ghost_flags());
+  auto const forces = short_range_forces();
+
+  /* Again with full precision ghost positions */
+  cell_structure.ghosts_update(Cells::DATA_PART_POSITION);
+  auto const reference_forces = short_range_forces();
+
+  auto error = 0.;
+  for (std::size_t i = 0; i < forces.size(); i++) {
+    error = std::max(error, (forces[i] - reference_forces[i]).norm());
+  }
+
+  auto saved = saved_forces.begin();
+  for (auto &p : cell_structure.local_particles()) {
+    p.f = *saved++;
+  }
+  init_forces_ghosts(cell_structure.ghost_particles());
+#ifdef NPT
+  nptiso.p_vir = saved_p_vir;
+#endif
+
+  return error;
+}
+
+REGISTER_CALLBACK_REDUCTION(ghost_position_deltas_force_error_local,
+                            boost::mpi::maximum<double>())
+
+double mpi_ghost_position_deltas_force_error() {
+  return mpi_call(Communication::Result::reduction,
+                  boost::mpi::maximum<double>(),
+                  ghost_position_deltas_force_error_local);
+}
+
 #ifdef NPT
 void npt_add_virial_force_contribution(const Utils::Vector3d &force,
                                        const Utils::Vector3d &d) {
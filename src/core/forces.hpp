@@ -45,6 +45,18 @@ void init_forces(const ParticleRange &particles, double time_step);
 /** Set forces of all ghosts to zero */
 void init_forces_ghosts(const ParticleRange &particles);
 
+/** Multiples of the long range forces that are added in a force
+ *  calculation. With multiple time stepping they are only calculated
+ *  on some of the steps, and applied as impulses on these; a weight
+ *  of zero skips their calculation.
+ */
+struct LongRangeForceWeights {
+  /** Weight of the forces of the long range methods. */
+  int method = 1;
+  /** Weight of the ELC and MDLC corrections. */
+  int corrections = 1;
+};
+
 /** Calculate forces.
  *
  *  A short list, what the function is doing:
@@ -54,11 +66,29 @@ void init_forces_ghosts(const ParticleRange &particles);
  *  <li> Calculate non-bonded short range interaction forces
  *  <li> Calculate long range interaction forces
  *  </ol>
+ *
+ *  @param cell_structure     Cell structure
+ *  @param time_step          Time step for the thermostat forces
+ *  @param long_range_weights Multiples of the long range forces
  */
-void force_calc(CellStructure &cell_structure, double time_step);
+void force_calc(CellStructure &cell_structure, double time_step,
+                LongRangeForceWeights long_range_weights = {});
 
 /** Calculate long range forces (P3M, ...). */
-void calc_long_range_forces(const ParticleRange &particles);
+void calc_long_range_forces(const ParticleRange &particles,
+                            LongRangeForceWeights weights = {});
+
+/** Largest deviation of the forces on the particles with the ghost
+ *  positions sent as displacements, see
+ *  @ref CellStructure::use_ghost_position_deltas, from the forces
+ *  with full precision ghost positions.
+ *
+ *  Only the short-range forces depend on the ghost positions, they
+ *  are calculated twice in the current state. The forces on the
+ *  particles and the integrator state are left unchanged. Right
+ *  after a resort the deviation is zero.
+ */
+double mpi_ghost_position_deltas_force_error();
 
 #ifdef NPT
 /** Update the NpT virial */
@@ -50,6 +50,7 @@
 #include "nonbonded_interactions/morse.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "nonbonded_interactions/nonbonded_tab.hpp"
+#include "nonbonded_interactions/pair_spline_tables.hpp"
 #include "nonbonded_interactions/smooth_step.hpp"
 #include "nonbonded_interactions/soft_sphere.hpp"
 #include "nonbonded_interactions/thole.hpp"
@@ -73,7 +74,6 @@
 
 #include "Particle.hpp"
 #include "errorhandling.hpp"
-#include "exclusions.hpp"
 #include "rotation.hpp"
 #include "thermostat.hpp"
 #include "thermostats/langevin_inline.hpp"
@@ -84,6 +84,8 @@
 #include <boost/optional.hpp>
 
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 /** Initialize the forces for a ghost particle */
 inline ParticleForce init_ghost_force(Particle const &) { return {}; }
@@ -93,17 +95,17 @@ inline ParticleForce external_force(Particle const &p) {
   ParticleForce f = {};
 
 #ifdef EXTERNAL_FORCES
-  f.f += p.p.ext_force;
+  f.f += p.c.ext_force;
 #ifdef ROTATION
-  f.torque += p.p.ext_torque;
+  f.torque += p.c.ext_torque;
 #endif
 #endif
 
 #ifdef ENGINE
   // apply a swimming force in the direction of
   // the particle's orientation axis
-  if (p.p.swim.swimming) {
-    f.f += p.p.swim.f_swim * p.r.calc_director();
+  if (p.c.swim.swimming) {
+    f.f += p.c.swim.f_swim * p.r.calc_director();
   }
 #endif
 
@@ -133,78 +135,113 @@ inline ParticleForce init_local_particle_force(Particle const &part,
   return thermostat_force(part, time_step) + external_force(part);
 }
 
+/** Calculate the force of the non-bonded pair potentials.
+ *  @tparam potentials  @ref NonBondedPotential flags of the potentials
+ *                      to evaluate, all others are compiled out. With
+ *                      @ref NB_SPLINE_TABLE, the tabulated potentials are
+ *                      taken from the type pair's table where it applies,
+ *                      the other flags are still evaluated analytically.
+ */
+template <unsigned potentials = NB_ALL>
 inline ParticleForce calc_non_bonded_pair_force(Particle const &p1,
                                                 Particle const &p2,
                                                 IA_parameters const &ia_params,
                                                 Utils::Vector3d const &d,
                                                 double const dist) {
+  if (potentials & NB_SPLINE_TABLE) {
+    constexpr unsigned analytic = potentials & ~NB_SPLINE_TABLE;
+    auto const &table = pair_spline_table(ia_params);
+    auto const dist2 = dist * dist;
+    if (dist2 < table.begin()) {
+      return calc_non_bonded_pair_force<analytic>(p1, p2, ia_params, d, dist);
+    }
+    auto pf = calc_non_bonded_pair_force<analytic & ~NB_AUTO_TABULATED>(
+        p1, p2, ia_params, d, dist);
+    pf.f += table(dist2) * d;
+    return pf;
+  }
 
   ParticleForce pf{};
   double force_factor = 0;
 /* Lennard-Jones */
 #ifdef LENNARD_JONES
-  force_factor += lj_pair_force_factor(ia_params, dist);
+  if (potentials & NB_LJ)
+    force_factor += lj_pair_force_factor(ia_params, dist);
 #endif
 /* WCA */
 #ifdef WCA
-  force_factor += wca_pair_force_factor(ia_params, dist);
+  if (potentials & NB_WCA)
+    force_factor += wca_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones generic */
 #ifdef LENNARD_JONES_GENERIC
-  force_factor += ljgen_pair_force_factor(ia_params, dist);
+  if (potentials & NB_LJGEN)
+    force_factor += ljgen_pair_force_factor(ia_params, dist);
 #endif
 /* smooth step */
 #ifdef SMOOTH_STEP
-  force_factor += SmSt_pair_force_factor(ia_params, dist);
+  if (potentials & NB_SMOOTH_STEP)
+    force_factor += SmSt_pair_force_factor(ia_params, dist);
 #endif
 /* Hertzian force */
 #ifdef HERTZIAN
-  force_factor += hertzian_pair_force_factor(ia_params, dist);
+  if (potentials & NB_HERTZIAN)
+    force_factor += hertzian_pair_force_factor(ia_params, dist);
 #endif
 /* Gaussian force */
 #ifdef GAUSSIAN
-  force_factor += gaussian_pair_force_factor(ia_params, dist);
+  if (potentials & NB_GAUSSIAN)
+    force_factor += gaussian_pair_force_factor(ia_params, dist);
 #endif
 /* BMHTF NaCl */
 #ifdef BMHTF_NACL
-  force_factor += BMHTF_pair_force_factor(ia_params, dist);
+  if (potentials & NB_BMHTF)
+    force_factor += BMHTF_pair_force_factor(ia_params, dist);
 #endif
 /* Buckingham*/
 #ifdef BUCKINGHAM
-  force_factor += buck_pair_force_factor(ia_params, dist);
+  if (potentials & NB_BUCKINGHAM)
+    force_factor += buck_pair_force_factor(ia_params, dist);
 #endif
 /* Morse*/
 #ifdef MORSE
-  force_factor += morse_pair_force_factor(ia_params, dist);
+  if (potentials & NB_MORSE)
+    force_factor += morse_pair_force_factor(ia_params, dist);
 #endif
 /*soft-sphere potential*/
 #ifdef SOFT_SPHERE
-  force_factor += soft_pair_force_factor(ia_params, dist);
+  if (potentials & NB_SOFT_SPHERE)
+    force_factor += soft_pair_force_factor(ia_params, dist);
 #endif
 /*hat potential*/
 #ifdef HAT
-  force_factor += hat_pair_force_factor(ia_params, dist);
+  if (potentials & NB_HAT)
+    force_factor += hat_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS
-  force_factor += ljcos_pair_force_factor(ia_params, dist);
+  if (potentials & NB_LJCOS)
+    force_factor += ljcos_pair_force_factor(ia_params, dist);
 #endif
 /* Lennard-Jones cosine */
 #ifdef LJCOS2
-  force_factor += ljcos2_pair_force_factor(ia_params, dist);
+  if (potentials & NB_LJCOS2)
+    force_factor += ljcos2_pair_force_factor(ia_params, dist);
 #endif
 /* Thole damping */
 #ifdef THOLE
-  pf.f += thole_pair_force(p1, p2, ia_params, d, dist);
+  if (potentials & NB_THOLE)
+    pf.f += thole_pair_force(p1, p2, ia_params, d, dist);
 #endif
 /* tabulated */
 #ifdef TABULATED
-  force_factor += tabulated_pair_force_factor(ia_params, dist);
+  if (potentials & NB_TABULATED)
+    force_factor += tabulated_pair_force_factor(ia_params, dist);
 #endif
 /* Gay-Berne */
 #ifdef GAY_BERNE
   // The gb force function isn't inlined, probably due to its size
-  if (dist < ia_params.gay_berne.cut) {
+  if ((potentials & NB_GAY_BERNE) and dist < ia_params.gay_berne.cut) {
     pf += gb_pair_force(p1.r.calc_director(), p2.r.calc_director(), ia_params,
                         d, dist);
   }
@@ -234,10 +271,15 @@ inline ParticleForce calc_opposing_force(ParticleForce const &pf,
  *  @param[in] d        vector between @p p1 and @p p2.
  *  @param dist         distance between @p p1 and @p p2.
  *  @param dist2        distance squared between @p p1 and @p p2.
+ *  @param excluded     the pair is excluded from the pair potentials,
+ *                      see @ref Distance::excluded.
+ *  @tparam potentials  @ref NonBondedPotential flags of the pair
+ *                      potentials to evaluate.
  */
+template <unsigned potentials = NB_ALL>
 inline void add_non_bonded_pair_force(Particle &p1, Particle &p2,
                                       Utils::Vector3d const &d, double dist,
-                                      double dist2) {
+                                      double dist2, bool excluded) {
   IA_parameters const &ia_params = *get_ia_param(p1.p.type, p2.p.type);
   ParticleForce pf{};
 
@@ -245,11 +287,8 @@ inline void add_non_bonded_pair_force(Particle &p1, Particle &p2,
   /* non-bonded pair potentials                  */
   /***********************************************/
 
-  if (dist < ia_params.max_cut) {
-#ifdef EXCLUSIONS
-    if (do_nonbonded(p1, p2))
-#endif
-      pf += calc_non_bonded_pair_force(p1, p2, ia_params, d, dist);
+  if (potentials != NB_NONE and dist < ia_params.max_cut and not excluded) {
+    pf += calc_non_bonded_pair_force<potentials>(p1, p2, ia_params, d, dist);
   }
 
   /***********************************************/
@@ -306,6 +345,106 @@ inline void add_non_bonded_pair_force(Particle &p1, Particle &p2,
   p2.f += calc_opposing_force(pf, d);
 }
 
+/** Sets of @ref NonBondedPotential flags for which the pair kernel is
+ *  specialized, ordered by size: every single potential and a few
+ *  common combinations. The list grows linearly with the number of
+ *  potentials, so that the number of instantiations of the force loop
+ *  stays bounded.
+ */
+using SpecializedNonBondedPotentials = std::integer_sequence<
+    unsigned, NB_NONE, NB_LJ, NB_WCA, NB_LJGEN, NB_SMOOTH_STEP, NB_HERTZIAN,
+    NB_GAUSSIAN, NB_BMHTF, NB_BUCKINGHAM, NB_MORSE, NB_SOFT_SPHERE, NB_HAT,
+    NB_LJCOS, NB_LJCOS2, NB_THOLE, NB_TABULATED, NB_GAY_BERNE, NB_LJ | NB_WCA,
+    NB_LJ | NB_THOLE, NB_WCA | NB_THOLE, NB_LJ | NB_TABULATED,
+    NB_WCA | NB_TABULATED>;
+
+namespace detail {
+template <unsigned flags, class F>
+void dispatch_nonbonded_potentials(unsigned, F &f,
+                                   std::integer_sequence<unsigned>) {
+  f(std::integral_constant<unsigned, NB_ALL | flags>{});
+}
+
+template <unsigned flags, class F, unsigned potentials, unsigned... rest>
+void dispatch_nonbonded_potentials(
+    unsigned active, F &f,
+    std::integer_sequence<unsigned, potentials, rest...>) {
+  if ((active & ~potentials) == 0u) {
+    /* sets without tabulated potentials need no table */
+    f(std::integral_constant<unsigned, (potentials & NB_AUTO_TABULATED)
+                                           ? potentials | flags
+                                           : potentials>{});
+  } else {
+    dispatch_nonbonded_potentials<flags>(
+        active, f, std::integer_sequence<unsigned, rest...>{});
+  }
+}
+} // namespace detail
+
+/** Call @p f with the first of the @ref SpecializedNonBondedPotentials
+ *  that contains @p active, as a compile-time constant. The pair kernels
+ *  instantiated with it skip the branches of all other potentials.
+ *  Combinations without a specialization fall back to @ref NB_ALL.
+ *  With the automatic tables, @ref NB_SPLINE_TABLE is added to the set,
+ *  so that the potentials which are evaluated analytically next to the
+ *  tables are specialized as well.
+ *
+ *  @param active         Potentials in use,
+ *                        see @ref active_nonbonded_potentials.
+ *  @param spline_tables  Whether the automatic tables are used.
+ *  @param f              Callable taking a @c std::integral_constant.
+ */
+template <class F>
+void dispatch_nonbonded_potentials(unsigned active, bool spline_tables, F f) {
+  if (spline_tables and (active & NB_AUTO_TABULATED)) {
+    detail::dispatch_nonbonded_potentials<NB_SPLINE_TABLE>(
+        active, f, SpecializedNonBondedPotentials{});
+  } else {
+    detail::dispatch_nonbonded_potentials<NB_NONE>(
+        active, f, SpecializedNonBondedPotentials{});
+  }
+}
+
+/** Add the non-bonded forces of a pair that is beyond the cutoff of
+ *  the short-range interactions of its particle types, i.e. only the
+ *  real-space electrostatic and magnetostatic forces. Same as
+ *  @ref add_non_bonded_pair_force for such a pair.
+ *
+ *  @param p1        First particle.
+ *  @param p2        Second particle.
+ *  @param d         Vector between @p p1 and @p p2.
+ *  @param dist      Distance between @p p1 and @p p2.
+ *  @param dist2     @p dist squared.
+ */
+inline void add_long_cutoff_pair_force(Particle &p1, Particle &p2,
+                                       Utils::Vector3d const &d, double dist,
+                                       double dist2) {
+  ParticleForce pf{};
+
+#ifdef ELECTROSTATICS
+  {
+    auto const forces = Coulomb::pair_force(p1, p2, d, dist);
+    pf.f += std::get<0>(forces);
+#ifdef P3M
+    // forces from the virtual charges
+    p1.f.f += std::get<1>(forces);
+    p2.f.f += std::get<2>(forces);
+#endif
+  }
+#endif
+
+#ifdef NPT
+  npt_add_virial_force_contribution(pf.f, d);
+#endif
+
+#ifdef DIPOLES
+  pf += Dipole::pair_force(p1, p2, d, dist, dist2);
+#endif
+
+  p1.f += pf;
+  p2.f += calc_opposing_force(pf, d);
+}
+
 /** Compute the bonded interaction force between particle pairs.
  *
  *  @param[in] p1          First particle.
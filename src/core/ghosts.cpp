@@ -40,13 +40,27 @@
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <boost/mpi/request.hpp>
 #include <boost/range/numeric.hpp>
+#include <boost/optional.hpp>
 #include <boost/serialization/vector.hpp>
 
+#include <mpi.h>
+
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 /** Tag for ghosts communications. */
@@ -83,13 +97,49 @@ private:
   std::vector<char> bondbuf; ///< Buffer for bond lists
 };
 
+/** Single precision displacement of a particle from its reference
+ *  position, and its orientation at full precision. The orientation
+ *  has no reference to take a small difference from. */
+struct PositionDelta {
+  Utils::Vector3f displacement;
+#ifdef ROTATION
+  Utils::Quaternion<double> quat;
+#endif
+};
+
+static PositionDelta position_delta(Particle const &p) {
+  PositionDelta delta;
+  auto const displacement = p.r.p - p.l.p_old;
+  for (int i = 0; i < 3; i++) {
+    delta.displacement[i] = static_cast<float>(displacement[i]);
+  }
+#ifdef ROTATION
+  delta.quat = p.r.quat;
+#endif
+  return delta;
+}
+
+static void apply_position_delta(Particle &p, PositionDelta const &delta) {
+  for (int i = 0; i < 3; i++) {
+    p.r.p[i] = p.l.p_old[i] + static_cast<double>(delta.displacement[i]);
+  }
+#ifdef ROTATION
+  p.r.quat = delta.quat;
+#endif
+}
+
 static size_t calc_transmit_size(unsigned data_parts) {
   size_t size = {};
   if (data_parts & GHOSTTRANS_PROPRTS) {
     size += Utils::MemcpyOArchive::packing_size<ParticleProperties>();
+    size += Utils::MemcpyOArchive::packing_size<ParticleColdProperties>();
   }
   if (data_parts & GHOSTTRANS_POSITION)
     size += Utils::MemcpyOArchive::packing_size<ParticlePosition>();
+  if (data_parts & GHOSTTRANS_POSITION_REF)
+    size += Utils::MemcpyOArchive::packing_size<Utils::Vector3d>();
+  if (data_parts & GHOSTTRANS_POSITION_DELTA)
+    size += Utils::MemcpyOArchive::packing_size<PositionDelta>();
   if (data_parts & GHOSTTRANS_MOMENTUM)
     size += Utils::MemcpyOArchive::packing_size<ParticleMomentum>();
   if (data_parts & GHOSTTRANS_FORCE)
@@ -110,20 +160,11 @@ static size_t calc_transmit_size(const GhostCommunication &ghost_comm,
   return n_part * calc_transmit_size(data_parts);
 }
 
-static void prepare_send_buffer(CommBuf &send_buffer,
-                                const GhostCommunication &ghost_comm,
-                                unsigned int data_parts) {
-  /* reallocate send buffer */
-  send_buffer.resize(calc_transmit_size(ghost_comm, data_parts));
-  send_buffer.bonds().clear();
-
-  auto archiver = Utils::MemcpyOArchive{Utils::make_span(send_buffer)};
-
-  /* Construct archive that pushes back to the bond buffer */
-  namespace io = boost::iostreams;
-  io::stream<io::back_insert_device<std::vector<char>>> os{
-      io::back_inserter(send_buffer.bonds())};
-  boost::archive::binary_oarchive bond_archiver{os};
+/** Serialize the fixed-size data of the particles of a communication. */
+static void pack_particle_data(Utils::Span<char> buffer,
+                               const GhostCommunication &ghost_comm,
+                               unsigned int data_parts) {
+  auto archiver = Utils::MemcpyOArchive{buffer};
 
   /* put in data */
   for (auto part_list : ghost_comm.part_lists) {
@@ -134,6 +175,7 @@ static void prepare_send_buffer(CommBuf &send_buffer,
       for (Particle &part : *part_list) {
         if (data_parts & GHOSTTRANS_PROPRTS) {
           archiver << part.p;
+          archiver << part.c;
         }
         if (data_parts & GHOSTTRANS_POSITION) {
           /* ok, this is not nice, but perhaps fast */
@@ -141,20 +183,48 @@ static void prepare_send_buffer(CommBuf &send_buffer,
           pp.p += ghost_comm.shift;
           archiver << pp;
         }
+        if (data_parts & GHOSTTRANS_POSITION_REF) {
+          archiver << Utils::Vector3d{part.l.p_old + ghost_comm.shift};
+        }
+        if (data_parts & GHOSTTRANS_POSITION_DELTA) {
+          archiver << position_delta(part);
+        }
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           archiver << part.m;
         }
         if (data_parts & GHOSTTRANS_FORCE) {
           archiver << part.f;
         }
-        if (data_parts & GHOSTTRANS_BONDS) {
-          bond_archiver << part.bonds();
-        }
       }
     }
   }
 
-  assert(archiver.bytes_written() == send_buffer.size());
+  assert(archiver.bytes_written() == buffer.size());
+}
+
+static void prepare_send_buffer(CommBuf &send_buffer,
+                                const GhostCommunication &ghost_comm,
+                                unsigned int data_parts) {
+  /* reallocate send buffer */
+  send_buffer.resize(calc_transmit_size(ghost_comm, data_parts));
+  send_buffer.bonds().clear();
+
+  pack_particle_data(Utils::make_span(send_buffer), ghost_comm, data_parts);
+
+  if ((data_parts & GHOSTTRANS_BONDS) and
+      not(data_parts & GHOSTTRANS_PARTNUM)) {
+    /* Construct archive that pushes back to the bond buffer */
+    namespace io = boost::iostreams;
+    io::stream<io::back_insert_device<std::vector<char>>> os{
+        io::back_inserter(send_buffer.bonds())};
+    boost::archive::binary_oarchive bond_archiver{os};
+
+    for (auto part_list : ghost_comm.part_lists) {
+      for (Particle &part : *part_list) {
+        bond_archiver << part.bonds();
+      }
+    }
+  }
 }
 
 static void prepare_ghost_cell(ParticleList *cell, int size) {
@@ -176,11 +246,12 @@ static void prepare_recv_buffer(CommBuf &recv_buffer,
   recv_buffer.bonds().clear();
 }
 
-static void put_recv_buffer(CommBuf &recv_buffer,
-                            const GhostCommunication &ghost_comm,
-                            unsigned int data_parts) {
-  /* put back data */
-  auto archiver = Utils::MemcpyIArchive{Utils::make_span(recv_buffer)};
+/** Write back the fixed-size data of the particles of a communication.
+ *  Forces are added up if @p add_forces is set, otherwise overwritten. */
+static void unpack_particle_data(Utils::Span<char> buffer,
+                                 const GhostCommunication &ghost_comm,
+                                 unsigned int data_parts, bool add_forces) {
+  auto archiver = Utils::MemcpyIArchive{buffer};
 
   if (data_parts & GHOSTTRANS_PARTNUM) {
     for (auto part_list : ghost_comm.part_lists) {
@@ -193,48 +264,64 @@ static void put_recv_buffer(CommBuf &recv_buffer,
       for (Particle &part : *part_list) {
         if (data_parts & GHOSTTRANS_PROPRTS) {
           archiver >> part.p;
+          archiver >> part.c;
         }
         if (data_parts & GHOSTTRANS_POSITION) {
           archiver >> part.r;
         }
+        if (data_parts & GHOSTTRANS_POSITION_REF) {
+          archiver >> part.l.p_old;
+        }
+        if (data_parts & GHOSTTRANS_POSITION_DELTA) {
+          PositionDelta delta;
+          archiver >> delta;
+          apply_position_delta(part, delta);
+        }
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           archiver >> part.m;
         }
-        if (data_parts & GHOSTTRANS_FORCE) {
+        if ((data_parts & GHOSTTRANS_FORCE) and add_forces) {
+          ParticleForce pf;
+          archiver >> pf;
+          part.f += pf;
+        } else if (data_parts & GHOSTTRANS_FORCE) {
           archiver >> part.f;
         }
       }
     }
-    if (data_parts & GHOSTTRANS_BONDS) {
-      namespace io = boost::iostreams;
-      io::stream<io::array_source> bond_stream(io::array_source{
-          recv_buffer.bonds().data(), recv_buffer.bonds().size()});
-      boost::archive::binary_iarchive bond_archive(bond_stream);
-
-      for (auto part_list : ghost_comm.part_lists) {
-        for (Particle &part : *part_list) {
-          bond_archive >> part.bonds();
-        }
+  }
+
+  assert(archiver.bytes_read() == buffer.size());
+}
+
+static void put_recv_buffer(CommBuf &recv_buffer,
+                            const GhostCommunication &ghost_comm,
+                            unsigned int data_parts) {
+  /* put back data */
+  unpack_particle_data(Utils::make_span(recv_buffer), ghost_comm,
+                       data_parts & ~GHOSTTRANS_BONDS, false);
+
+  if ((data_parts & GHOSTTRANS_BONDS) and
+      not(data_parts & GHOSTTRANS_PARTNUM)) {
+    namespace io = boost::iostreams;
+    io::stream<io::array_source> bond_stream(io::array_source{
+        recv_buffer.bonds().data(), recv_buffer.bonds().size()});
+    boost::archive::binary_iarchive bond_archive(bond_stream);
+
+    for (auto part_list : ghost_comm.part_lists) {
+      for (Particle &part : *part_list) {
+        bond_archive >> part.bonds();
       }
     }
   }
 
-  assert(archiver.bytes_read() == recv_buffer.size());
-
   recv_buffer.bonds().clear();
 }
 
 static void add_forces_from_recv_buffer(CommBuf &recv_buffer,
                                         const GhostCommunication &ghost_comm) {
-  /* put back data */
-  auto archiver = Utils::MemcpyIArchive{Utils::make_span(recv_buffer)};
-  for (auto &part_list : ghost_comm.part_lists) {
-    for (Particle &part : *part_list) {
-      ParticleForce pf;
-      archiver >> pf;
-      part.f += pf;
-    }
-  }
+  unpack_particle_data(Utils::make_span(recv_buffer), ghost_comm,
+                       GHOSTTRANS_FORCE, true);
 }
 
 static void cell_cell_transfer(const GhostCommunication &ghost_comm,
@@ -258,15 +345,21 @@ static void cell_cell_transfer(const GhostCommunication &ghost_comm,
 
         if (data_parts & GHOSTTRANS_PROPRTS) {
           part2.p = part1.p;
+          part2.c = part1.c;
         }
         if (data_parts & GHOSTTRANS_BONDS) {
           part2.bonds() = part1.bonds();
         }
-        if (data_parts & GHOSTTRANS_POSITION) {
+        /* Local copies need no compression, so the displacements
+         * are transferred as full positions. */
+        if (data_parts & (GHOSTTRANS_POSITION | GHOSTTRANS_POSITION_DELTA)) {
           /* ok, this is not nice, but perhaps fast */
           part2.r = part1.r;
           part2.r.p += ghost_comm.shift;
         }
+        if (data_parts & GHOSTTRANS_POSITION_REF) {
+          part2.l.p_old = part1.l.p_old + ghost_comm.shift;
+        }
         if (data_parts & GHOSTTRANS_MOMENTUM) {
           part2.m = part1.m;
         }
@@ -304,10 +397,436 @@ static bool is_poststorable(GhostCommunication const &ghost_comm,
   return is_recv_op(comm_type, node, this_node) && poststore;
 }
 
+void make_neighbor_stages(GhostCommunicator &gcr,
+                          std::vector<std::size_t> const &stage_sizes) {
+  gcr.neighbor_stages.clear();
+
+  std::size_t first = 0;
+  for (auto const size : stage_sizes) {
+    GhostNeighborStage stage;
+    stage.first = first;
+    stage.last = first + size;
+
+    std::vector<int> sources, destinations;
+    for (auto i = stage.first; i < stage.last; i++) {
+      auto const &ghost_comm = gcr.communications[i];
+      auto const comm_type = ghost_comm.type & GHOST_JOBMASK;
+      assert(comm_type == GHOST_SEND or comm_type == GHOST_RECV or
+             comm_type == GHOST_LOCL);
+      if (comm_type == GHOST_SEND)
+        destinations.push_back(ghost_comm.node);
+      else if (comm_type == GHOST_RECV)
+        sources.push_back(ghost_comm.node);
+    }
+
+    stage.exchange = boost::mpi::all_reduce(
+        gcr.mpi_comm, not(sources.empty() and destinations.empty()),
+        std::logical_or<bool>());
+    if (stage.exchange) {
+      MPI_Comm graph_comm;
+      MPI_Dist_graph_create_adjacent(
+          gcr.mpi_comm, static_cast<int>(sources.size()), sources.data(),
+          MPI_UNWEIGHTED, static_cast<int>(destinations.size()),
+          destinations.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &graph_comm);
+      stage.graph_comm = boost::mpi::communicator(
+          graph_comm, boost::mpi::comm_take_ownership);
+    }
+
+    gcr.neighbor_stages.push_back(std::move(stage));
+    first += size;
+  }
+  assert(first == gcr.communications.size());
+}
+
+/** Can the neighborhood collectives be used for the data parts? */
+static bool use_neighbor_stages(const GhostCommunicator &gcr,
+                                unsigned int data_parts) {
+  return not gcr.neighbor_stages.empty() and
+         not(data_parts & GHOSTTRANS_BONDS);
+}
+
+/** Pack the messages and do the local transfers of a stage. */
+static void prepare_neighbor_stage(const GhostCommunicator &gcr,
+                                   const GhostNeighborStage &stage,
+                                   unsigned int data_parts) {
+  auto &buffers = stage.buffers;
+  buffers.send_counts.clear();
+  buffers.send_displs.clear();
+  buffers.recv_counts.clear();
+  buffers.recv_displs.clear();
+
+  int send_size = 0, recv_size = 0;
+  for (auto i = stage.first; i < stage.last; i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    auto const size =
+        static_cast<int>(calc_transmit_size(ghost_comm, data_parts));
+    switch (ghost_comm.type & GHOST_JOBMASK) {
+    case GHOST_SEND:
+      buffers.send_displs.push_back(send_size);
+      buffers.send_counts.push_back(size);
+      send_size += size;
+      break;
+    case GHOST_RECV:
+      buffers.recv_displs.push_back(recv_size);
+      buffers.recv_counts.push_back(size);
+      recv_size += size;
+      break;
+    }
+  }
+  buffers.send.resize(send_size);
+  buffers.recv.resize(recv_size);
+
+  std::size_t n_sends = 0;
+  for (auto i = stage.first; i < stage.last; i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    switch (ghost_comm.type & GHOST_JOBMASK) {
+    case GHOST_SEND:
+      pack_particle_data(
+          Utils::Span<char>(buffers.send.data() + buffers.send_displs[n_sends],
+                            buffers.send_counts[n_sends]),
+          ghost_comm, data_parts);
+      n_sends++;
+      break;
+    case GHOST_LOCL:
+      cell_cell_transfer(ghost_comm, data_parts);
+      break;
+    }
+  }
+}
+
+/** Write back the received messages of a stage. */
+static void finish_neighbor_stage(const GhostCommunicator &gcr,
+                                  const GhostNeighborStage &stage,
+                                  unsigned int data_parts) {
+  auto &buffers = stage.buffers;
+  std::size_t n_recvs = 0;
+  for (auto i = stage.first; i < stage.last; i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    if ((ghost_comm.type & GHOST_JOBMASK) == GHOST_RECV) {
+      unpack_particle_data(
+          Utils::Span<char>(buffers.recv.data() + buffers.recv_displs[n_recvs],
+                            buffers.recv_counts[n_recvs]),
+          ghost_comm, data_parts, data_parts == GHOSTTRANS_FORCE);
+      n_recvs++;
+    }
+  }
+}
+
+static void neighbor_stage_communicator(const GhostCommunicator &gcr,
+                                        std::size_t first_stage,
+                                        unsigned int data_parts) {
+  for (auto s = first_stage; s < gcr.neighbor_stages.size(); s++) {
+    auto const &stage = gcr.neighbor_stages[s];
+    auto &buffers = stage.buffers;
+
+    prepare_neighbor_stage(gcr, stage, data_parts);
+    if (stage.exchange) {
+      MPI_Neighbor_alltoallv(
+          buffers.send.data(), buffers.send_counts.data(),
+          buffers.send_displs.data(), MPI_BYTE, buffers.recv.data(),
+          buffers.recv_counts.data(), buffers.recv_displs.data(), MPI_BYTE,
+          stage.graph_comm);
+    }
+    finish_neighbor_stage(gcr, stage, data_parts);
+  }
+}
+
+/** Can the communication be done by non-blocking point-to-point
+ *  messages? Every node has to come to the same conclusion. */
+static bool is_splittable(const GhostCommunicator &gcr,
+                          unsigned int data_parts) {
+  if (data_parts & (GHOSTTRANS_PARTNUM | GHOSTTRANS_BONDS))
+    return false;
+
+  return std::all_of(gcr.communications.begin(), gcr.communications.end(),
+                     [](GhostCommunication const &ghost_comm) {
+                       auto const comm_type = ghost_comm.type & GHOST_JOBMASK;
+                       return comm_type == GHOST_SEND or
+                              comm_type == GHOST_RECV or
+                              comm_type == GHOST_LOCL;
+                     });
+}
+
+/** Header of a message in the shared memory, on its own cache line */
+struct alignas(64) SharedMessageHeader {
+  /** Number of messages written by the sender */
+  std::atomic<long> ready;
+  /** Number of messages read by the receiver */
+  std::atomic<long> done;
+};
+
+static_assert(ATOMIC_LONG_LOCK_FREE == 2,
+              "Shared-memory ghosts need address-free atomics.");
+
+struct GhostSharedMemory {
+  /** Nodes of the communicator on the same host */
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Win win = MPI_WIN_NULL;
+
+  /** Message of a send or receive to a node on the same host */
+  struct Message {
+    /** Rank of the partner in @ref node_comm */
+    int node_rank = MPI_UNDEFINED;
+    /** Offset in the window part of the sender */
+    std::size_t offset = 0;
+    /** Size of the payload */
+    std::size_t capacity = 0;
+    SharedMessageHeader *header = nullptr;
+    char *data = nullptr;
+    /** Number of messages sent or received */
+    long count = 0;
+  };
+  /** By communication, for all others @ref Message::node_rank
+   *  is undefined */
+  std::vector<Message> messages;
+
+  ~GhostSharedMemory() {
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (finalized)
+      return;
+    if (win != MPI_WIN_NULL) {
+      MPI_Win_unlock_all(win);
+      MPI_Win_free(&win);
+    }
+    if (node_comm != MPI_COMM_NULL)
+      MPI_Comm_free(&node_comm);
+  }
+};
+
+static std::size_t n_particles(const GhostCommunication &ghost_comm) {
+  return boost::accumulate(
+      ghost_comm.part_lists, std::size_t{0},
+      [](std::size_t sum, auto part_list) { return sum + part_list->size(); });
+}
+
+/** Size of the largest fixed-size data of a particle */
+static std::size_t max_transmit_size() {
+  return calc_transmit_size(GHOSTTRANS_PROPRTS | GHOSTTRANS_POSITION |
+                            GHOSTTRANS_POSITION_DELTA |
+                            GHOSTTRANS_POSITION_REF | GHOSTTRANS_MOMENTUM |
+                            GHOSTTRANS_FORCE);
+}
+
+static std::size_t cache_lines(std::size_t size) {
+  return sizeof(SharedMessageHeader) *
+         ((size + sizeof(SharedMessageHeader) - 1) /
+          sizeof(SharedMessageHeader));
+}
+
+/** Allocate the window with room for the messages of the current cell
+ *  sizes and some slack, and tell the receivers where to find them. */
+static void allocate_shared_memory(const GhostCommunicator &gcr,
+                                   GhostSharedMemory &shm) {
+  if (shm.win != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(shm.win);
+    MPI_Win_free(&shm.win);
+  }
+
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < gcr.communications.size(); i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    auto &message = shm.messages[i];
+    message.count = 0;
+    if (message.node_rank == MPI_UNDEFINED or
+        (ghost_comm.type & GHOST_JOBMASK) != GHOST_SEND)
+      continue;
+
+    auto const n_part = n_particles(ghost_comm);
+    message.offset = size;
+    message.capacity = cache_lines((n_part + n_part / 4) * max_transmit_size());
+    size += sizeof(SharedMessageHeader) + message.capacity;
+  }
+
+  /* The window is not necessarily aligned to the cache lines */
+  auto constexpr alignment = alignof(SharedMessageHeader);
+  char *base;
+  MPI_Win_allocate_shared(static_cast<MPI_Aint>(size + alignment), 1,
+                          MPI_INFO_NULL, shm.node_comm, &base, &shm.win);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, shm.win);
+  auto const padding =
+      (alignment - reinterpret_cast<std::uintptr_t>(base) % alignment) %
+      alignment;
+
+  /* Tell the receivers the places of their messages. Between two
+   * nodes, the messages are matched in the order of the plan. */
+  auto const &comm = gcr.mpi_comm;
+  std::vector<std::array<std::size_t, 2>> places;
+  places.reserve(gcr.communications.size());
+  std::vector<boost::mpi::request> requests;
+  for (std::size_t i = 0; i < gcr.communications.size(); i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    auto &message = shm.messages[i];
+    if (message.node_rank != MPI_UNDEFINED and
+        (ghost_comm.type & GHOST_JOBMASK) == GHOST_SEND) {
+      message.offset += padding;
+      message.header = new (base + message.offset) SharedMessageHeader{};
+      message.header->ready.store(0);
+      message.header->done.store(0);
+      message.data = base + message.offset + sizeof(SharedMessageHeader);
+
+      places.push_back({message.offset, message.capacity});
+      requests.push_back(comm.isend(ghost_comm.node, REQ_GHOST_SEND,
+                                    places.back().data(), 2));
+    }
+  }
+  for (std::size_t i = 0; i < gcr.communications.size(); i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    auto &message = shm.messages[i];
+    if (message.node_rank != MPI_UNDEFINED and
+        (ghost_comm.type & GHOST_JOBMASK) == GHOST_RECV) {
+      std::size_t place[2];
+      comm.recv(ghost_comm.node, REQ_GHOST_SEND, place, 2);
+      message.offset = place[0];
+      message.capacity = place[1];
+
+      MPI_Aint win_size;
+      int disp_unit;
+      char *partner_base;
+      MPI_Win_shared_query(shm.win, message.node_rank, &win_size, &disp_unit,
+                           &partner_base);
+      message.header =
+          reinterpret_cast<SharedMessageHeader *>(partner_base + place[0]);
+      message.data = partner_base + place[0] + sizeof(SharedMessageHeader);
+    }
+  }
+  boost::mpi::wait_all(requests.begin(), requests.end());
+
+  /* The headers are initialized before anybody uses them */
+  MPI_Win_sync(shm.win);
+  MPI_Barrier(shm.node_comm);
+  MPI_Win_sync(shm.win);
+}
+
+void make_shared_memory(GhostCommunicator &gcr) {
+  auto shm = std::make_shared<GhostSharedMemory>();
+  MPI_Comm_split_type(gcr.mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                      &shm->node_comm);
+
+  MPI_Group comm_group, node_group;
+  MPI_Comm_group(gcr.mpi_comm, &comm_group);
+  MPI_Comm_group(shm->node_comm, &node_group);
+
+  shm->messages.resize(gcr.communications.size());
+  for (std::size_t i = 0; i < gcr.communications.size(); i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    auto const comm_type = ghost_comm.type & GHOST_JOBMASK;
+    if (comm_type == GHOST_SEND or comm_type == GHOST_RECV) {
+      MPI_Group_translate_ranks(comm_group, 1, &ghost_comm.node, node_group,
+                                &shm->messages[i].node_rank);
+    }
+  }
+  MPI_Group_free(&node_group);
+  MPI_Group_free(&comm_group);
+
+  allocate_shared_memory(gcr, *shm);
+  gcr.shared_memory = std::move(shm);
+}
+
+void update_shared_memory(const GhostCommunicator &gcr) {
+  if (not gcr.shared_memory)
+    return;
+
+  auto &shm = *gcr.shared_memory;
+  auto fits = true;
+  for (std::size_t i = 0; i < gcr.communications.size(); i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    auto const &message = shm.messages[i];
+    if (message.node_rank != MPI_UNDEFINED and
+        (ghost_comm.type & GHOST_JOBMASK) == GHOST_SEND) {
+      fits &= n_particles(ghost_comm) * max_transmit_size() <=
+              message.capacity;
+    }
+  }
+
+  /* All nodes on a host have to take part in the allocation */
+  if (not boost::mpi::all_reduce(
+          boost::mpi::communicator(shm.node_comm, boost::mpi::comm_attach),
+          fits, std::logical_and<bool>()))
+    allocate_shared_memory(gcr, shm);
+}
+
+static void wait_for(std::atomic<long> const &counter, long value) {
+  while (counter.load(std::memory_order_acquire) != value) {
+    std::this_thread::yield();
+  }
+}
+
+/** Ghost communication with shared memory for the messages to the
+ *  nodes on the same host, and blocking point-to-point messages
+ *  for all others. */
+static void shared_memory_communicator(const GhostCommunicator &gcr,
+                                       unsigned int data_parts) {
+  static CommBuf buffer;
+
+  auto &shm = *gcr.shared_memory;
+  auto const &comm = gcr.mpi_comm;
+
+  for (std::size_t i = 0; i < gcr.communications.size(); i++) {
+    auto const &ghost_comm = gcr.communications[i];
+    auto &message = shm.messages[i];
+    auto const size = calc_transmit_size(ghost_comm, data_parts);
+    /* Both partners know the size and the capacity of a message */
+    auto const shared =
+        message.node_rank != MPI_UNDEFINED and size <= message.capacity;
+
+    switch (ghost_comm.type & GHOST_JOBMASK) {
+    case GHOST_LOCL:
+      cell_cell_transfer(ghost_comm, data_parts);
+      break;
+    case GHOST_SEND:
+      if (shared) {
+        /* The previous message has to be read before it is replaced */
+        wait_for(message.header->done, message.count);
+        pack_particle_data(Utils::Span<char>(message.data, size), ghost_comm,
+                           data_parts);
+        message.header->ready.store(++message.count,
+                                    std::memory_order_release);
+      } else {
+        prepare_send_buffer(buffer, ghost_comm, data_parts);
+        comm.send(ghost_comm.node, REQ_GHOST_SEND, buffer.data(),
+                  buffer.size());
+        comm.send(ghost_comm.node, REQ_GHOST_SEND, buffer.bonds());
+      }
+      break;
+    case GHOST_RECV:
+      if (shared) {
+        wait_for(message.header->ready, ++message.count);
+        unpack_particle_data(Utils::Span<char>(message.data, size),
+                             ghost_comm, data_parts,
+                             data_parts == GHOSTTRANS_FORCE);
+        message.header->done.store(message.count, std::memory_order_release);
+      } else {
+        prepare_recv_buffer(buffer, ghost_comm, data_parts);
+        comm.recv(ghost_comm.node, REQ_GHOST_SEND, buffer.data(),
+                  buffer.size());
+        comm.recv(ghost_comm.node, REQ_GHOST_SEND, buffer.bonds());
+        if (data_parts == GHOSTTRANS_FORCE)
+          add_forces_from_recv_buffer(buffer, ghost_comm);
+        else
+          put_recv_buffer(buffer, ghost_comm, data_parts);
+      }
+      break;
+    }
+  }
+}
+
 void ghost_communicator(const GhostCommunicator &gcr, unsigned int data_parts) {
+  ghost_communicator_finish();
+
   if (GHOSTTRANS_NONE == data_parts)
     return;
 
+  if (use_neighbor_stages(gcr, data_parts)) {
+    neighbor_stage_communicator(gcr, 0, data_parts);
+    return;
+  }
+
+  if (gcr.shared_memory and is_splittable(gcr, data_parts)) {
+    shared_memory_communicator(gcr, data_parts);
+    return;
+  }
+
   static CommBuf send_buffer, recv_buffer;
 
   auto const &comm = gcr.mpi_comm;
@@ -421,3 +940,165 @@ void ghost_communicator(const GhostCommunicator &gcr, unsigned int data_parts) {
     }
   }
 }
+
+namespace {
+/** State of a communication started by @ref ghost_communicator_begin. */
+struct SplitCommunication {
+  const GhostCommunicator *gcr = nullptr;
+  unsigned int data_parts = GHOSTTRANS_NONE;
+  /** Index of the first communication that was not started yet */
+  std::size_t next = 0;
+  /** Buffer of every communication */
+  std::vector<CommBuf> buffers;
+  /** Receive request of every communication, if it is a receive */
+  std::vector<boost::mpi::request> recv_requests;
+  std::vector<boost::mpi::request> send_requests;
+  /** Neighbor stage in flight, if the communicator uses
+   *  neighborhood collectives */
+  boost::optional<std::size_t> stage;
+  MPI_Request stage_request = MPI_REQUEST_NULL;
+};
+
+SplitCommunication split_comm;
+} // namespace
+
+/** Start a send or local transfer of the split communication. */
+static void start_split_communication(std::size_t i) {
+  auto const &ghost_comm = split_comm.gcr->communications[i];
+  auto const data_parts = split_comm.data_parts;
+
+  switch (ghost_comm.type & GHOST_JOBMASK) {
+  case GHOST_LOCL:
+    cell_cell_transfer(ghost_comm, data_parts);
+    break;
+  case GHOST_SEND: {
+    auto &send_buffer = split_comm.buffers[i];
+    prepare_send_buffer(send_buffer, ghost_comm, data_parts);
+    split_comm.send_requests.push_back(split_comm.gcr->mpi_comm.isend(
+        ghost_comm.node, REQ_GHOST_SEND, send_buffer.data(),
+        static_cast<int>(send_buffer.size())));
+    break;
+  }
+  }
+}
+
+void ghost_communicator_begin(const GhostCommunicator &gcr,
+                              unsigned int data_parts) {
+  ghost_communicator_finish();
+
+  if (GHOSTTRANS_NONE == data_parts)
+    return;
+
+  if (use_neighbor_stages(gcr, data_parts)) {
+    /* Start the first stage that exchanges messages */
+    for (std::size_t s = 0; s < gcr.neighbor_stages.size(); s++) {
+      auto const &stage = gcr.neighbor_stages[s];
+      auto &buffers = stage.buffers;
+
+      prepare_neighbor_stage(gcr, stage, data_parts);
+      if (stage.exchange) {
+        MPI_Ineighbor_alltoallv(
+            buffers.send.data(), buffers.send_counts.data(),
+            buffers.send_displs.data(), MPI_BYTE, buffers.recv.data(),
+            buffers.recv_counts.data(), buffers.recv_displs.data(), MPI_BYTE,
+            stage.graph_comm, &split_comm.stage_request);
+        split_comm.gcr = &gcr;
+        split_comm.data_parts = data_parts;
+        split_comm.stage = s;
+        return;
+      }
+      finish_neighbor_stage(gcr, stage, data_parts);
+    }
+    return;
+  }
+
+  if (gcr.shared_memory or not is_splittable(gcr, data_parts)) {
+    ghost_communicator(gcr, data_parts);
+    return;
+  }
+
+  auto const &comm = gcr.mpi_comm;
+  auto const &communications = gcr.communications;
+
+  split_comm.gcr = &gcr;
+  split_comm.data_parts = data_parts;
+  split_comm.buffers.resize(communications.size());
+  split_comm.recv_requests.assign(communications.size(), {});
+  split_comm.send_requests.clear();
+
+  /* The messages between two nodes are matched in the order they were
+   * posted, which is the order of the communications on both sides. */
+  for (std::size_t i = 0; i < communications.size(); i++) {
+    auto const &ghost_comm = communications[i];
+    if ((ghost_comm.type & GHOST_JOBMASK) == GHOST_RECV) {
+      auto &recv_buffer = split_comm.buffers[i];
+      prepare_recv_buffer(recv_buffer, ghost_comm, data_parts);
+      split_comm.recv_requests[i] =
+          comm.irecv(ghost_comm.node, REQ_GHOST_SEND, recv_buffer.data(),
+                     static_cast<int>(recv_buffer.size()));
+    }
+  }
+
+  /* Start everything up to the first communication that touches a cell
+   * which is still waiting for its data, e.g. the forwarding of the
+   * ghosts received in an earlier direction. */
+  std::unordered_set<ParticleList const *> pending;
+  std::size_t i = 0;
+  for (; i < communications.size(); i++) {
+    auto const &part_lists = communications[i].part_lists;
+    if ((communications[i].type & GHOST_JOBMASK) == GHOST_RECV) {
+      pending.insert(part_lists.begin(), part_lists.end());
+      continue;
+    }
+    if (std::any_of(part_lists.begin(), part_lists.end(),
+                    [&pending](ParticleList const *part_list) {
+                      return pending.count(part_list) != 0;
+                    }))
+      break;
+    start_split_communication(i);
+  }
+  split_comm.next = i;
+}
+
+void ghost_communicator_finish() {
+  if (not split_comm.gcr)
+    return;
+
+  if (split_comm.stage) {
+    auto const &gcr = *split_comm.gcr;
+    auto const s = *split_comm.stage;
+    split_comm.gcr = nullptr;
+    split_comm.stage = boost::none;
+
+    MPI_Wait(&split_comm.stage_request, MPI_STATUS_IGNORE);
+    finish_neighbor_stage(gcr, gcr.neighbor_stages[s], split_comm.data_parts);
+    neighbor_stage_communicator(gcr, s + 1, split_comm.data_parts);
+    return;
+  }
+
+  auto const &communications = split_comm.gcr->communications;
+  auto const data_parts = split_comm.data_parts;
+
+  /* The received data is written back in the order of the
+   * communications, so that the result does not depend on
+   * the order of arrival. */
+  for (std::size_t i = 0; i < communications.size(); i++) {
+    auto const &ghost_comm = communications[i];
+    if ((ghost_comm.type & GHOST_JOBMASK) == GHOST_RECV) {
+      split_comm.recv_requests[i].wait();
+      if (data_parts == GHOSTTRANS_FORCE)
+        add_forces_from_recv_buffer(split_comm.buffers[i], ghost_comm);
+      else
+        put_recv_buffer(split_comm.buffers[i], ghost_comm, data_parts);
+    } else if (i >= split_comm.next) {
+      start_split_communication(i);
+    }
+  }
+
+  boost::mpi::wait_all(split_comm.send_requests.begin(),
+                       split_comm.send_requests.end());
+  split_comm.send_requests.clear();
+  split_comm.gcr = nullptr;
+}
+
+bool ghost_communicator_pending() { return split_comm.gcr != nullptr; }
@@ -41,8 +41,12 @@
  *  the four communications above and consist of the data to transfer (which is
  *  determined by their type) and a list of ghost communications. The data
  *  types are described by the particle data classes:
- *  - @ref GHOSTTRANS_PROPRTS transfers the @ref ParticleProperties
+ *  - @ref GHOSTTRANS_PROPRTS transfers the @ref ParticleProperties and the
+ *    @ref ParticleColdProperties
  *  - @ref GHOSTTRANS_POSITION transfers the @ref ParticlePosition
+ *  - @ref GHOSTTRANS_POSITION_DELTA transfers the displacements of the
+ *    particles since their last resort in single precision, and their
+ *    orientations at full precision
  *  - @ref GHOSTTRANS_MOMENTUM transfers the @ref ParticleMomentum
  *  - @ref GHOSTTRANS_FORCE transfers the @ref ParticleForce
  *  - @ref GHOSTTRANS_PARTNUM transfers the cell sizes
@@ -90,6 +94,7 @@
 #include <boost/mpi/communicator.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -119,14 +124,20 @@
 /** Transfer data classes, for \ref ghost_communicator */
 enum : unsigned {
   GHOSTTRANS_NONE = 0u,
-  /// transfer \ref ParticleProperties
+  /// transfer \ref ParticleProperties and \ref ParticleColdProperties
   GHOSTTRANS_PROPRTS = 1u,
   /// transfer \ref ParticlePosition
   GHOSTTRANS_POSITION = 2u,
+  /// transfer the displacement of \ref ParticlePosition::p from
+  /// \ref ParticleLocal::p_old in single precision and the orientation
+  GHOSTTRANS_POSITION_DELTA = 4u,
   /// transfer \ref ParticleMomentum
   GHOSTTRANS_MOMENTUM = 8u,
   /// transfer \ref ParticleForce
   GHOSTTRANS_FORCE = 16u,
+  /// with \ref GHOSTTRANS_POSITION, also transfer \ref ParticleLocal::p_old
+  /// as the reference of later \ref GHOSTTRANS_POSITION_DELTA
+  GHOSTTRANS_POSITION_REF = 32u,
   /// resize the receiver particle arrays to the size of the senders
   GHOSTTRANS_PARTNUM = 64u,
   GHOSTTRANS_BONDS = 128u
@@ -150,6 +161,35 @@ struct GhostCommunication {
   Utils::Vector3d shift = {};
 };
 
+/** Consecutive ghost communications whose messages are exchanged
+ *  by one neighborhood collective, see @ref make_neighbor_stages. */
+struct GhostNeighborStage {
+  /** First communication of the stage */
+  std::size_t first = 0;
+  /** One past the last communication of the stage */
+  std::size_t last = 0;
+  /** Does any node send or receive messages in this stage? */
+  bool exchange = false;
+  /** Distributed graph communicator with the nodes of the receives
+   *  as sources and the nodes of the sends as destinations, in the
+   *  order of the communications */
+  boost::mpi::communicator graph_comm;
+
+  /** Message sizes and buffers, kept from one communication
+   *  to the next so that they only grow on a resort */
+  struct Buffers {
+    std::vector<int> send_counts, send_displs;
+    std::vector<int> recv_counts, recv_displs;
+    std::vector<char> send, recv;
+  };
+  mutable Buffers buffers;
+};
+
+/** Shared-memory window for the messages between the nodes of a
+ *  communicator that run on the same host, see
+ *  @ref make_shared_memory. */
+struct GhostSharedMemory;
+
 /** Properties for a ghost communication. */
 struct GhostCommunicator {
   GhostCommunicator() = default;
@@ -161,6 +201,14 @@ struct GhostCommunicator {
 
   /** List of ghost communications. */
   std::vector<GhostCommunication> communications;
+
+  /** Stages for the neighborhood collectives, which replace the
+   *  point-to-point messages if not empty */
+  std::vector<GhostNeighborStage> neighbor_stages;
+
+  /** Shared memory for the messages to nodes on the same host,
+   *  which replaces the point-to-point messages to them if set */
+  std::shared_ptr<GhostSharedMemory> shared_memory;
 };
 
 /**@}*/
@@ -171,9 +219,87 @@ struct GhostCommunicator {
 
 /**
  * @brief Do a ghost communication with caller specified data parts.
+ *
+ * A communication started by @ref ghost_communicator_begin is
+ * finished first.
  */
 void ghost_communicator(const GhostCommunicator &gcr, unsigned int data_parts);
 
+/**
+ * @brief Exchange the messages of a communicator by neighborhood
+ *        collectives.
+ *
+ * The communications are grouped into stages, and the messages of
+ * every stage are exchanged by one @c MPI_Neighbor_alltoallv on a
+ * distributed graph communicator, which is created here. The
+ * communications of a stage must not depend on each other. Between
+ * two nodes, the sends and receives of a stage have to come in the
+ * same order, as for the point-to-point messages. Communications
+ * that transfer bonds still use point-to-point messages. This is
+ * collective on the communicator of @p gcr.
+ *
+ * @param gcr Communicator to set up.
+ * @param stage_sizes Number of communications in every stage.
+ */
+void make_neighbor_stages(GhostCommunicator &gcr,
+                          std::vector<std::size_t> const &stage_sizes);
+
+/**
+ * @brief Exchange the messages to nodes on the same host by shared
+ *        memory.
+ *
+ * Every node packs its messages to the nodes on the same host into
+ * its part of a window allocated by @c MPI_Win_allocate_shared, and
+ * the receivers unpack them from there, or add up the forces, without
+ * any further copy. A pair of counters per message takes care of the
+ * synchronization. The transfer of the cell sizes and bonds still
+ * uses point-to-point messages. This is collective on the communicator
+ * of @p gcr.
+ *
+ * @param gcr Communicator to set up.
+ */
+void make_shared_memory(GhostCommunicator &gcr);
+
+/**
+ * @brief Adapt the shared memory of a communicator to the current
+ *        cell sizes.
+ *
+ * Has to be called after the sizes of the cells have changed, the
+ * memory is only reallocated if it has become too small. This is
+ * collective on the communicator of @p gcr, and does nothing if it
+ * has no shared memory.
+ */
+void update_shared_memory(const GhostCommunicator &gcr);
+
+/**
+ * @brief Start a ghost communication without waiting for its data.
+ *
+ * All receives are posted right away, and the sends and local
+ * transfers up to the first one that needs data which has not
+ * arrived yet. The rest is done by @ref ghost_communicator_finish,
+ * which has to be called before the transferred data is used.
+ * Only the transfer of fixed-size data with @ref GHOST_SEND,
+ * @ref GHOST_RECV and @ref GHOST_LOCL can be split, any other
+ * communication is done right away. With neighborhood collectives,
+ * the first stage with messages is started, and the later stages
+ * are done by @ref ghost_communicator_finish. Communicators with
+ * shared memory do the whole communication right away.
+ *
+ * The communicator has to stay alive until the communication
+ * is finished.
+ */
+void ghost_communicator_begin(const GhostCommunicator &gcr,
+                              unsigned int data_parts);
+
+/**
+ * @brief Finish the communication started by
+ *        @ref ghost_communicator_begin, if there is one.
+ */
+void ghost_communicator_finish();
+
+/** Is a communication started by @ref ghost_communicator_begin pending? */
+bool ghost_communicator_pending();
+
 /**@}*/
 
 #endif
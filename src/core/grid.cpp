@@ -37,7 +37,11 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <iterator>
+#include <vector>
 
 /**********************************************
  * variables
@@ -48,6 +52,8 @@ LocalBox<double> local_geo;
 
 Utils::Vector3i node_grid{};
 
+std::array<std::vector<double>, 3> node_grid_cuts;
+
 /************************************************************/
 
 void init_node_grid() { grid_changed_n_nodes(); }
@@ -57,7 +63,14 @@ int map_position_node_array(const Utils::Vector3d &pos) {
 
   Utils::Vector3i im;
   for (int i = 0; i < 3; i++) {
-    im[i] = static_cast<int>(std::floor(f_pos[i] / local_geo.length()[i]));
+    if (node_grid_cuts[i].empty()) {
+      im[i] = static_cast<int>(std::floor(f_pos[i] / local_geo.length()[i]));
+    } else {
+      auto const &cuts = node_grid_cuts[i];
+      auto const it = std::upper_bound(cuts.begin(), cuts.end(),
+                                       f_pos[i] / box_geo.length()[i]);
+      im[i] = static_cast<int>(std::distance(cuts.begin(), it)) - 1;
+    }
     im[i] = boost::algorithm::clamp(im[i], 0, node_grid[i] - 1);
   }
 
@@ -95,8 +108,35 @@ LocalBox<double> regular_decomposition(const BoxGeometry &box,
   return {my_left, local_length, boundaries};
 }
 
+LocalBox<double>
+rectilinear_decomposition(const BoxGeometry &box,
+                          Utils::Vector3i const &node_pos,
+                          std::array<std::vector<double>, 3> const &cuts) {
+  Utils::Vector3d my_left;
+  Utils::Vector3d my_right;
+  Utils::Array<int, 6> boundaries;
+
+  for (int dir = 0; dir < 3; dir++) {
+    auto const n_nodes = static_cast<int>(cuts[dir].size()) - 1;
+    my_left[dir] = cuts[dir][node_pos[dir]] * box.length()[dir];
+    my_right[dir] = cuts[dir][node_pos[dir] + 1] * box.length()[dir];
+    boundaries[2 * dir] = (node_pos[dir] == 0);
+    boundaries[2 * dir + 1] = -(node_pos[dir] == n_nodes - 1);
+  }
+
+  return LocalBox<double>::from_corners(my_left, my_right, boundaries);
+}
+
 void grid_changed_box_l(const BoxGeometry &box) {
-  local_geo = regular_decomposition(box, calc_node_pos(comm_cart), node_grid);
+  auto const node_pos = calc_node_pos(comm_cart);
+  local_geo = node_grid_cuts[0].empty()
+                  ? regular_decomposition(box, node_pos, node_grid)
+                  : rectilinear_decomposition(box, node_pos, node_grid_cuts);
+}
+
+void set_node_grid_cuts(std::array<std::vector<double>, 3> const &cuts) {
+  node_grid_cuts = cuts;
+  grid_changed_box_l(box_geo);
 }
 
 void grid_changed_n_nodes() {
@@ -107,6 +147,10 @@ void grid_changed_n_nodes() {
 
   calc_node_neighbors(comm_cart);
 
+  /* The boundaries are only valid for the old node grid */
+  for (auto &cuts : node_grid_cuts)
+    cuts.clear();
+
   grid_changed_box_l(box_geo);
 }
 
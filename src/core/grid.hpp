@@ -38,12 +38,22 @@
 
 #include <boost/mpi/communicator.hpp>
 
+#include <array>
+#include <vector>
+
 extern BoxGeometry box_geo;
 extern LocalBox<double> local_geo;
 
 /** The number of nodes in each spatial dimension. */
 extern Utils::Vector3i node_grid;
 
+/** Positions of the boundaries between the local boxes along each
+ *  direction, in units of the box length. For a direction with @c n
+ *  nodes these are @c n + 1 increasing values, starting at 0 and
+ *  ending at 1. Empty if the box is split into equal parts.
+ */
+extern std::array<std::vector<double>, 3> node_grid_cuts;
+
 /** Make sure that the node grid is set, eventually
  *  determine one automatically.
  */
@@ -74,6 +84,15 @@ void grid_changed_n_nodes();
 /** called from \ref mpi_bcast_parameter . */
 void grid_changed_box_l(const BoxGeometry &box);
 
+/** @brief Move the boundaries between the local boxes.
+ *
+ *  Updates @ref local_geo, the cell system has to be
+ *  reinitialized by the caller.
+ *
+ *  @param cuts New value of @ref node_grid_cuts.
+ */
+void set_node_grid_cuts(std::array<std::vector<double>, 3> const &cuts);
+
 /** @brief Rescale box in dimension @p dir to the new value @p d_new and
  *  rescale the particles accordingly.
  */
@@ -112,4 +131,21 @@ inline Utils::Vector3d unfolded_position(const Utils::Vector3d &pos,
 LocalBox<double> regular_decomposition(const BoxGeometry &box,
                                        Utils::Vector3i const &node_pos,
                                        Utils::Vector3i const &node_grid);
+
+/**
+ * @brief Composition of the simulation box into boxes that are
+ *        separated by planes along each direction.
+ *
+ * Adjacent nodes get bitwise identical boundaries, so that every
+ * position belongs to exactly one of them.
+ *
+ * @param box Geometry of the simulation box
+ * @param node_pos Position of node in the node grid
+ * @param cuts Positions of the boundaries, see @ref node_grid_cuts
+ * @return Geometry for the node
+ */
+LocalBox<double>
+rectilinear_decomposition(const BoxGeometry &box,
+                          Utils::Vector3i const &node_pos,
+                          std::array<std::vector<double>, 3> const &cuts);
 #endif
@@ -150,13 +150,13 @@ Utils::Vector3d lb_viscous_coupling(Particle const &p,
 
   Utils::Vector3d v_drift = interpolated_u;
 #ifdef ENGINE
-  if (p.p.swim.swimming) {
-    v_drift += p.p.swim.v_swim * p.r.calc_director();
+  if (p.c.swim.swimming) {
+    v_drift += p.c.swim.v_swim * p.r.calc_director();
   }
 #endif
 
 #ifdef LB_ELECTROHYDRODYNAMICS
-  v_drift += p.p.mu_E;
+  v_drift += p.c.mu_E;
 #endif
 
   /* calculate viscous force (eq. (9) @cite ahlrichs99a) */
@@ -224,10 +224,10 @@ bool in_local_halo(Vector3d const &pos) {
 
 #ifdef ENGINE
 void add_swimmer_force(Particle &p) {
-  if (p.p.swim.swimming) {
+  if (p.c.swim.swimming) {
     // calculate source position
     const double direction =
-        double(p.p.swim.push_pull) * p.p.swim.dipole_length;
+        double(p.c.swim.push_pull) * p.c.swim.dipole_length;
     auto const director = p.r.calc_director();
     auto const source_position = p.r.p + direction * director;
 
@@ -235,7 +235,7 @@ void add_swimmer_force(Particle &p) {
       return;
     }
 
-    add_md_force(source_position, p.p.swim.f_swim * director);
+    add_md_force(source_position, p.c.swim.f_swim * director);
   }
 }
 #endif
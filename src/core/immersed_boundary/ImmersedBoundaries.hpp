@@ -33,6 +33,10 @@ public:
   void init_volume_conservation(CellStructure &cs);
   void volume_conservation(CellStructure &cs);
   int volume_conservation_set_params(int bond_type, int softID, double kappaV);
+  /** Does @ref volume_conservation add any forces? */
+  bool volume_conservation_active() const {
+    return not VolumeInitDone or BoundariesFound;
+  }
 
 private:
   void calc_volumes(CellStructure &cs);
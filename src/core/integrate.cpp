@@ -38,6 +38,7 @@
 #include "cells.hpp"
 #include "collision.hpp"
 #include "communication.hpp"
+#include "electrostatics_magnetostatics/coulomb.hpp"
 #include "errorhandling.hpp"
 #include "event.hpp"
 #include "forces.hpp"
@@ -45,18 +46,22 @@
 #include "grid.hpp"
 #include "grid_based_algorithms/lb_interface.hpp"
 #include "grid_based_algorithms/lb_particle_coupling.hpp"
+#include "load_balancing.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 #include "npt.hpp"
 #include "rattle.hpp"
 #include "rotation.hpp"
 #include "signalhandling.hpp"
 #include "thermostat.hpp"
+#include "tuning.hpp"
 #include "virtual_sites.hpp"
 
 #include <profiler/profiler.hpp>
 
 #include <boost/range/algorithm/min_element.hpp>
 
+#include <mpi.h>
+
 #include <stdexcept>
 
 #ifdef VALGRIND_INSTRUMENTATION
@@ -76,13 +81,28 @@ bool recalc_forces = true;
 double verlet_reuse = 0.0;
 
 bool set_py_interrupt = false;
+
+VelocityVerletParameters velocity_verlet_params{};
+
 namespace {
 volatile std::sig_atomic_t ctrl_C = 0;
 
+/** Number of steps since the long range forces were last calculated. */
+int long_range_steps = 0;
+
 void notify_sig_int() {
   ctrl_C = 0;              // reset
   set_py_interrupt = true; // global to notify Python
 }
+
+/** Multiples of the long range forces for the force calculation after
+ *  @p step steps since they were last calculated.
+ */
+LongRangeForceWeights long_range_weights(int step) {
+  if (integ_switch == INTEG_METHOD_NVT)
+    return velocity_verlet_long_range_weights(step);
+  return {};
+}
 } // namespace
 
 void integrator_sanity_checks() {
@@ -99,6 +119,12 @@ void integrator_sanity_checks() {
     if (thermo_switch & (THERMO_NPT_ISO | THERMO_BROWNIAN | THERMO_SD))
       runtimeErrorMsg() << "The VV integrator is incompatible with the "
                            "currently active combination of thermostats";
+#if defined(ELECTROSTATICS) && defined(CUDA)
+    if (velocity_verlet_params.long_range_interval > 1 and
+        coulomb.method == COULOMB_P3M_GPU)
+      runtimeErrorMsg() << "Multiple time stepping is not possible with "
+                           "P3M on the GPU";
+#endif
     break;
 #ifdef NPT
   case INTEG_METHOD_NPT_ISO:
@@ -207,7 +233,8 @@ int integrate(int n_steps, int reuse_forces) {
     // Communication step: distribute ghost positions
     cells_update_ghosts(global_ghost_flags());
 
-    force_calc(cell_structure, time_step);
+    force_calc(cell_structure, time_step, long_range_weights(0));
+    long_range_steps = 0;
 
     if (integ_switch != INTEG_METHOD_STEEPEST_DESCENT) {
 #ifdef ROTATION
@@ -264,12 +291,20 @@ int integrate(int n_steps, int reuse_forces) {
     if (cell_structure.get_resort_particles() >= Cells::RESORT_LOCAL)
       n_verlet_updates++;
 
-    // Communication step: distribute ghost positions
-    cells_update_ghosts(global_ghost_flags());
+    auto const update_start = MPI_Wtime();
+
+    // Communication step: distribute ghost positions, this is
+    // finished in force_calc() if it overlaps the force calculation
+    auto const resorted = cells_update_ghosts(global_ghost_flags(), true);
 
     particles = cell_structure.local_particles();
 
-    force_calc(cell_structure, time_step);
+    auto const weights = long_range_weights(++long_range_steps);
+    force_calc(cell_structure, time_step, weights);
+    if (weights.method != 0)
+      long_range_steps = 0;
+
+    adaptive_skin_add_step(MPI_Wtime() - update_start, resorted);
 
 #ifdef VIRTUAL_SITES
     virtual_sites()->after_force_calc();
@@ -301,6 +336,9 @@ int integrate(int n_steps, int reuse_forces) {
     if (check_runtime_errors(comm_cart))
       break;
 
+    load_balancing_step();
+    adaptive_skin_step();
+
     // Check if SIGINT has been caught.
     if (ctrl_C == 1) {
       notify_sig_int();
@@ -422,7 +460,21 @@ void integrate_set_steepest_descent(const double f_max, const double gamma,
   mpi_bcast_parameter(FIELD_INTEG_SWITCH);
 }
 
-void integrate_set_nvt() {
+static void mpi_set_velocity_verlet_params_local(int long_range_interval,
+                                                 bool slow_corrections) {
+  velocity_verlet_params =
+      VelocityVerletParameters{long_range_interval, slow_corrections};
+  /* the current forces may contain multiples of the long range forces */
+  recalc_forces = true;
+}
+
+REGISTER_CALLBACK(mpi_set_velocity_verlet_params_local)
+
+void integrate_set_nvt(int long_range_interval, bool slow_corrections) {
+  if (long_range_interval < 1)
+    throw std::invalid_argument("long_range_interval must be >= 1");
+  mpi_call_all(mpi_set_velocity_verlet_params_local, long_range_interval,
+               slow_corrections);
   integ_switch = INTEG_METHOD_NVT;
   mpi_bcast_parameter(FIELD_INTEG_SWITCH);
 }
@@ -135,8 +135,16 @@ int mpi_steepest_descent(int steps);
 void integrate_set_steepest_descent(double f_max, double gamma,
                                     double max_displacement);
 
-/** @brief Set the velocity Verlet integrator for the NVT ensemble. */
-void integrate_set_nvt();
+/** @brief Set the velocity Verlet integrator for the NVT ensemble.
+ *
+ *  @param long_range_interval  Number of steps between the calculations of
+ *                              the long range forces, which are applied as
+ *                              impulses in between (r-RESPA)
+ *  @param slow_corrections     Calculate the ELC and MDLC corrections only
+ *                              together with the long range forces
+ */
+void integrate_set_nvt(int long_range_interval = 1,
+                       bool slow_corrections = false);
 
 /** @brief Set the Brownian Dynamics integrator. */
 void integrate_set_bd();
@@ -25,11 +25,43 @@
 #include "Particle.hpp"
 #include "ParticleRange.hpp"
 #include "cells.hpp"
+#include "forces.hpp"
 #include "integrate.hpp"
 #include "rotation.hpp"
 
 #include <utils/math/sqr.hpp>
 
+/** Parameters of the velocity Verlet integrator. */
+struct VelocityVerletParameters {
+  /** Number of steps between the calculations of the long range forces,
+   *  one disables multiple time stepping.
+   */
+  int long_range_interval = 1;
+  /** Whether the ELC and MDLC corrections are calculated only together
+   *  with the long range forces, instead of on every step.
+   */
+  bool slow_corrections = false;
+};
+
+/** Currently active velocity Verlet parameters. */
+extern VelocityVerletParameters velocity_verlet_params;
+
+/** Multiples of the long range forces for the force calculation after
+ *  @p step steps since they were last calculated.
+ *
+ *  With multiple time stepping (r-RESPA) the long range forces are only
+ *  calculated every @ref VelocityVerletParameters::long_range_interval
+ *  "long_range_interval" steps, and multiplied by it. The velocity
+ *  half-steps before and after such a force calculation then apply them
+ *  as the impulses of the outer time step, while the other forces are
+ *  integrated with the inner time step @ref time_step.
+ */
+inline LongRangeForceWeights velocity_verlet_long_range_weights(int step) {
+  auto const interval = velocity_verlet_params.long_range_interval;
+  auto const weight = (step % interval == 0) ? interval : 0;
+  return {weight, velocity_verlet_params.slow_corrections ? weight : 1};
+}
+
 /** Propagate the velocities and positions. Integration steps before force
  *  calculation of the Velocity Verlet integrator: <br> \f[ v(t+0.5 \Delta t) =
  *  v(t) + 0.5 \Delta t f(t)/m \f] <br> \f[ p(t+\Delta t) = p(t) + \Delta t
@@ -23,6 +23,7 @@
 #include "TabulatedPotential.hpp"
 #include "bonded_interactions/bonded_interaction_data.hpp"
 #include "event.hpp"
+#include "nonbonded_interactions/pair_spline_tables.hpp"
 
 #include "serialization/IA_parameters.hpp"
 
@@ -39,6 +40,7 @@ inline bool is_tabulated_bond(BondedInteraction const type) {
 
 void mpi_bcast_all_ia_params_slave() {
   boost::mpi::broadcast(comm_cart, ia_params, 0);
+  pair_spline_tables_invalidate();
 }
 
 REGISTER_CALLBACK(mpi_bcast_all_ia_params_slave)
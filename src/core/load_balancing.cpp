@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** @file
+ *  Implementation of load_balancing.hpp.
+ */
+
+#include "load_balancing.hpp"
+
+#include "CellStructure.hpp"
+#include "cells.hpp"
+#include "communication.hpp"
+#include "config.hpp"
+#include "electrostatics_magnetostatics/coulomb.hpp"
+#include "electrostatics_magnetostatics/dipole.hpp"
+#include "errorhandling.hpp"
+#include "grid.hpp"
+#include "grid_based_algorithms/lb_interface.hpp"
+#include "integrate.hpp"
+
+#include <utils/mpi/cart_comm.hpp>
+
+#include <boost/mpi/collectives/all_gather.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+int load_balancing_interval = 0;
+
+namespace {
+/** Integration steps since the last load balancing step. */
+int steps_since_balancing = 0;
+/** Force calculation time on this node since the last load balancing step. */
+double local_force_time = 0.;
+
+/** Fraction of the way the boundaries are moved in one step,
+ *  less than 1 to damp the response to noisy timings. */
+constexpr double relaxation = 0.5;
+/** Relative deviation of the maximal from the mean load below
+ *  which the boundaries are left alone. */
+constexpr double tolerance = 0.05;
+
+/** Do all active algorithms support non-uniform local boxes? */
+bool load_balancing_supported() {
+  if (lattice_switch != ActiveLB::NONE)
+    return false;
+#ifdef ELECTROSTATICS
+  switch (coulomb.method) {
+  case COULOMB_P3M:
+  case COULOMB_P3M_GPU:
+  case COULOMB_ELC_P3M:
+  case COULOMB_SCAFACOS:
+    return false;
+  default:
+    break;
+  }
+#endif
+#ifdef DIPOLES
+  switch (dipole.method) {
+  case DIPOLAR_P3M:
+  case DIPOLAR_MDLC_P3M:
+  case DIPOLAR_SCAFACOS:
+    return false;
+  default:
+    break;
+  }
+#endif
+  return true;
+}
+
+/** Restore equally sized local boxes. */
+void reset_node_grid_cuts() {
+  if (node_grid_cuts[0].empty())
+    return;
+
+  set_node_grid_cuts({});
+  cells_re_init(cell_structure.decomposition_type());
+}
+} // namespace
+
+std::vector<double> balance_cuts(std::vector<double> const &cuts,
+                                 std::vector<double> const &loads,
+                                 double min_width, double relaxation) {
+  auto const n_slabs = loads.size();
+  auto const total_load = std::accumulate(loads.begin(), loads.end(), 0.);
+
+  if (n_slabs < 2 or total_load <= 0. or n_slabs * min_width > 1.)
+    return cuts;
+
+  auto new_cuts = cuts;
+  std::size_t slab = 0;
+  double load_below = 0.;
+  for (std::size_t k = 1; k < n_slabs; k++) {
+    /* Find the slab in which the cumulated load reaches
+     * its share for the first k slabs... */
+    auto const target = total_load * static_cast<double>(k) / n_slabs;
+    while (slab < n_slabs - 1 and load_below + loads[slab] < target) {
+      load_below += loads[slab++];
+    }
+
+    /* ...and interpolate linearly within it. */
+    auto const balanced_cut =
+        (loads[slab] > 0.)
+            ? cuts[slab] + (cuts[slab + 1] - cuts[slab]) *
+                               (target - load_below) / loads[slab]
+            : cuts[slab];
+    new_cuts[k] = cuts[k] + relaxation * (balanced_cut - cuts[k]);
+  }
+
+  for (std::size_t k = 1; k < n_slabs; k++) {
+    new_cuts[k] = std::max(new_cuts[k], new_cuts[k - 1] + min_width);
+  }
+  for (std::size_t k = n_slabs - 1; k > 0; k--) {
+    new_cuts[k] = std::min(new_cuts[k], new_cuts[k + 1] - min_width);
+  }
+
+  return new_cuts;
+}
+
+void load_balancing_add_force_time(double time) { local_force_time += time; }
+
+void load_balancing_step() {
+  if (load_balancing_interval <= 0 or
+      ++steps_since_balancing < load_balancing_interval)
+    return;
+
+  steps_since_balancing = 0;
+  auto const force_time = std::exchange(local_force_time, 0.);
+
+  if (cell_structure.decomposition_type() != CELL_STRUCTURE_DOMDEC)
+    return;
+
+  if (not load_balancing_supported()) {
+    reset_node_grid_cuts();
+    runtimeErrorMsg() << "load balancing is not supported with P3M, "
+                         "ScaFaCoS or lattice-Boltzmann";
+    return;
+  }
+
+  std::vector<double> times;
+  boost::mpi::all_gather(comm_cart, force_time, times);
+
+  auto const mean_time =
+      std::accumulate(times.begin(), times.end(), 0.) / times.size();
+  auto const max_time = *std::max_element(times.begin(), times.end());
+  if (max_time <= (1. + tolerance) * mean_time)
+    return;
+
+  auto cuts = node_grid_cuts;
+  for (int dir = 0; dir < 3; dir++) {
+    if (cuts[dir].empty()) {
+      for (int i = 0; i <= node_grid[dir]; i++)
+        cuts[dir].push_back(static_cast<double>(i) / node_grid[dir]);
+    }
+  }
+
+  for (int dir = 0; dir < 3; dir++) {
+    if (node_grid[dir] == 1)
+      continue;
+
+    std::vector<double> loads(node_grid[dir], 0.);
+    for (int rank = 0; rank < comm_cart.size(); rank++) {
+      loads[Utils::Mpi::cart_coords<3>(comm_cart, rank)[dir]] += times[rank];
+    }
+
+    /* Every local box has to hold at least one cell. */
+    auto const min_width = (1. + 1e-6) * std::max(interaction_range(), 0.) /
+                           box_geo.length()[dir];
+    cuts[dir] = balance_cuts(cuts[dir], loads, min_width, relaxation);
+  }
+
+  set_node_grid_cuts(cuts);
+  cells_re_init(CELL_STRUCTURE_DOMDEC);
+}
+
+void mpi_set_load_balancing_interval_local(int interval) {
+  load_balancing_interval = interval;
+  steps_since_balancing = 0;
+  local_force_time = 0.;
+
+  if (interval == 0)
+    reset_node_grid_cuts();
+}
+
+REGISTER_CALLBACK(mpi_set_load_balancing_interval_local)
+
+void mpi_set_load_balancing_interval(int interval) {
+  mpi_call_all(mpi_set_load_balancing_interval_local, interval);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ESPRESSO_LOAD_BALANCING_HPP
+#define ESPRESSO_LOAD_BALANCING_HPP
+/** @file
+ *  Dynamic load balancing for the domain decomposition.
+ *
+ *  Every @ref load_balancing_interval integration steps the time
+ *  spent in the short-range force calculation is collected from all
+ *  nodes, and the planes that separate the local boxes are moved
+ *  along each direction of the node grid, such that the slabs of
+ *  nodes between two planes get similar amounts of work
+ *  (see @ref node_grid_cuts). The particles then migrate to their
+ *  new nodes with the next global resort.
+ *
+ *  The long-range methods and the lattice-Boltzmann fluid rely on
+ *  equally sized local boxes, load balancing can not be used together
+ *  with them.
+ *
+ *  Implementation in load_balancing.cpp.
+ */
+
+#include <vector>
+
+/** Number of integration steps between two load balancing steps,
+ *  load balancing is disabled if this is 0.
+ */
+extern int load_balancing_interval;
+
+/** @brief Set @ref load_balancing_interval.
+ *
+ *  Disabling the load balancing restores equally sized local boxes.
+ *
+ *  @param interval Number of integration steps between two load
+ *         balancing steps, 0 to disable.
+ */
+void mpi_set_load_balancing_interval(int interval);
+
+/** Add to the time spent in the short-range force
+ *  calculation on this node since the last load balancing step.
+ */
+void load_balancing_add_force_time(double time);
+
+/** @brief Count an integration step, and move the boundaries of the
+ *  local boxes every @ref load_balancing_interval steps.
+ *
+ *  Has to be called on all nodes.
+ */
+void load_balancing_step();
+
+/** @brief Move the boundaries of the slabs along one direction
+ *  towards an equal distribution of the load.
+ *
+ *  The load is assumed to be distributed uniformly within each slab.
+ *  The boundaries are moved by the fraction @p relaxation of the
+ *  distance to the balanced positions, and kept at least
+ *  @p min_width apart.
+ *
+ *  @param cuts Boundaries of the slabs, increasing from 0 to 1.
+ *  @param loads Load of each slab.
+ *  @param min_width Minimal width of a slab.
+ *  @param relaxation Fraction of the way to the balanced boundaries.
+ *  @return New boundaries, or @p cuts if no valid ones exist.
+ */
+std::vector<double> balance_cuts(std::vector<double> const &cuts,
+                                 std::vector<double> const &loads,
+                                 double min_width, double relaxation);
+
+#endif
@@ -73,9 +73,29 @@ public:
 #endif
 
     // Within short-range distance (including dpd and the like)
+    return short_range(p1, p2, dist);
+  }
+
+  /** Is the pair within the cutoff of the short-range interactions
+   *  of its particle types, including the skin? Pairs that pass the
+   *  criterion without this can only interact via electrostatics,
+   *  magnetostatics or collision detection until the next rebuild.
+   */
+  template <typename Distance>
+  bool short_range(const Particle &p1, const Particle &p2,
+                   Distance const &dist) const {
     auto const max_cut = get_ia_param(p1.p.type, p2.p.type)->max_cut;
     return (max_cut != INACTIVE_CUTOFF) &&
-           (dist2 <= Utils::sqr(max_cut + m_skin));
+           (dist.dist2 <= Utils::sqr(max_cut + m_skin));
   }
 };
+
+/** Interaction class of a pair for the Verlet lists,
+ *  see @ref CellStructure::use_pair_class_lists.
+ */
+template <typename Distance>
+bool short_range_class(VerletCriterion const &criterion, const Particle &p1,
+                       const Particle &p2, Distance const &dist) {
+  return criterion.short_range(p1, p2, dist);
+}
 #endif
@@ -96,7 +96,7 @@ static double recalc_long_range_cutoff() {
   return max_cut_long_range;
 }
 
-static double recalc_maximal_cutoff(const IA_parameters &data) {
+double recalc_maximal_cutoff(const IA_parameters &data) {
   auto max_cut_current = INACTIVE_CUTOFF;
 
 #ifdef LENNARD_JONES
@@ -189,6 +189,100 @@ double maximal_cutoff_nonbonded() {
   return max_cut_nonbonded;
 }
 
+unsigned active_nonbonded_potentials(const IA_parameters &data) {
+  unsigned potentials = NB_NONE;
+
+#ifdef LENNARD_JONES
+  if (data.lj.cut + data.lj.offset > 0.)
+    potentials |= NB_LJ;
+#endif
+
+#ifdef WCA
+  if (data.wca.cut > 0.)
+    potentials |= NB_WCA;
+#endif
+
+#ifdef LENNARD_JONES_GENERIC
+  if (data.ljgen.cut + data.ljgen.offset > 0.)
+    potentials |= NB_LJGEN;
+#endif
+
+#ifdef SMOOTH_STEP
+  if (data.smooth_step.cut > 0.)
+    potentials |= NB_SMOOTH_STEP;
+#endif
+
+#ifdef HERTZIAN
+  if (data.hertzian.sig > 0.)
+    potentials |= NB_HERTZIAN;
+#endif
+
+#ifdef GAUSSIAN
+  if (data.gaussian.cut > 0.)
+    potentials |= NB_GAUSSIAN;
+#endif
+
+#ifdef BMHTF_NACL
+  if (data.bmhtf.cut > 0.)
+    potentials |= NB_BMHTF;
+#endif
+
+#ifdef BUCKINGHAM
+  if (data.buckingham.cut > 0.)
+    potentials |= NB_BUCKINGHAM;
+#endif
+
+#ifdef MORSE
+  if (data.morse.cut > 0.)
+    potentials |= NB_MORSE;
+#endif
+
+#ifdef SOFT_SPHERE
+  if (data.soft_sphere.cut + data.soft_sphere.offset > 0.)
+    potentials |= NB_SOFT_SPHERE;
+#endif
+
+#ifdef HAT
+  if (data.hat.r > 0.)
+    potentials |= NB_HAT;
+#endif
+
+#ifdef LJCOS
+  if (data.ljcos.cut + data.ljcos.offset > 0.)
+    potentials |= NB_LJCOS;
+#endif
+
+#ifdef LJCOS2
+  if (data.ljcos2.cut + data.ljcos2.offset > 0.)
+    potentials |= NB_LJCOS2;
+#endif
+
+#ifdef THOLE
+  if (data.thole.scaling_coeff != 0.)
+    potentials |= NB_THOLE;
+#endif
+
+#ifdef TABULATED
+  if (data.tab.cutoff() > 0.)
+    potentials |= NB_TABULATED;
+#endif
+
+#ifdef GAY_BERNE
+  if (data.gay_berne.cut > 0.)
+    potentials |= NB_GAY_BERNE;
+#endif
+
+  return potentials;
+}
+
+unsigned active_nonbonded_potentials() {
+  unsigned potentials = NB_NONE;
+  for (auto const &data : ia_params) {
+    potentials |= active_nonbonded_potentials(data);
+  }
+  return potentials;
+}
+
 double maximal_cutoff() {
   auto max_cut = min_global_cut;
   auto const max_cut_long_range = recalc_long_range_cutoff();
@@ -277,6 +277,44 @@ struct IA_parameters {
 
 extern std::vector<IA_parameters> ia_params;
 
+/** Bit flags of the non-bonded pair potentials, used to select a force
+ *  kernel that only evaluates the potentials in use.
+ */
+enum NonBondedPotential : unsigned {
+  NB_NONE = 0u,
+  NB_LJ = 1u << 0,
+  NB_WCA = 1u << 1,
+  NB_LJGEN = 1u << 2,
+  NB_SMOOTH_STEP = 1u << 3,
+  NB_HERTZIAN = 1u << 4,
+  NB_GAUSSIAN = 1u << 5,
+  NB_BMHTF = 1u << 6,
+  NB_BUCKINGHAM = 1u << 7,
+  NB_MORSE = 1u << 8,
+  NB_SOFT_SPHERE = 1u << 9,
+  NB_HAT = 1u << 10,
+  NB_LJCOS = 1u << 11,
+  NB_LJCOS2 = 1u << 12,
+  NB_THOLE = 1u << 13,
+  NB_TABULATED = 1u << 14,
+  NB_GAY_BERNE = 1u << 15,
+  NB_ALL = (1u << 16) - 1u,
+  /** Potentials that can be tabulated automatically,
+   *  see @ref pair_spline_tables.hpp. */
+  NB_AUTO_TABULATED = NB_ALL & ~(NB_THOLE | NB_TABULATED | NB_GAY_BERNE),
+  /** Evaluate @ref NB_AUTO_TABULATED by the automatic tables. */
+  NB_SPLINE_TABLE = 1u << 16
+};
+
+/** Pair potentials of a single type pair that can contribute a force,
+ *  as a combination of @ref NonBondedPotential flags.
+ */
+unsigned active_nonbonded_potentials(const IA_parameters &data);
+
+/** Pair potentials of all type pairs that can contribute a force.
+ */
+unsigned active_nonbonded_potentials();
+
 /** Maximal particle type seen so far. */
 extern int max_seen_particle_type;
 
@@ -288,6 +326,10 @@ double maximal_cutoff_nonbonded();
  */
 double maximal_cutoff_bonded();
 
+/** Maximal cutoff of the pair potentials of a single type pair.
+ */
+double recalc_maximal_cutoff(const IA_parameters &data);
+
 /** Minimal global interaction cutoff. Particles with a distance
  *  smaller than this are guaranteed to be available on the same node
  *  (through ghosts).
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *
+ *  Implementation of \ref pair_spline_tables.hpp
+ */
+#include "nonbonded_interactions/pair_spline_tables.hpp"
+
+#include "communication.hpp"
+#include "forces_inline.hpp"
+#include "integrate.hpp"
+
+#include <utils/math/sqr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+int pair_spline_tables_n_intervals = 0;
+double pair_spline_tables_max_force = 1e4;
+std::vector<CubicSplineTable> pair_spline_tables;
+
+namespace {
+bool tables_valid = false;
+
+/** Distances at which the tabulated potentials of a type pair
+ *  switch on or off, or change their functional form.
+ */
+std::vector<double> potential_breakpoints(IA_parameters const &data) {
+  std::vector<double> r;
+  auto const potentials = active_nonbonded_potentials(data);
+
+#ifdef LENNARD_JONES
+  if (potentials & NB_LJ) {
+    r.push_back(data.lj.cut + data.lj.offset);
+    r.push_back(data.lj.min + data.lj.offset);
+  }
+#endif
+#ifdef WCA
+  if (potentials & NB_WCA)
+    r.push_back(data.wca.cut);
+#endif
+#ifdef LENNARD_JONES_GENERIC
+  if (potentials & NB_LJGEN)
+    r.push_back(data.ljgen.cut + data.ljgen.offset);
+#endif
+#ifdef SMOOTH_STEP
+  if (potentials & NB_SMOOTH_STEP)
+    r.push_back(data.smooth_step.cut);
+#endif
+#ifdef HERTZIAN
+  if (potentials & NB_HERTZIAN)
+    r.push_back(data.hertzian.sig);
+#endif
+#ifdef GAUSSIAN
+  if (potentials & NB_GAUSSIAN)
+    r.push_back(data.gaussian.cut);
+#endif
+#ifdef BMHTF_NACL
+  if (potentials & NB_BMHTF)
+    r.push_back(data.bmhtf.cut);
+#endif
+#ifdef BUCKINGHAM
+  if (potentials & NB_BUCKINGHAM) {
+    r.push_back(data.buckingham.cut);
+    r.push_back(data.buckingham.discont);
+  }
+#endif
+#ifdef MORSE
+  if (potentials & NB_MORSE)
+    r.push_back(data.morse.cut);
+#endif
+#ifdef SOFT_SPHERE
+  if (potentials & NB_SOFT_SPHERE) {
+    r.push_back(data.soft_sphere.cut + data.soft_sphere.offset);
+    r.push_back(data.soft_sphere.offset);
+  }
+#endif
+#ifdef HAT
+  if (potentials & NB_HAT)
+    r.push_back(data.hat.r);
+#endif
+#ifdef LJCOS
+  if (potentials & NB_LJCOS) {
+    r.push_back(data.ljcos.cut + data.ljcos.offset);
+    r.push_back(data.ljcos.rmin + data.ljcos.offset);
+  }
+#endif
+#ifdef LJCOS2
+  if (potentials & NB_LJCOS2) {
+    r.push_back(data.ljcos2.cut + data.ljcos2.offset);
+    r.push_back(data.ljcos2.rchange + data.ljcos2.offset);
+    r.push_back(data.ljcos2.rchange + data.ljcos2.w + data.ljcos2.offset);
+  }
+#endif
+
+  return r;
+}
+
+/** Force factor F(r)/r of the tabulated potentials of a type pair. */
+double tabulated_force_factor(IA_parameters const &data, double dist) {
+  static const Particle p{};
+  return calc_non_bonded_pair_force<NB_AUTO_TABULATED>(
+             p, p, data, Utils::Vector3d{dist, 0., 0.}, dist)
+             .f[0] /
+         dist;
+}
+
+/** Table of the type pair with the parameters @p data. */
+CubicSplineTable make_table(IA_parameters const &data) {
+  if (not(active_nonbonded_potentials(data) & NB_AUTO_TABULATED))
+    return {};
+
+  auto breakpoints = potential_breakpoints(data);
+  auto const r_cut = *std::max_element(breakpoints.begin(), breakpoints.end());
+  if (r_cut <= 0.)
+    return {};
+
+  /* The table starts where the force exceeds the threshold
+   * or the force factor diverges. */
+  auto const n_scan = 4 * pair_spline_tables_n_intervals;
+  auto r_min = r_cut / n_scan;
+  for (int k = n_scan - 1; k > 0; k--) {
+    auto const r = r_cut * k / n_scan;
+    auto const factor = tabulated_force_factor(data, r);
+    if (not std::isfinite(factor) or
+        std::abs(factor * r) > pair_spline_tables_max_force) {
+      r_min = r_cut * (k + 1) / n_scan;
+      break;
+    }
+  }
+
+  /* Segment boundaries in r^2 */
+  std::vector<double> s{Utils::sqr(r_min), Utils::sqr(r_cut)};
+  for (auto const r : breakpoints) {
+    if (r > r_min and r < r_cut)
+      s.push_back(Utils::sqr(r));
+  }
+  std::sort(s.begin(), s.end());
+  s.erase(std::unique(s.begin(), s.end()), s.end());
+
+  return CubicSplineTable(
+      [&data](double s) { return tabulated_force_factor(data, std::sqrt(s)); },
+      s, pair_spline_tables_n_intervals);
+}
+
+/** Deviation of the tabulated force from the analytic one. */
+double table_error(IA_parameters const &data, CubicSplineTable const &table) {
+  return table.max_error(
+      [&data](double s) { return tabulated_force_factor(data, std::sqrt(s)); },
+      [](double s) { return std::sqrt(s); });
+}
+} // namespace
+
+void pair_spline_tables_invalidate() { tables_valid = false; }
+
+void update_pair_spline_tables() {
+  if (not pair_spline_tables_active()) {
+    pair_spline_tables.clear();
+    return;
+  }
+
+  if (tables_valid and pair_spline_tables.size() == ia_params.size())
+    return;
+
+  pair_spline_tables.resize(ia_params.size());
+  std::transform(ia_params.begin(), ia_params.end(),
+                 pair_spline_tables.begin(), make_table);
+  tables_valid = true;
+}
+
+std::vector<PairSplineTableInfo> pair_spline_tables_info() {
+  update_pair_spline_tables();
+
+  std::vector<PairSplineTableInfo> info;
+  if (not pair_spline_tables_active())
+    return info;
+
+  for (int i = 0; i < max_seen_particle_type; i++) {
+    for (int j = i; j < max_seen_particle_type; j++) {
+      auto const &data = *get_ia_param(i, j);
+      auto const &table = pair_spline_table(data);
+      if (table.empty())
+        continue;
+      info.push_back({i, j, std::sqrt(table.begin()), std::sqrt(table.end()),
+                      table.n_intervals(), table_error(data, table)});
+    }
+  }
+  return info;
+}
+
+void mpi_set_pair_spline_tables_local(int n_intervals, double max_force) {
+  pair_spline_tables_n_intervals = n_intervals;
+  pair_spline_tables_max_force = max_force;
+  pair_spline_tables_invalidate();
+  recalc_forces = true;
+}
+
+REGISTER_CALLBACK(mpi_set_pair_spline_tables_local)
+
+void mpi_set_pair_spline_tables(int n_intervals, double max_force) {
+  mpi_call_all(mpi_set_pair_spline_tables_local, n_intervals, max_force);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CORE_NB_IA_PAIR_SPLINE_TABLES_HPP
+#define CORE_NB_IA_PAIR_SPLINE_TABLES_HPP
+
+/** \file
+ *  Automatic tabulation of the non-bonded pair potentials.
+ *
+ *  If enabled, the force factor F(r)/r of the sum of the potentials in
+ *  @ref NB_AUTO_TABULATED of every type pair is tabulated as a function
+ *  of r^2 and evaluated by cubic spline interpolation, so that the cost
+ *  per pair does not depend on the potentials. The tables start where
+ *  the force drops below a threshold; closer pairs and the potentials
+ *  that are not tabulated are evaluated analytically.
+ *
+ *  Implementation in \ref pair_spline_tables.cpp.
+ */
+
+#include "CubicSplineTable.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/** Resolution and accuracy of the table of a type pair. */
+struct PairSplineTableInfo {
+  int type_a;
+  int type_b;
+  /** Distance at which the table starts. */
+  double r_min;
+  /** Distance at which the table ends. */
+  double r_cut;
+  std::size_t n_intervals;
+  /** Maximal deviation of the tabulated force from the analytic one. */
+  double max_error;
+};
+
+/** Number of intervals per table, 0 if the tables are not used. */
+extern int pair_spline_tables_n_intervals;
+/** Magnitude of the force below which the tables start. */
+extern double pair_spline_tables_max_force;
+/** Tables of all type pairs, in the order of @ref ia_params. */
+extern std::vector<CubicSplineTable> pair_spline_tables;
+
+inline bool pair_spline_tables_active() {
+  return pair_spline_tables_n_intervals > 0;
+}
+
+/** Table of the type pair with the parameters @p data,
+ *  which has to be an element of @ref ia_params.
+ */
+inline CubicSplineTable const &pair_spline_table(IA_parameters const &data) {
+  return pair_spline_tables[&data - ia_params.data()];
+}
+
+/** Mark the tables as outdated, they are rebuilt by the next
+ *  @ref update_pair_spline_tables.
+ */
+void pair_spline_tables_invalidate();
+
+/** Rebuild the tables if they are used and outdated. */
+void update_pair_spline_tables();
+
+/** Resolution and accuracy of the tables of all type pairs
+ *  with tabulated potentials, updates the tables.
+ */
+std::vector<PairSplineTableInfo> pair_spline_tables_info();
+
+/** Set the parameters of the tables on all nodes.
+ *
+ *  @param n_intervals  Number of intervals per table, 0 disables them.
+ *  @param max_force    Magnitude of the force below which the tables start.
+ */
+void mpi_set_pair_spline_tables(int n_intervals, double max_force);
+
+#endif
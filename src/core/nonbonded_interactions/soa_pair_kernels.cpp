@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/** \file
+ *
+ *  Implementation of \ref soa_pair_kernels.hpp
+ */
+#include "soa_pair_kernels.hpp"
+
+#include "collision.hpp"
+#include "config.hpp"
+#include "electrostatics_magnetostatics/coulomb.hpp"
+#include "electrostatics_magnetostatics/dipole.hpp"
+#include "electrostatics_magnetostatics/p3m.hpp"
+#include "integrate.hpp"
+#include "nonbonded_interaction_data.hpp"
+#include "thermostat.hpp"
+
+#include <utils/constants.hpp>
+#include <utils/math/AS_erfc_part.hpp>
+#include <utils/math/int_pow.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+/** Parameters of one type pair in the form used by the kernels. */
+struct PairParameters {
+  double lj_eps = 0.;
+  double lj_sig6 = 0.;
+  double lj_cut2 = 0.;
+  double lj_min2 = 0.;
+  double wca_eps = 0.;
+  double wca_sig6 = 0.;
+  double wca_cut2 = 0.;
+};
+
+/** Real-space %Coulomb parameters. */
+struct CoulombParameters {
+  double prefactor = 0.;
+  double alpha = 0.;
+  double r_cut2 = 0.;
+};
+
+/** Squared cutoff, inactive potentials map to zero. */
+double cutoff2(double cut) { return (cut > 0.) ? Utils::sqr(cut) : 0.; }
+
+/**
+ * @brief Parameters for all type pairs.
+ *
+ * The table is stored as a full square matrix, so that the
+ * parameters of type i with all other types form a contiguous row.
+ */
+std::vector<PairParameters> pair_parameter_table(int n_types) {
+  std::vector<PairParameters> table(Utils::sqr(n_types));
+
+  for (int i = 0; i < n_types; i++) {
+    for (int j = 0; j < n_types; j++) {
+      auto const &ia = *get_ia_param(i, j);
+      auto &params = table[i * n_types + j];
+#ifdef LENNARD_JONES
+      params.lj_eps = ia.lj.eps;
+      params.lj_sig6 = Utils::int_pow<6>(ia.lj.sig);
+      params.lj_cut2 = cutoff2(ia.lj.cut);
+      params.lj_min2 = Utils::sqr(ia.lj.min);
+#endif
+#ifdef WCA
+      params.wca_eps = ia.wca.eps;
+      params.wca_sig6 = Utils::int_pow<6>(ia.wca.sig);
+      params.wca_cut2 = cutoff2(ia.wca.cut);
+#endif
+    }
+  }
+
+  return table;
+}
+
+/** Lennard-Jones and WCA force factor for squared distance r2. */
+inline double short_range_force_factor(PairParameters const &params,
+                                       double r2, double inv_r2) {
+  auto const frac6_lj = params.lj_sig6 * inv_r2 * inv_r2 * inv_r2;
+  auto const ff_lj =
+      48. * params.lj_eps * frac6_lj * (frac6_lj - 0.5) * inv_r2;
+  auto const frac6_wca = params.wca_sig6 * inv_r2 * inv_r2 * inv_r2;
+  auto const ff_wca =
+      48. * params.wca_eps * frac6_wca * (frac6_wca - 0.5) * inv_r2;
+
+  auto ff = ((r2 < params.lj_cut2) and (r2 > params.lj_min2)) ? ff_lj : 0.;
+  ff += (r2 < params.wca_cut2) ? ff_wca : 0.;
+
+  return ff;
+}
+
+/** Real-space P3M force factor for squared distance r2. */
+inline double coulomb_force_factor(CoulombParameters const &coulomb_params,
+                                   double q1q2, double r2, double inv_r2) {
+  auto const dist = std::sqrt(r2);
+  auto const adist = coulomb_params.alpha * dist;
+  auto const exp_adist2 = std::exp(-adist * adist);
+#if USE_ERFC_APPROXIMATION
+  auto const erfc_part = Utils::AS_erfc_part(adist) * exp_adist2;
+#else
+  auto const erfc_part = std::erfc(adist);
+#endif
+  auto const ff = coulomb_params.prefactor * q1q2 *
+                  (erfc_part / dist + 2. * coulomb_params.alpha *
+                                          Utils::sqrt_pi_i() * exp_adist2) *
+                  inv_r2;
+
+  return ((r2 < coulomb_params.r_cut2) and (r2 > 0.)) ? ff : 0.;
+}
+
+/**
+ * @brief Forces between particle i and the particles
+ *        in the index range [first, last).
+ *
+ * @tparam with_coulomb Include real-space P3M.
+ */
+template <bool with_coulomb>
+void pair_row(ParticleSoA &soa, std::size_t i, std::size_t first,
+              std::size_t last, PairParameters const *row,
+              CoulombParameters const &coulomb_params) {
+  auto const *x = soa.x.data();
+  auto const *y = soa.y.data();
+  auto const *z = soa.z.data();
+  auto const *q = soa.q.data();
+  auto const *type = soa.type.data();
+  auto *fx = soa.fx.data();
+  auto *fy = soa.fy.data();
+  auto *fz = soa.fz.data();
+
+  auto const xi = x[i];
+  auto const yi = y[i];
+  auto const zi = z[i];
+  auto const qi = q[i];
+
+  double fxi = 0., fyi = 0., fzi = 0.;
+
+  for (std::size_t j = first; j < last; j++) {
+    auto const dx = xi - x[j];
+    auto const dy = yi - y[j];
+    auto const dz = zi - z[j];
+    auto const r2 = dx * dx + dy * dy + dz * dz;
+    auto const inv_r2 = 1. / r2;
+
+    auto ff = short_range_force_factor(row[type[j]], r2, inv_r2);
+    if (with_coulomb) {
+      ff += coulomb_force_factor(coulomb_params, qi * q[j], r2, inv_r2);
+    }
+
+    fxi += ff * dx;
+    fyi += ff * dy;
+    fzi += ff * dz;
+    fx[j] -= ff * dx;
+    fy[j] -= ff * dy;
+    fz[j] -= ff * dz;
+  }
+
+  fx[i] += fxi;
+  fy[i] += fyi;
+  fz[i] += fzi;
+}
+
+/**
+ * @brief Forces between the particle pairs of a cluster-pair list.
+ *
+ * The inner loop runs over the fixed number of particles of
+ * cluster j, pairs that are not in the list are masked out.
+ */
+template <bool with_coulomb>
+void cluster_pair_forces(ParticleSoA &soa, ClusterPairList const &list,
+                         std::vector<PairParameters> const &table,
+                         int n_types,
+                         CoulombParameters const &coulomb_params) {
+  constexpr auto cluster_size = ClusterPairList::cluster_size;
+
+  auto const *x = soa.x.data();
+  auto const *y = soa.y.data();
+  auto const *z = soa.z.data();
+  auto const *q = soa.q.data();
+  auto const *type = soa.type.data();
+  auto *fx = soa.fx.data();
+  auto *fy = soa.fy.data();
+  auto *fz = soa.fz.data();
+
+  for (auto const &cp : list.pairs()) {
+    for (std::size_t a = 0; a < cluster_size; a++) {
+      auto const i = cp.i * cluster_size + a;
+      auto const row = table.data() + type[i] * n_types;
+      auto const xi = x[i];
+      auto const yi = y[i];
+      auto const zi = z[i];
+      auto const qi = q[i];
+
+      double fxi = 0., fyi = 0., fzi = 0.;
+
+      for (std::size_t b = 0; b < cluster_size; b++) {
+        auto const j = cp.j * cluster_size + b;
+        auto const bit = 1u << (a * cluster_size + b);
+        auto const dx = xi - x[j];
+        auto const dy = yi - y[j];
+        auto const dz = zi - z[j];
+        auto const r2 = dx * dx + dy * dy + dz * dz;
+        auto const inv_r2 = 1. / r2;
+
+        auto const ff_sr = short_range_force_factor(row[type[j]], r2, inv_r2);
+        auto ff = (cp.nonbonded_mask & bit) ? ff_sr : 0.;
+        if (with_coulomb) {
+          auto const ff_coulomb =
+              coulomb_force_factor(coulomb_params, qi * q[j], r2, inv_r2);
+          ff += (cp.pair_mask & bit) ? ff_coulomb : 0.;
+        }
+
+        fxi += ff * dx;
+        fyi += ff * dy;
+        fzi += ff * dz;
+        fx[j] -= ff * dx;
+        fy[j] -= ff * dy;
+        fz[j] -= ff * dz;
+      }
+
+      fx[i] += fxi;
+      fy[i] += fyi;
+      fz[i] += fzi;
+    }
+  }
+}
+
+/**
+ * @brief Forces between all pairs of the mirror, the pairs are
+ *        visited in the same order as in @ref Algorithm::link_cell.
+ */
+template <bool with_coulomb>
+void pair_forces(ParticleSoA &soa, std::vector<PairParameters> const &table,
+                 int n_types, CoulombParameters const &coulomb_params) {
+  for (std::size_t c = 0; c < soa.n_local_cells; c++) {
+    auto const begin = soa.cell_begin[c];
+    auto const end = soa.cell_end[c];
+
+    for (auto i = begin; i < end; i++) {
+      auto const row = table.data() + soa.type[i] * n_types;
+
+      /* Pairs in this cell */
+      pair_row<with_coulomb>(soa, i, i + 1, end, row, coulomb_params);
+
+      /* Pairs with neighbors */
+      for (auto n = soa.neighbor_begin[c]; n < soa.neighbor_begin[c + 1];
+           n++) {
+        auto const neighbor = soa.neighbors[n];
+        pair_row<with_coulomb>(soa, i, soa.cell_begin[neighbor],
+                               soa.cell_end[neighbor], row,
+                               coulomb_params);
+      }
+    }
+  }
+}
+} // namespace
+
+bool soa_pair_forces_applicable(ParticleRange const &particles,
+                                bool exclusions_in_list) {
+  /* Only Lennard-Jones without offset and WCA are supported. */
+  for (auto const &ia : ia_params) {
+    auto other = ia;
+#ifdef LENNARD_JONES
+    if (ia.lj.offset != 0.)
+      return false;
+    other.lj = LJ_Parameters{};
+#endif
+#ifdef WCA
+    other.wca = WCA_Parameters{};
+#endif
+    if (recalc_maximal_cutoff(other) != INACTIVE_CUTOFF)
+      return false;
+  }
+
+#ifdef ELECTROSTATICS
+  switch (coulomb.method) {
+  case COULOMB_NONE:
+#ifdef P3M
+  case COULOMB_P3M:
+  case COULOMB_P3M_GPU:
+#endif
+    break;
+  default:
+    return false;
+  }
+#endif
+
+#ifdef DIPOLES
+  if (dipole.method != DIPOLAR_NONE)
+    return false;
+#endif
+
+#ifdef DPD
+  if (thermo_switch & THERMO_DPD)
+    return false;
+#endif
+
+#ifdef NPT
+  if (integ_switch == INTEG_METHOD_NPT_ISO)
+    return false;
+#endif
+
+#ifdef COLLISION_DETECTION
+  if (collision_params.mode != COLLISION_MODE_OFF)
+    return false;
+#endif
+
+#ifdef EXCLUSIONS
+  if (not exclusions_in_list) {
+    for (auto const &p : particles) {
+      if (not p.exclusions().empty())
+        return false;
+    }
+  }
+#else
+  static_cast<void>(particles);
+  static_cast<void>(exclusions_in_list);
+#endif
+
+  return true;
+}
+
+namespace {
+CoulombParameters coulomb_parameters() {
+  CoulombParameters coulomb_params{};
+#ifdef P3M
+  if (coulomb.method == COULOMB_P3M or coulomb.method == COULOMB_P3M_GPU) {
+    coulomb_params.prefactor = coulomb.prefactor;
+    coulomb_params.alpha = p3m.params.alpha;
+    coulomb_params.r_cut2 = cutoff2(p3m.params.r_cut);
+  }
+#endif
+  return coulomb_params;
+}
+
+bool with_coulomb(CoulombParameters const &coulomb_params) {
+  return coulomb_params.r_cut2 > 0. and coulomb_params.prefactor != 0.;
+}
+} // namespace
+
+void soa_pair_forces(ParticleSoA &soa) {
+  auto const n_types = max_seen_particle_type;
+  auto const table = pair_parameter_table(n_types);
+  auto const coulomb_params = coulomb_parameters();
+
+  if (with_coulomb(coulomb_params)) {
+    pair_forces<true>(soa, table, n_types, coulomb_params);
+  } else {
+    pair_forces<false>(soa, table, n_types, coulomb_params);
+  }
+}
+
+void soa_pair_forces(ParticleSoA &soa, ClusterPairList const &pairs) {
+  auto const n_types = max_seen_particle_type;
+  auto const table = pair_parameter_table(n_types);
+  auto const coulomb_params = coulomb_parameters();
+
+  if (with_coulomb(coulomb_params)) {
+    cluster_pair_forces<true>(soa, pairs, table, n_types, coulomb_params);
+  } else {
+    cluster_pair_forces<false>(soa, pairs, table, n_types, coulomb_params);
+  }
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SOA_PAIR_KERNELS_HPP
+#define SOA_PAIR_KERNELS_HPP
+/** \file
+ *  Non-bonded pair forces on the structure-of-arrays mirror
+ *  of the particle data, see @ref ParticleSoA.
+ *
+ *  The kernels cover Lennard-Jones (without offset), WCA and the
+ *  real-space part of P3M. The inner loops run with unit stride over
+ *  the particles of a neighbor cell and are written such that the
+ *  compiler can vectorize them for the target instruction set.
+ *  All other interactions are handled by the generic
+ *  @ref add_non_bonded_pair_force, which has to be used whenever
+ *  @ref soa_pair_forces_applicable returns false.
+ *
+ *  Implementation in \ref soa_pair_kernels.cpp.
+ */
+
+#include "ClusterPairList.hpp"
+#include "ParticleRange.hpp"
+#include "ParticleSoA.hpp"
+
+/**
+ * @brief Check whether @ref soa_pair_forces reproduces the
+ *        non-bonded forces for the current interactions.
+ *
+ * @param particles Local particles, checked for exclusions.
+ * @param exclusions_in_list The kernel runs on a @ref ClusterPairList,
+ *        which takes care of the exclusions.
+ */
+bool soa_pair_forces_applicable(ParticleRange const &particles,
+                                bool exclusions_in_list);
+
+/**
+ * @brief Add the non-bonded pair forces between all particles of
+ *        the mirror to its force arrays.
+ */
+void soa_pair_forces(ParticleSoA &soa);
+
+/**
+ * @brief Add the non-bonded pair forces between the particle pairs
+ *        of a cluster-pair list to the force arrays of the mirror.
+ */
+void soa_pair_forces(ParticleSoA &soa, ClusterPairList const &pairs);
+
+#endif
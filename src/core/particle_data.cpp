@@ -26,6 +26,7 @@
 #include "particle_data.hpp"
 
 #include "Particle.hpp"
+#include "ParticleDirectory.hpp"
 #include "cells.hpp"
 #include "communication.hpp"
 #include "event.hpp"
@@ -46,14 +47,19 @@
 #include <boost/optional.hpp>
 #include <boost/range/algorithm.hpp>
 #include <boost/range/numeric.hpp>
+#include <boost/serialization/utility.hpp>
 #include <boost/serialization/variant.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/variant.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <numeric>
+#include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace {
 /**
@@ -86,8 +92,12 @@ template <typename T, T ParticleMomentum ::*m>
 using UpdateMomentum = UpdateParticle<ParticleMomentum, &Particle::m, T, m>;
 template <typename T, T ParticleForce ::*m>
 using UpdateForce = UpdateParticle<ParticleForce, &Particle::f, T, m>;
+template <typename T, T ParticleColdProperties ::*m>
+using UpdateColdProperty =
+    UpdateParticle<ParticleColdProperties, &Particle::c, T, m>;
 
 using Prop = ParticleProperties;
+using ColdProp = ParticleColdProperties;
 
 // clang-format off
 using UpdatePropertyMessage = boost::variant
@@ -105,41 +115,44 @@ using UpdatePropertyMessage = boost::variant
 #ifdef ELECTROSTATICS
         , UpdateProperty<double, &Prop::q>
 #endif
-#ifdef LB_ELECTROHYDRODYNAMICS
-        , UpdateProperty<Utils::Vector3d, &Prop::mu_E>
-#endif
-#ifdef ENGINE
-        , UpdateProperty<ParticleParametersSwimming, &Prop::swim>
-#endif
 #ifdef DIPOLES
         , UpdateProperty<double, &Prop::dipm>
 #endif
 #ifdef VIRTUAL_SITES
         , UpdateProperty<bool, &Prop::is_virtual>
-#ifdef VIRTUAL_SITES_RELATIVE
-        , UpdateProperty<ParticleProperties::VirtualSitesRelativeParameters,
-                         &Prop::vs_relative>
 #endif
+#ifdef EXTERNAL_FORCES
+        , UpdateProperty<uint8_t, &Prop::ext_flag>
+#endif
+#ifdef LB_ELECTROHYDRODYNAMICS
+        , UpdateColdProperty<Utils::Vector3d, &ColdProp::mu_E>
+#endif
+#ifdef ENGINE
+        , UpdateColdProperty<ParticleParametersSwimming, &ColdProp::swim>
+#endif
+#ifdef VIRTUAL_SITES_RELATIVE
+        , UpdateColdProperty<
+              ParticleProperties::VirtualSitesRelativeParameters,
+              &ColdProp::vs_relative>
 #endif
 #ifdef THERMOSTAT_PER_PARTICLE
 #ifndef PARTICLE_ANISOTROPY
-        , UpdateProperty<double, &Prop::gamma>
+        , UpdateColdProperty<double, &ColdProp::gamma>
 #else
-        , UpdateProperty<Utils::Vector3d, &Prop::gamma>
+        , UpdateColdProperty<Utils::Vector3d, &ColdProp::gamma>
 #endif // PARTICLE_ANISOTROPY
 #ifdef ROTATION
 #ifndef PARTICLE_ANISOTROPY
-        , UpdateProperty<double, &Prop::gamma_rot>
+        , UpdateColdProperty<double, &ColdProp::gamma_rot>
 #else
-        , UpdateProperty<Utils::Vector3d, &Prop::gamma_rot>
+        , UpdateColdProperty<Utils::Vector3d, &ColdProp::gamma_rot>
 #endif // PARTICLE_ANISOTROPY
 #endif // ROTATION
 #endif // THERMOSTAT_PER_PARTICLE
 #ifdef EXTERNAL_FORCES
-        , UpdateProperty<uint8_t, &Prop::ext_flag>
-        , UpdateProperty<Utils::Vector3d, &Prop::ext_force>
+        , UpdateColdProperty<Utils::Vector3d, &ColdProp::ext_force>
 #ifdef ROTATION
-        , UpdateProperty<Utils::Vector3d, &Prop::ext_torque>
+        , UpdateColdProperty<Utils::Vector3d, &ColdProp::ext_torque>
 #endif
 #endif
         >;
@@ -284,6 +297,10 @@ template <> struct message_type<ParticleForce, &Particle::f> {
   using type = UpdateForceMessage;
 };
 
+template <> struct message_type<ParticleColdProperties, &Particle::c> {
+  using type = UpdatePropertyMessage;
+};
+
 template <typename S, S Particle::*s>
 using message_type_t = typename message_type<S, s>::type;
 
@@ -375,6 +392,68 @@ void mpi_update_particle_property(int id, const T &value) {
   mpi_update_particle<ParticleProperties, &Particle::p, T, m>(id, value);
 }
 
+template <typename T, T ParticleColdProperties::*m>
+void mpi_update_particle_cold_property(int id, const T &value) {
+  mpi_update_particle<ParticleColdProperties, &Particle::c, T, m>(id, value);
+}
+
+/** Update messages for several particles, one list per rank. */
+using UpdateMessages = std::vector<std::pair<int, UpdateMessage>>;
+
+static void scatter_update_messages(std::vector<UpdateMessages> const &in) {
+  UpdateMessages updates;
+  boost::mpi::scatter(comm_cart, in, updates, 0);
+
+  for (auto const &update : updates) {
+    boost::apply_visitor(UpdateVisitor{update.first}, update.second);
+  }
+
+  on_particle_change();
+}
+
+void mpi_send_update_messages_local() {
+  scatter_update_messages(std::vector<UpdateMessages>{});
+}
+
+REGISTER_CALLBACK(mpi_send_update_messages_local)
+
+std::vector<int> lookup_particle_nodes(Utils::Span<const int> ids);
+
+/**
+ * @brief Update one member of many particles.
+ *
+ * The updates are grouped by the rank that is responsible for the
+ * particle, and every rank receives all of its updates in one message
+ * of a single scatter.
+ *
+ * @param ids Ids of the particles to update
+ * @param values New values, one per id
+ */
+template <typename S, S Particle::*s, typename T, T S::*m>
+void mpi_update_particles(std::vector<int> const &ids,
+                          std::vector<T> const &values) {
+  if (ids.size() != values.size())
+    throw std::invalid_argument("Need one value per particle id.");
+
+  lookup_particle_nodes(ids);
+
+  using MessageType = message_type_t<S, s>;
+  std::vector<UpdateMessages> updates(comm_cart.size());
+  for (std::size_t i = 0; i < ids.size(); i++) {
+    MessageType msg = UpdateParticle<S, s, T, m>{values[i]};
+    updates[get_particle_node(ids[i])].emplace_back(ids[i], msg);
+  }
+
+  mpi_call(mpi_send_update_messages_local);
+  scatter_update_messages(updates);
+}
+
+template <typename T, T ParticleProperties::*m>
+void mpi_update_particles_property(std::vector<int> const &ids,
+                                   std::vector<T> const &values) {
+  mpi_update_particles<ParticleProperties, &Particle::p, T, m>(ids, values);
+}
+
 /************************************************
  * variables
  ************************************************/
@@ -385,8 +464,29 @@ void add_id_to_type_map(int part_id, int type);
 
 /**
  * @brief id -> rank
+ *
+ * Either the complete index, or a cache of the owners that were looked
+ * up in the @ref particle_directory since the last invalidation.
  */
 std::unordered_map<int, int> particle_node;
+/** Whether @ref particle_node contains all particles. */
+bool particle_node_complete = false;
+
+/**
+ * @brief Distributed id -> rank index.
+ *
+ * It is kept up to date when particles are created or removed, but
+ * only updated with the particles that moved between the ranks when
+ * an owner is looked up after the particles were redistributed.
+ */
+ParticleDirectory particle_directory;
+/** Whether particles might have moved since the last directory update. */
+bool particle_directory_stale = true;
+/** Number of single lookups in the directory since the last invalidation. */
+int particle_directory_lookups = 0;
+/** Number of single lookups after which the complete index is built,
+ *  because it is cheaper for the remaining ones. */
+int const max_particle_directory_lookups = 64;
 
 void delete_exclusion(Particle *part, int part2);
 
@@ -445,7 +545,110 @@ void mpi_who_has() {
 /**
  * @brief Rebuild the particle index.
  */
-void build_particle_node() { mpi_who_has(); }
+void build_particle_node() {
+  mpi_who_has();
+  particle_node_complete = true;
+}
+
+void mpi_update_particle_directory_local() {
+  static std::vector<int> ids;
+  ids.clear();
+  for (auto const &p : cell_structure.local_particles())
+    ids.push_back(p.identity());
+
+  particle_directory.update(comm_cart, ids);
+}
+
+REGISTER_CALLBACK(mpi_update_particle_directory_local)
+
+/**
+ * @brief Report the particles that moved to the home ranks of the
+ * directory, if any could have moved since the last update.
+ */
+void update_particle_directory() {
+  if (particle_directory_stale) {
+    mpi_call_all(mpi_update_particle_directory_local);
+    particle_directory_stale = false;
+  }
+}
+
+boost::optional<int> mpi_particle_directory_owner_local(int id) {
+  if (ParticleDirectory::home(id, comm_cart.size()) == comm_cart.rank())
+    return particle_directory.owner(id);
+  return {};
+}
+
+REGISTER_CALLBACK_ONE_RANK(mpi_particle_directory_owner_local)
+
+void mpi_particle_directory_owners_local() {
+  particle_directory.owners(comm_cart, {});
+}
+
+REGISTER_CALLBACK(mpi_particle_directory_owners_local)
+
+/**
+ * @brief Look up the owner of a particle on its home rank.
+ *
+ * @return The rank of the particle, or -1 if it does not exist.
+ */
+int lookup_particle_node(int id) {
+  auto const needle = particle_node.find(id);
+  if (needle != particle_node.end())
+    return needle->second;
+  if (particle_node_complete)
+    return -1;
+  if (comm_cart.size() == 1 or
+      ++particle_directory_lookups > max_particle_directory_lookups) {
+    build_particle_node();
+    return particle_node.count(id) ? particle_node.at(id) : -1;
+  }
+
+  update_particle_directory();
+  auto const pnode = mpi_call(Communication::Result::one_rank,
+                              mpi_particle_directory_owner_local, id);
+  if (pnode >= 0)
+    particle_node[id] = pnode;
+
+  return pnode;
+}
+
+/**
+ * @brief Look up the owners of several particles at once, so that
+ * the following calls of @ref get_particle_node for them are local.
+ *
+ * @return The ranks of the particles, -1 for particles that do not exist.
+ */
+std::vector<int> lookup_particle_nodes(Utils::Span<const int> ids) {
+  if (comm_cart.size() == 1 and not particle_node_complete)
+    build_particle_node();
+
+  std::vector<int> nodes(ids.size(), -1);
+  std::vector<std::size_t> missing;
+  for (std::size_t i = 0; i < ids.size(); i++) {
+    auto const needle = particle_node.find(ids[i]);
+    if (needle != particle_node.end())
+      nodes[i] = needle->second;
+    else if (ids[i] >= 0 and not particle_node_complete)
+      missing.push_back(i);
+  }
+  if (missing.empty())
+    return nodes;
+
+  std::vector<int> missing_ids(missing.size());
+  std::transform(missing.begin(), missing.end(), missing_ids.begin(),
+                 [&ids](std::size_t i) { return ids[i]; });
+
+  update_particle_directory();
+  mpi_call(mpi_particle_directory_owners_local);
+  auto const owners = particle_directory.owners(comm_cart, missing_ids);
+  for (std::size_t j = 0; j < missing.size(); j++) {
+    nodes[missing[j]] = owners[j];
+    if (owners[j] >= 0)
+      particle_node[missing_ids[j]] = owners[j];
+  }
+
+  return nodes;
+}
 
 /**
  *  @brief Get the mpi rank which owns the particle with id.
@@ -454,8 +657,7 @@ int get_particle_node(int id) {
   if (id < 0)
     throw std::runtime_error("Invalid particle id!");
 
-  if (particle_node.empty())
-    build_particle_node();
+  lookup_particle_node(id);
 
   auto const needle = particle_node.find(id);
 
@@ -467,7 +669,12 @@ int get_particle_node(int id) {
   return needle->second;
 }
 
-void clear_particle_node() { particle_node.clear(); }
+void clear_particle_node() {
+  particle_node.clear();
+  particle_node_complete = false;
+  particle_directory_stale = true;
+  particle_directory_lookups = 0;
+}
 
 namespace {
 /* Limit cache to 100 MiB */
@@ -537,6 +744,7 @@ REGISTER_CALLBACK(mpi_get_particles_local)
  * @returns The particle list.
  */
 std::vector<Particle> mpi_get_particles(Utils::Span<const int> ids) {
+  lookup_particle_nodes(ids);
   mpi_call(mpi_get_particles_local, 0, 0);
   /* Return value */
   std::vector<Particle> parts(ids.size());
@@ -584,6 +792,8 @@ void prefetch_particle_data(Utils::Span<const int> in_ids) {
   if (comm_cart.size() == 1)
     return;
 
+  lookup_particle_nodes(in_ids);
+
   static std::vector<int> ids;
   ids.clear();
 
@@ -602,6 +812,151 @@ void prefetch_particle_data(Utils::Span<const int> in_ids) {
   }
 }
 
+namespace {
+/** Particle properties that can be gathered into contiguous arrays. */
+enum GatheredProperty : int {
+  GATHER_POSITION,
+  GATHER_VELOCITY,
+  GATHER_FORCE,
+  GATHER_TYPE
+};
+
+/**
+ * @brief Gather a local range of values on the head node.
+ *
+ * Utils::Mpi::gatherv skips null input buffers, which an empty vector
+ * may have, so ranks without values send from a dummy element.
+ */
+template <class T>
+void gatherv_local(std::vector<T> const &local, T *out = nullptr,
+                   int const *sizes = nullptr) {
+  T const empty{};
+  auto const in = local.empty() ? &empty : local.data();
+  auto const size = static_cast<int>(local.size());
+  if (comm_cart.rank() == 0) {
+    Utils::Mpi::gatherv(comm_cart, in, size, out, sizes, 0);
+  } else {
+    Utils::Mpi::gatherv(comm_cart, in, size, 0);
+  }
+}
+
+/**
+ * @brief Gather one property of all particles on the head node.
+ *
+ * Every rank packs the ids and the values of its local particles into
+ * flat arrays, which are collected with one gatherv each. The head
+ * node then sorts the values by particle id.
+ *
+ * @tparam T Type of the values.
+ * @tparam N Number of values per particle.
+ * @param get Callable with (Particle const &, T *) that writes the
+ *            values of a particle.
+ * @param[out] ids The ids of all particles in ascending order on the
+ *                 head node, untouched on the other ranks.
+ * @return The values of all particles in the order of @p ids on the
+ *         head node, nothing on the other ranks.
+ */
+template <class T, std::size_t N, class Getter>
+std::vector<T> gather_particle_property(Getter get, std::vector<int> &ids) {
+  auto const particles = cell_structure.local_particles();
+  std::vector<int> local_ids(particles.size());
+  std::vector<T> local_values(N * particles.size());
+
+  std::size_t i = 0;
+  for (auto const &p : particles) {
+    local_ids[i] = p.identity();
+    get(p, local_values.data() + N * i);
+    i++;
+  }
+
+  std::vector<int> sizes;
+  boost::mpi::gather(comm_cart, static_cast<int>(local_ids.size()), sizes, 0);
+
+  if (comm_cart.rank() != 0) {
+    gatherv_local(local_ids);
+    gatherv_local(local_values);
+    return {};
+  }
+
+  auto const n_part = boost::accumulate(sizes, 0);
+  std::vector<int> all_ids(n_part);
+  gatherv_local(local_ids, all_ids.data(), sizes.data());
+  for (auto &size : sizes) {
+    size *= N;
+  }
+  std::vector<T> all_values(N * n_part);
+  gatherv_local(local_values, all_values.data(), sizes.data());
+
+  std::vector<int> order(n_part);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&all_ids](int a, int b) { return all_ids[a] < all_ids[b]; });
+
+  ids.resize(n_part);
+  std::vector<T> result(N * n_part);
+  for (std::size_t k = 0; k < order.size(); k++) {
+    ids[k] = all_ids[order[k]];
+    std::copy_n(all_values.data() + N * order[k], N, result.data() + N * k);
+  }
+
+  return result;
+}
+
+auto const get_position = [](Particle const &p, double *out) {
+  auto const pos = unfolded_position(p.r.p, p.l.i, box_geo.length());
+  std::copy(pos.begin(), pos.end(), out);
+};
+auto const get_velocity = [](Particle const &p, double *out) {
+  std::copy(p.m.v.begin(), p.m.v.end(), out);
+};
+auto const get_force = [](Particle const &p, double *out) {
+  std::copy(p.f.f.begin(), p.f.f.end(), out);
+};
+auto const get_type = [](Particle const &p, int *out) { *out = p.p.type; };
+} // namespace
+
+void mpi_gather_particle_property_local(int property) {
+  std::vector<int> ids;
+  switch (property) {
+  case GATHER_POSITION:
+    gather_particle_property<double, 3>(get_position, ids);
+    break;
+  case GATHER_VELOCITY:
+    gather_particle_property<double, 3>(get_velocity, ids);
+    break;
+  case GATHER_FORCE:
+    gather_particle_property<double, 3>(get_force, ids);
+    break;
+  case GATHER_TYPE:
+    gather_particle_property<int, 1>(get_type, ids);
+    break;
+  default:
+    assert(false);
+  }
+}
+
+REGISTER_CALLBACK(mpi_gather_particle_property_local)
+
+std::vector<double> gather_particle_positions(std::vector<int> &ids) {
+  mpi_call(mpi_gather_particle_property_local, GATHER_POSITION);
+  return gather_particle_property<double, 3>(get_position, ids);
+}
+
+std::vector<double> gather_particle_velocities(std::vector<int> &ids) {
+  mpi_call(mpi_gather_particle_property_local, GATHER_VELOCITY);
+  return gather_particle_property<double, 3>(get_velocity, ids);
+}
+
+std::vector<double> gather_particle_forces(std::vector<int> &ids) {
+  mpi_call(mpi_gather_particle_property_local, GATHER_FORCE);
+  return gather_particle_property<double, 3>(get_force, ids);
+}
+
+std::vector<int> gather_particle_types(std::vector<int> &ids) {
+  mpi_call(mpi_gather_particle_property_local, GATHER_TYPE);
+  return gather_particle_property<int, 1>(get_type, ids);
+}
+
 /** Move a particle to a new position. If it does not exist, it is created.
  *  The position must be on the local node!
  *
@@ -635,6 +990,7 @@ Particle *local_place_particle(int id, const Utils::Vector3d &pos, int _new) {
 boost::optional<int> mpi_place_new_particle_local(int p_id,
                                                   Utils::Vector3d const &pos) {
   auto p = local_place_particle(p_id, pos, 1);
+  particle_directory.add(comm_cart, p_id, p != nullptr);
   on_particle_change();
   if (p) {
     return comm_cart.rank();
@@ -699,15 +1055,80 @@ int place_particle(int p_id, const double *pos) {
   return ES_PART_CREATED;
 }
 
+/** Insert the particles scattered by the head node and sort them
+ *  into the cells. */
+static void
+scatter_new_particles(std::vector<std::vector<Particle>> &send_buf) {
+  std::vector<Particle> particles;
+  boost::mpi::scatter(comm_cart, send_buf, particles, 0);
+
+  for (auto &p : particles) {
+    fold_position(p.r.p, p.l.i, box_geo);
+    cell_structure.add_particle(std::move(p));
+  }
+  cell_structure.resort_particles(CELL_GLOBAL_EXCHANGE);
+
+  on_particle_change();
+}
+
+void mpi_place_new_particles_local() {
+  std::vector<std::vector<Particle>> send_buf;
+  scatter_new_particles(send_buf);
+}
+
+REGISTER_CALLBACK(mpi_place_new_particles_local)
+
+void place_new_particles(std::vector<Particle> particles) {
+  std::vector<int> new_ids(particles.size());
+  std::transform(particles.begin(), particles.end(), new_ids.begin(),
+                 [](Particle const &p) { return p.identity(); });
+  auto const nodes = lookup_particle_nodes(new_ids);
+
+  std::unordered_set<int> ids;
+  for (std::size_t i = 0; i < particles.size(); i++) {
+    auto const id = particles[i].identity();
+    if (id < 0)
+      throw std::runtime_error("Invalid particle id!");
+    if (nodes[i] >= 0 or not ids.insert(id).second)
+      throw std::runtime_error("Particle " + std::to_string(id) +
+                               " already exists.");
+  }
+
+  std::unordered_set<int> types;
+  std::vector<std::vector<Particle>> send_buf(comm_cart.size());
+  for (auto &p : particles) {
+    types.insert(p.p.type);
+    if (type_list_enable)
+      add_id_to_type_map(p.identity(), p.p.type);
+    auto const node = map_position_node_array(p.r.p);
+    send_buf[node].emplace_back(std::move(p));
+  }
+  for (auto const type : types) {
+    make_particle_type_exist(type);
+  }
+
+  mpi_call(mpi_place_new_particles_local);
+  scatter_new_particles(send_buf);
+
+  /* The particles might have moved on in the resort */
+  clear_particle_node();
+}
+
 void set_particle_v(int part, double *v) {
   mpi_update_particle<ParticleMomentum, &Particle::m, Utils::Vector3d,
                       &ParticleMomentum::v>(part, Utils::Vector3d(v, v + 3));
 }
 
+void set_particles_v(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &v) {
+  mpi_update_particles<ParticleMomentum, &Particle::m, Utils::Vector3d,
+                       &ParticleMomentum::v>(ids, v);
+}
+
 #ifdef ENGINE
 void set_particle_swimming(int part, ParticleParametersSwimming swim) {
-  mpi_update_particle_property<ParticleParametersSwimming,
-                               &ParticleProperties::swim>(part, swim);
+  mpi_update_particle_cold_property<ParticleParametersSwimming,
+                                    &ParticleColdProperties::swim>(part, swim);
 }
 #endif
 
@@ -716,10 +1137,21 @@ void set_particle_f(int part, const Utils::Vector3d &F) {
                       &ParticleForce::f>(part, F);
 }
 
+void set_particles_f(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &F) {
+  mpi_update_particles<ParticleForce, &Particle::f, Utils::Vector3d,
+                       &ParticleForce::f>(ids, F);
+}
+
 #if defined(MASS)
 void set_particle_mass(int part, double mass) {
   mpi_update_particle_property<double, &ParticleProperties::mass>(part, mass);
 }
+
+void set_particles_mass(std::vector<int> const &ids,
+                        std::vector<double> const &mass) {
+  mpi_update_particles_property<double, &ParticleProperties::mass>(ids, mass);
+}
 #else
 const constexpr double ParticleProperties::mass;
 #endif
@@ -770,12 +1202,12 @@ void set_particle_virtual(int part, bool is_virtual) {
 #ifdef VIRTUAL_SITES_RELATIVE
 void set_particle_vs_quat(int part,
                           Utils::Quaternion<double> const &vs_relative_quat) {
-  auto vs_relative = get_particle_data(part).p.vs_relative;
+  auto vs_relative = get_particle_data(part).c.vs_relative;
   vs_relative.quat = vs_relative_quat;
 
-  mpi_update_particle_property<
+  mpi_update_particle_cold_property<
       ParticleProperties::VirtualSitesRelativeParameters,
-      &ParticleProperties::vs_relative>(part, vs_relative);
+      &ParticleColdProperties::vs_relative>(part, vs_relative);
 }
 
 void set_particle_vs_relative(int part, int vs_relative_to, double vs_distance,
@@ -785,9 +1217,9 @@ void set_particle_vs_relative(int part, int vs_relative_to, double vs_distance,
   vs_relative.to_particle_id = vs_relative_to;
   vs_relative.rel_orientation = rel_ori;
 
-  mpi_update_particle_property<
+  mpi_update_particle_cold_property<
       ParticleProperties::VirtualSitesRelativeParameters,
-      &ParticleProperties::vs_relative>(part, vs_relative);
+      &ParticleColdProperties::vs_relative>(part, vs_relative);
 }
 #endif
 
@@ -797,19 +1229,26 @@ void set_particle_q(int part, double q) {
 #endif
 }
 
+void set_particles_q(std::vector<int> const &ids,
+                     std::vector<double> const &q) {
+#ifdef ELECTROSTATICS
+  mpi_update_particles_property<double, &ParticleProperties::q>(ids, q);
+#endif
+}
+
 #ifndef ELECTROSTATICS
 const constexpr double ParticleProperties::q;
 #endif
 
 #ifdef LB_ELECTROHYDRODYNAMICS
 void set_particle_mu_E(int part, Utils::Vector3d const &mu_E) {
-  mpi_update_particle_property<Utils::Vector3d, &ParticleProperties::mu_E>(
-      part, mu_E);
+  mpi_update_particle_cold_property<Utils::Vector3d,
+                                    &ParticleColdProperties::mu_E>(part, mu_E);
 }
 
 void get_particle_mu_E(int part, Utils::Vector3d &mu_E) {
   auto const &p = get_particle_data(part);
-  mu_E = p.p.mu_E;
+  mu_E = p.c.mu_E;
 }
 #endif
 
@@ -831,10 +1270,35 @@ void set_particle_type(int p_id, int type) {
   mpi_update_particle_property<int, &ParticleProperties::type>(p_id, type);
 }
 
+void set_particles_type(std::vector<int> const &ids,
+                        std::vector<int> const &types) {
+  for (auto const type : std::unordered_set<int>(types.begin(), types.end())) {
+    make_particle_type_exist(type);
+  }
+
+  mpi_update_particles_property<int, &ParticleProperties::type>(ids, types);
+
+  if (type_list_enable) {
+    for (auto &kv : particle_type_map) {
+      for (auto const id : ids) {
+        kv.second.erase(id);
+      }
+    }
+    for (std::size_t i = 0; i < ids.size(); i++) {
+      add_id_to_type_map(ids[i], types[i]);
+    }
+  }
+}
+
 void set_particle_mol_id(int part, int mid) {
   mpi_update_particle_property<int, &ParticleProperties::mol_id>(part, mid);
 }
 
+void set_particles_mol_id(std::vector<int> const &ids,
+                          std::vector<int> const &mid) {
+  mpi_update_particles_property<int, &ParticleProperties::mol_id>(ids, mid);
+}
+
 #ifdef ROTATION
 void set_particle_quat(int part, double *quat) {
   mpi_update_particle<ParticlePosition, &Particle::r, Utils::Quaternion<double>,
@@ -873,24 +1337,27 @@ void set_particle_torque_lab(int part, const Utils::Vector3d &torque_lab) {
 #ifdef THERMOSTAT_PER_PARTICLE
 #ifndef PARTICLE_ANISOTROPY
 void set_particle_gamma(int part, double gamma) {
-  mpi_update_particle_property<double, &ParticleProperties::gamma>(part, gamma);
+  mpi_update_particle_cold_property<double, &ParticleColdProperties::gamma>(
+      part, gamma);
 }
 #else
 void set_particle_gamma(int part, Utils::Vector3d gamma) {
-  mpi_update_particle_property<Utils::Vector3d, &ParticleProperties::gamma>(
-      part, gamma);
+  mpi_update_particle_cold_property<Utils::Vector3d,
+                                    &ParticleColdProperties::gamma>(part,
+                                                                    gamma);
 }
 #endif // PARTICLE_ANISOTROPY
 
 #ifdef ROTATION
 #ifndef PARTICLE_ANISOTROPY
 void set_particle_gamma_rot(int part, double gamma_rot) {
-  mpi_update_particle_property<double, &ParticleProperties::gamma_rot>(
+  mpi_update_particle_cold_property<double, &ParticleColdProperties::gamma_rot>(
       part, gamma_rot);
 }
 #else
 void set_particle_gamma_rot(int part, Utils::Vector3d gamma_rot) {
-  mpi_update_particle_property<Utils::Vector3d, &ParticleProperties::gamma_rot>(
+  mpi_update_particle_cold_property<Utils::Vector3d,
+                                    &ParticleColdProperties::gamma_rot>(
       part, gamma_rot);
 }
 #endif // PARTICLE_ANISOTROPY
@@ -900,14 +1367,16 @@ void set_particle_gamma_rot(int part, Utils::Vector3d gamma_rot) {
 #ifdef EXTERNAL_FORCES
 #ifdef ROTATION
 void set_particle_ext_torque(int part, const Utils::Vector3d &torque) {
-  mpi_update_particle_property<Utils::Vector3d,
-                               &ParticleProperties::ext_torque>(part, torque);
+  mpi_update_particle_cold_property<Utils::Vector3d,
+                                    &ParticleColdProperties::ext_torque>(
+      part, torque);
 }
 #endif
 
 void set_particle_ext_force(int part, const Utils::Vector3d &force) {
-  mpi_update_particle_property<Utils::Vector3d, &ParticleProperties::ext_force>(
-      part, force);
+  mpi_update_particle_cold_property<Utils::Vector3d,
+                                    &ParticleColdProperties::ext_force>(part,
+                                                                        force);
 }
 
 void set_particle_fix(int part, uint8_t flag) {
@@ -942,8 +1411,10 @@ const std::vector<BondView> &get_particle_bonds(int part) {
 void mpi_remove_particle_local(int, int part) {
   if (part != -1) {
     cell_structure.remove_particle(part);
+    particle_directory.remove(part);
   } else {
     cell_structure.remove_all_particles();
+    particle_directory.clear();
   }
   on_particle_change();
 }
@@ -979,6 +1450,38 @@ int remove_particle(int p_id) {
   return ES_OK;
 }
 
+void mpi_remove_particles_local(std::vector<int> const &ids) {
+  cell_structure.remove_particles(ids);
+  for (auto const id : ids)
+    particle_directory.remove(id);
+  on_particle_change();
+}
+
+REGISTER_CALLBACK(mpi_remove_particles_local)
+
+void remove_particles(std::vector<int> const &ids) {
+  auto const nodes = lookup_particle_nodes(ids);
+  for (std::size_t i = 0; i < ids.size(); i++) {
+    if (nodes[i] < 0)
+      throw std::runtime_error("Particle " + std::to_string(ids[i]) +
+                               " does not exist.");
+  }
+
+  if (type_list_enable) {
+    for (auto &kv : particle_type_map) {
+      for (auto const id : ids) {
+        kv.second.erase(id);
+      }
+    }
+  }
+
+  mpi_call_all(mpi_remove_particles_local, ids);
+
+  for (auto const id : ids) {
+    particle_node.erase(id);
+  }
+}
+
 /** Locally rescale all particles on current node.
  *  @param dir   direction to scale (0/1/2 = x/y/z, 3 = x+y+z isotropically)
  *  @param scale factor by which to rescale (>1: stretch, <1: contract)
@@ -1212,14 +1715,14 @@ void pointer_to_virtual(Particle const *p, bool const *&res) {
 
 #ifdef VIRTUAL_SITES_RELATIVE
 void pointer_to_vs_quat(Particle const *p, double const *&res) {
-  res = (p->p.vs_relative.quat.data());
+  res = (p->c.vs_relative.quat.data());
 }
 
 void pointer_to_vs_relative(Particle const *p, int const *&res1,
                             double const *&res2, double const *&res3) {
-  res1 = &(p->p.vs_relative.to_particle_id);
-  res2 = &(p->p.vs_relative.distance);
-  res3 = p->p.vs_relative.rel_orientation.data();
+  res1 = &(p->c.vs_relative.to_particle_id);
+  res2 = &(p->c.vs_relative.distance);
+  res3 = p->c.vs_relative.rel_orientation.data();
 }
 #endif
 
@@ -1232,11 +1735,11 @@ void pointer_to_dipm(Particle const *p, double const *&res) {
 
 #ifdef EXTERNAL_FORCES
 void pointer_to_ext_force(Particle const *p, double const *&res2) {
-  res2 = p->p.ext_force.data();
+  res2 = p->c.ext_force.data();
 }
 #ifdef ROTATION
 void pointer_to_ext_torque(Particle const *p, double const *&res2) {
-  res2 = p->p.ext_torque.data();
+  res2 = p->c.ext_torque.data();
 }
 #endif
 void pointer_to_fix(Particle const *p, const uint8_t *&res) {
@@ -1247,18 +1750,18 @@ void pointer_to_fix(Particle const *p, const uint8_t *&res) {
 #ifdef THERMOSTAT_PER_PARTICLE
 void pointer_to_gamma(Particle const *p, double const *&res) {
 #ifndef PARTICLE_ANISOTROPY
-  res = &(p->p.gamma);
+  res = &(p->c.gamma);
 #else
-  res = p->p.gamma.data(); // array [3]
+  res = p->c.gamma.data(); // array [3]
 #endif // PARTICLE_ANISTROPY
 }
 
 #ifdef ROTATION
 void pointer_to_gamma_rot(Particle const *p, double const *&res) {
 #ifndef PARTICLE_ANISOTROPY
-  res = &(p->p.gamma_rot);
+  res = &(p->c.gamma_rot);
 #else
-  res = p->p.gamma_rot.data(); // array [3]
+  res = p->c.gamma_rot.data(); // array [3]
 #endif // ROTATIONAL_INERTIA
 }
 #endif // ROTATION
@@ -1268,7 +1771,7 @@ void pointer_to_gamma_rot(Particle const *p, double const *&res) {
 #ifdef ENGINE
 void pointer_to_swimming(Particle const *p,
                          ParticleParametersSwimming const *&swim) {
-  swim = &(p->p.swim);
+  swim = &(p->c.swim);
 }
 #endif
 
@@ -1279,13 +1782,13 @@ void pointer_to_rotational_inertia(Particle const *p, double const *&res) {
 #endif
 
 bool particle_exists(int part_id) {
-  if (particle_node.empty())
-    build_particle_node();
-  return particle_node.count(part_id);
+  if (part_id < 0)
+    return false;
+  return lookup_particle_node(part_id) >= 0;
 }
 
 std::vector<int> get_particle_ids() {
-  if (particle_node.empty())
+  if (not particle_node_complete)
     build_particle_node();
 
   auto ids = Utils::keys(particle_node);
@@ -1295,7 +1798,7 @@ std::vector<int> get_particle_ids() {
 }
 
 int get_maximal_particle_id() {
-  if (particle_node.empty())
+  if (not particle_node_complete)
     build_particle_node();
 
   return boost::accumulate(particle_node, -1,
@@ -1305,7 +1808,7 @@ int get_maximal_particle_id() {
 }
 
 int get_n_part() {
-  if (particle_node.empty())
+  if (not particle_node_complete)
     build_particle_node();
 
   return static_cast<int>(particle_node.size());
@@ -45,6 +45,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 /************************************************
  * defines
@@ -91,6 +92,24 @@ const Particle &get_particle_data(int part);
  */
 void prefetch_particle_data(Utils::Span<const int> ids);
 
+/** @name Contiguous particle arrays
+ *  Call only on the master node.
+ *  Gather one property of all particles into a flat array, in the order
+ *  of ascending particle ids, which are written to @p ids. Every rank
+ *  sends the ids and values of its local particles in one gatherv each,
+ *  so these are much cheaper than fetching the particles one by one.
+ */
+/**@{*/
+/** Unfolded positions, three coordinates per particle. */
+std::vector<double> gather_particle_positions(std::vector<int> &ids);
+/** Velocities, three components per particle. */
+std::vector<double> gather_particle_velocities(std::vector<int> &ids);
+/** Forces, three components per particle. */
+std::vector<double> gather_particle_forces(std::vector<int> &ids);
+/** Types, one per particle. */
+std::vector<int> gather_particle_types(std::vector<int> &ids);
+/**@}*/
+
 /** @brief Invalidate the fetch cache for get_particle_data. */
 void invalidate_fetch_cache();
 
@@ -110,12 +129,29 @@ size_t fetch_cache_max_size();
  */
 int place_particle(int part, const double *p);
 
+/** Call only on the master node.
+ *  Create several particles at once. The particles are scattered to
+ *  the nodes that own their positions in one collective, and sorted
+ *  into the cells by a single resort.
+ *  @param particles The new particles with their identities, positions
+ *                   and properties. None of the identities may exist.
+ */
+void place_new_particles(std::vector<Particle> particles);
+
 /** Call only on the master node: set particle velocity.
  *  @param part the particle.
  *  @param v its new velocity.
  */
 void set_particle_v(int part, double *v);
 
+/** Call only on the master node: set the velocities of many particles,
+ *  with one message per node.
+ *  @param ids the particles.
+ *  @param v   their new velocities, one per particle.
+ */
+void set_particles_v(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &v);
+
 #ifdef ENGINE
 /** Call only on the master node: set particle velocity.
  *  @param part the particle.
@@ -130,12 +166,26 @@ void set_particle_swimming(int part, ParticleParametersSwimming swim);
  */
 void set_particle_f(int part, const Utils::Vector3d &F);
 
+/** Call only on the master node: set the forces of many particles.
+ *  @param ids the particles.
+ *  @param F   their new forces, one per particle.
+ */
+void set_particles_f(std::vector<int> const &ids,
+                     std::vector<Utils::Vector3d> const &F);
+
 /** Call only on the master node: set particle mass.
  *  @param part the particle.
  *  @param mass its new mass.
  */
 void set_particle_mass(int part, double mass);
 
+/** Call only on the master node: set the masses of many particles.
+ *  @param ids  the particles.
+ *  @param mass their new masses, one per particle.
+ */
+void set_particles_mass(std::vector<int> const &ids,
+                        std::vector<double> const &mass);
+
 #ifdef ROTATIONAL_INERTIA
 /** Call only on the master node: set particle rotational inertia.
  *  @param part the particle.
@@ -166,6 +216,12 @@ void rotate_particle(int part, const Utils::Vector3d &axis, double angle);
  */
 void set_particle_q(int part, double q);
 
+/** Call only on the master node: set the charges of many particles.
+ *  @param ids the particles.
+ *  @param q   their new charges, one per particle.
+ */
+void set_particles_q(std::vector<int> const &ids, std::vector<double> const &q);
+
 #ifdef LB_ELECTROHYDRODYNAMICS
 /** Call only on the master node: set particle electrophoretic mobility.
  *  @param part the particle.
@@ -181,12 +237,26 @@ void get_particle_mu_E(int part, Utils::Vector3d &mu_E);
  */
 void set_particle_type(int p_id, int type);
 
+/** Call only on the master node: set the types of many particles.
+ *  @param ids   the particles.
+ *  @param types their new types, one per particle.
+ */
+void set_particles_type(std::vector<int> const &ids,
+                        std::vector<int> const &types);
+
 /** Call only on the master node: set particle's molecule id.
  *  @param part the particle.
  *  @param mid  its new mol id.
  */
 void set_particle_mol_id(int part, int mid);
 
+/** Call only on the master node: set the molecule ids of many particles.
+ *  @param ids the particles.
+ *  @param mid their new mol ids, one per particle.
+ */
+void set_particles_mol_id(std::vector<int> const &ids,
+                          std::vector<int> const &mid);
+
 #ifdef ROTATION
 /** Call only on the master node: set particle orientation using quaternions.
  *  @param part the particle.
@@ -337,6 +407,13 @@ int remove_particle(int part);
 /** Remove all particles. */
 void remove_all_particles();
 
+/** Remove several particles with one collective. Also removes all bonds
+ *  to the particles.
+ *  @param ids      identities of the particles to remove, which have to
+ *                  exist
+ */
+void remove_particles(std::vector<int> const &ids);
+
 /** Rescale all particle positions in direction @p dir by a factor @p scale. */
 void mpi_rescale_particles(int dir, double scale);
 
@@ -102,7 +102,7 @@ void pressure_calc() {
       },
       [](Particle &p1, Particle &p2, Distance const &d) {
         add_non_bonded_pair_virials(p1, p2, d.vec21, sqrt(d.dist2),
-                                    obs_pressure);
+                                    d.excluded, obs_pressure);
       },
       maximal_cutoff());
 
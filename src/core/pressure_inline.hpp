@@ -35,7 +35,6 @@
 #include "Observable_stat.hpp"
 #include "Particle.hpp"
 #include "errorhandling.hpp"
-#include "exclusions.hpp"
 #include "forces_inline.hpp"
 
 #include <utils/Span.hpp>
@@ -52,15 +51,14 @@
  *  @param p2        pointer to particle 2.
  *  @param d         vector between p1 and p2.
  *  @param dist      distance between p1 and p2.
+ *  @param excluded  the pair is excluded from the pair potentials.
  *  @param[in,out] obs_pressure   pressure observable.
  */
 inline void add_non_bonded_pair_virials(Particle const &p1, Particle const &p2,
                                         Utils::Vector3d const &d, double dist,
+                                        bool excluded,
                                         Observable_stat &obs_pressure) {
-#ifdef EXCLUSIONS
-  if (do_nonbonded(p1, p2))
-#endif
-  {
+  if (not excluded) {
     IA_parameters const &ia_params = *get_ia_param(p1.p.type, p2.p.type);
     auto const force = calc_non_bonded_pair_force(p1, p2, ia_params, d, dist).f;
     auto const stress = tensor_product(d, force);
@@ -48,4 +48,100 @@ void short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
   if (distance_cutoff > 0.)
     cell_structure.non_bonded_loop(pair_kernel, verlet_criterion);
 }
+
+/**
+ * @brief Short-range loop with a separate kernel for the pairs
+ *        that are beyond the cutoff of the short-range interactions
+ *        of their types, see @ref CellStructure::use_pair_class_lists.
+ */
+template <class BondKernel, class PairKernel, class LongCutoffKernel,
+          class VerletCriterion>
+void short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
+                      LongCutoffKernel long_cutoff_kernel,
+                      double distance_cutoff,
+                      const VerletCriterion &verlet_criterion) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+
+  assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
+
+  cell_structure.bond_loop(bond_kernel);
+  if (distance_cutoff > 0.)
+    cell_structure.non_bonded_loop(pair_kernel, long_cutoff_kernel,
+                                   verlet_criterion);
+}
+
+/**
+ * @brief Short-range loop that runs the kernels in several threads,
+ *        if ESPResSo was built with OpenMP.
+ *
+ * The kernels may only modify the particles they are called with.
+ */
+template <class BondKernel, class PairKernel,
+          class VerletCriterion = detail::True>
+void parallel_short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
+                               double distance_cutoff,
+                               const VerletCriterion &verlet_criterion = {}) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+
+  assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
+
+  cell_structure.parallel_bond_loop(bond_kernel);
+  if (distance_cutoff > 0.)
+    cell_structure.parallel_non_bonded_loop(pair_kernel, verlet_criterion);
+}
+
+/**
+ * @brief Threaded short-range loop with a separate kernel for the
+ *        pairs that are beyond the cutoff of the short-range
+ *        interactions of their types.
+ */
+template <class BondKernel, class PairKernel, class LongCutoffKernel,
+          class VerletCriterion>
+void parallel_short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
+                               LongCutoffKernel long_cutoff_kernel,
+                               double distance_cutoff,
+                               const VerletCriterion &verlet_criterion) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+
+  assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
+
+  cell_structure.parallel_bond_loop(bond_kernel);
+  if (distance_cutoff > 0.)
+    cell_structure.parallel_non_bonded_loop(pair_kernel, long_cutoff_kernel,
+                                            verlet_criterion);
+}
+/**
+ * @brief Short-range loop that overlaps a pending ghost update,
+ *        see @ref CellStructure::split_non_bonded_loop.
+ *
+ * The bonds are done after the ghost update was finished.
+ *
+ * @param parallel Run the kernels in several threads, as in
+ *        @ref parallel_short_range_loop.
+ */
+template <class BondKernel, class PairKernel, class LongCutoffKernel,
+          class VerletCriterion>
+void split_short_range_loop(BondKernel bond_kernel, PairKernel pair_kernel,
+                            LongCutoffKernel long_cutoff_kernel,
+                            double distance_cutoff,
+                            const VerletCriterion &verlet_criterion,
+                            bool parallel) {
+  ESPRESSO_PROFILER_CXX_MARK_FUNCTION;
+
+  assert(cell_structure.get_resort_particles() == Cells::RESORT_NONE);
+
+  auto const bonds = [&]() {
+    cell_structure.ghosts_finish();
+    if (parallel)
+      cell_structure.parallel_bond_loop(bond_kernel);
+    else
+      cell_structure.bond_loop(bond_kernel);
+  };
+
+  if (distance_cutoff > 0.)
+    cell_structure.split_non_bonded_loop(pair_kernel, long_cutoff_kernel,
+                                         verlet_criterion, bonds, parallel);
+  else
+    bonds();
+}
 #endif
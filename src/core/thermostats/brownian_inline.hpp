@@ -45,8 +45,8 @@ inline Utils::Vector3d bd_drag(Thermostat::GammaType const &brownian_gamma,
   Thermostat::GammaType gamma;
 
 #ifdef THERMOSTAT_PER_PARTICLE
-  if (p.p.gamma >= Thermostat::GammaType{}) {
-    gamma = p.p.gamma;
+  if (p.c.gamma >= Thermostat::GammaType{}) {
+    gamma = p.c.gamma;
   } else
 #endif
   {
@@ -107,8 +107,8 @@ inline Utils::Vector3d bd_drag_vel(Thermostat::GammaType const &brownian_gamma,
   Thermostat::GammaType gamma;
 
 #ifdef THERMOSTAT_PER_PARTICLE
-  if (p.p.gamma >= Thermostat::GammaType{}) {
-    gamma = p.p.gamma;
+  if (p.c.gamma >= Thermostat::GammaType{}) {
+    gamma = p.c.gamma;
   } else
 #endif
   {
@@ -174,9 +174,9 @@ inline Utils::Vector3d bd_random_walk(BrownianThermostat const &brownian,
   Thermostat::GammaType sigma_pos = brownian.sigma_pos;
 #ifdef THERMOSTAT_PER_PARTICLE
   // override default if particle-specific gamma
-  if (p.p.gamma >= Thermostat::GammaType{}) {
+  if (p.c.gamma >= Thermostat::GammaType{}) {
     if (temperature > 0.0) {
-      sigma_pos = BrownianThermostat::sigma(temperature, p.p.gamma);
+      sigma_pos = BrownianThermostat::sigma(temperature, p.c.gamma);
     } else {
       sigma_pos = Thermostat::GammaType{};
     }
@@ -281,8 +281,8 @@ bd_drag_rot(Thermostat::GammaType const &brownian_gamma_rotation, Particle &p,
   Thermostat::GammaType gamma;
 
 #ifdef THERMOSTAT_PER_PARTICLE
-  if (p.p.gamma_rot >= Thermostat::GammaType{}) {
-    gamma = p.p.gamma_rot;
+  if (p.c.gamma_rot >= Thermostat::GammaType{}) {
+    gamma = p.c.gamma_rot;
   } else
 #endif
   {
@@ -323,8 +323,8 @@ bd_drag_vel_rot(Thermostat::GammaType const &brownian_gamma_rotation,
   Thermostat::GammaType gamma;
 
 #ifdef THERMOSTAT_PER_PARTICLE
-  if (p.p.gamma_rot >= Thermostat::GammaType{}) {
-    gamma = p.p.gamma_rot;
+  if (p.c.gamma_rot >= Thermostat::GammaType{}) {
+    gamma = p.c.gamma_rot;
   } else
 #endif
   {
@@ -361,9 +361,9 @@ bd_random_walk_rot(BrownianThermostat const &brownian, Particle const &p,
   Thermostat::GammaType sigma_pos = brownian.sigma_pos_rotation;
 #ifdef THERMOSTAT_PER_PARTICLE
   // override default if particle-specific gamma
-  if (p.p.gamma_rot >= Thermostat::GammaType{}) {
+  if (p.c.gamma_rot >= Thermostat::GammaType{}) {
     if (temperature > 0.) {
-      sigma_pos = BrownianThermostat::sigma(temperature, p.p.gamma_rot);
+      sigma_pos = BrownianThermostat::sigma(temperature, p.c.gamma_rot);
     } else {
       sigma_pos = {}; // just an indication of the infinity
     }
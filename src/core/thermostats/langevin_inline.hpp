@@ -53,9 +53,9 @@ friction_thermo_langevin(LangevinThermostat const &langevin, Particle const &p,
   Thermostat::GammaType pref_noise = langevin.pref_noise;
 #ifdef THERMOSTAT_PER_PARTICLE
   // override default if particle-specific gamma
-  if (p.p.gamma >= Thermostat::GammaType{}) {
+  if (p.c.gamma >= Thermostat::GammaType{}) {
     auto const gamma =
-        p.p.gamma >= Thermostat::GammaType{} ? p.p.gamma : langevin.gamma;
+        p.c.gamma >= Thermostat::GammaType{} ? p.c.gamma : langevin.gamma;
     pref_friction = -gamma;
     pref_noise = LangevinThermostat::sigma(temperature, time_step, gamma);
   }
@@ -63,8 +63,8 @@ friction_thermo_langevin(LangevinThermostat const &langevin, Particle const &p,
 
   // Get effective velocity in the thermostatting
 #ifdef ENGINE
-  auto const &velocity = (p.p.swim.v_swim != 0)
-                             ? p.m.v - p.p.swim.v_swim * p.r.calc_director()
+  auto const &velocity = (p.c.swim.v_swim != 0)
+                             ? p.m.v - p.c.swim.v_swim * p.r.calc_director()
                              : p.m.v;
 #else
   auto const &velocity = p.m.v;
@@ -110,9 +110,9 @@ friction_thermo_langevin_rotation(LangevinThermostat const &langevin,
 
 #ifdef THERMOSTAT_PER_PARTICLE
   // override default if particle-specific gamma
-  if (p.p.gamma_rot >= Thermostat::GammaType{}) {
-    auto const gamma = p.p.gamma_rot >= Thermostat::GammaType{}
-                           ? p.p.gamma_rot
+  if (p.c.gamma_rot >= Thermostat::GammaType{}) {
+    auto const gamma = p.c.gamma_rot >= Thermostat::GammaType{}
+                           ? p.c.gamma_rot
                            : langevin.gamma_rotation;
     pref_friction = -gamma;
     pref_noise = LangevinThermostat::sigma(temperature, time_step, gamma);
@@ -22,14 +22,22 @@
  *  Implementation of tuning.hpp.
  */
 #include "cells.hpp"
+#include "communication.hpp"
 #include "errorhandling.hpp"
+#include "event.hpp"
 #include "global.hpp"
 #include "grid.hpp"
 #include "integrate.hpp"
 #include "nonbonded_interactions/nonbonded_interaction_data.hpp"
 
+#include <utils/math/int_pow.hpp>
+#include <utils/math/sqr.hpp>
 #include <utils/statistics/RunningAverage.hpp>
 
+#include <boost/algorithm/clamp.hpp>
+#include <boost/mpi/collectives/all_reduce.hpp>
+#include <boost/mpi/operations.hpp>
+
 #include <boost/range/algorithm/max_element.hpp>
 #include <boost/range/algorithm/min_element.hpp>
 
@@ -129,3 +137,129 @@ void tune_skin(double min_skin, double max_skin, double tol, int int_steps,
   skin = 0.5 * (a + b);
   mpi_bcast_parameter(FIELD_SKIN);
 }
+
+int adaptive_skin_interval = 0;
+
+namespace {
+/** Integration steps since the last adjustment of the skin. */
+int steps_since_skin_adjustment = 0;
+/** Time and number of the steps with resort since the last adjustment. */
+double resort_steps_time = 0.;
+int n_resort_steps = 0;
+/** Time and number of the steps without resort since the last adjustment. */
+double other_steps_time = 0.;
+int n_other_steps = 0;
+
+/** Fraction of the way to the optimal skin the skin is moved in one
+ *  adjustment, less than 1 to damp the response to noisy timings. */
+constexpr double skin_relaxation = 0.5;
+
+void reset_skin_statistics() {
+  steps_since_skin_adjustment = 0;
+  resort_steps_time = other_steps_time = 0.;
+  n_resort_steps = n_other_steps = 0;
+}
+} // namespace
+
+double optimal_skin(double cutoff, double skin, double pair_time,
+                    double rebuild_time, double rebuild_rate, double min_skin,
+                    double max_skin) {
+  /* Derivative of the modelled time per step, which is increasing */
+  auto const slope = [=](double s) {
+    return 3. * pair_time * Utils::sqr(cutoff + s) /
+               Utils::int_pow<3>(cutoff + skin) -
+           rebuild_time * rebuild_rate * skin / Utils::sqr(s);
+  };
+
+  if (slope(min_skin) >= 0.)
+    return min_skin;
+  if (slope(max_skin) <= 0.)
+    return max_skin;
+
+  double a = min_skin;
+  double b = max_skin;
+  for (int i = 0; i < 64; i++) {
+    auto const c = 0.5 * (a + b);
+    (slope(c) < 0. ? a : b) = c;
+  }
+  return 0.5 * (a + b);
+}
+
+void adaptive_skin_add_step(double time, bool resorted) {
+  if (resorted) {
+    resort_steps_time += time;
+    n_resort_steps++;
+  } else {
+    other_steps_time += time;
+    n_other_steps++;
+  }
+}
+
+void adaptive_skin_step() {
+  if (adaptive_skin_interval <= 0 or
+      ++steps_since_skin_adjustment < adaptive_skin_interval)
+    return;
+
+  auto const cutoff = maximal_cutoff();
+  /* Without a resort the cost of the rebuild is unknown, keep measuring */
+  if (cutoff <= 0. or n_resort_steps == 0)
+    return;
+
+  /* The slowest node determines the time of a step. The resorts are
+   * global, so the numbers of steps are the same on all nodes. */
+  auto const resort_time = boost::mpi::all_reduce(
+      comm_cart, resort_steps_time, boost::mpi::maximum<double>());
+  auto const other_time = boost::mpi::all_reduce(
+      comm_cart, other_steps_time, boost::mpi::maximum<double>());
+  auto const max_range = boost::mpi::all_reduce(
+      comm_cart, *boost::min_element(cell_structure.max_cutoff()),
+      boost::mpi::minimum<double>());
+
+  /* The maximal skin is the same as in tune_skin() */
+  auto const min_skin = 0.01 * cutoff;
+  auto const max_skin =
+      std::min(max_range - cutoff, 0.5 * *boost::max_element(box_geo.length()));
+
+  double target_skin;
+  if (n_other_steps == 0) {
+    /* Resorting every step, the skin is too small */
+    target_skin = std::max(2. * skin, min_skin);
+  } else {
+    auto const pair_time = other_time / n_other_steps;
+    auto const rebuild_time =
+        std::max(resort_time / n_resort_steps - pair_time, 0.);
+    auto const rebuild_rate =
+        static_cast<double>(n_resort_steps) / (n_resort_steps + n_other_steps);
+    target_skin =
+        optimal_skin(cutoff, std::max(skin, min_skin), pair_time, rebuild_time,
+                     rebuild_rate, min_skin, max_skin);
+  }
+
+  reset_skin_statistics();
+
+  if (max_skin < min_skin)
+    return;
+
+  auto const new_skin = boost::algorithm::clamp(
+      skin + skin_relaxation * (target_skin - skin), min_skin, max_skin);
+  if (std::abs(new_skin - skin) <= 0.01 * skin)
+    return;
+
+  /* The forces of the current step stay valid, they do not depend
+   * on the skin. */
+  auto const recalc = recalc_forces;
+  skin = new_skin;
+  on_parameter_change(FIELD_SKIN);
+  recalc_forces = recalc;
+}
+
+void mpi_set_adaptive_skin_interval_local(int interval) {
+  adaptive_skin_interval = interval;
+  reset_skin_statistics();
+}
+
+REGISTER_CALLBACK(mpi_set_adaptive_skin_interval_local)
+
+void mpi_set_adaptive_skin_interval(int interval) {
+  mpi_call_all(mpi_set_adaptive_skin_interval_local, interval);
+}
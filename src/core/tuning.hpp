@@ -59,4 +59,49 @@ double diffTime();
 void tune_skin(double min_skin, double max_skin, double tol, int int_steps,
                bool adjust_max_skin);
 
+/** Number of integration steps between two adjustments of the
+ *  @ref skin during the integration. Disabled if 0.
+ */
+extern int adaptive_skin_interval;
+
+/** @brief Set @ref adaptive_skin_interval.
+ *  @param interval Number of integration steps between two
+ *         adjustments of the skin, 0 to disable.
+ */
+void mpi_set_adaptive_skin_interval(int interval);
+
+/** Record the time of the ghost update and force calculation
+ *  of an integration step, and whether the particles were resorted.
+ */
+void adaptive_skin_add_step(double time, bool resorted);
+
+/** @brief Count an integration step, and adjust the @ref skin every
+ *  @ref adaptive_skin_interval steps.
+ *
+ *  The time of the steps without resort is taken as the cost of the
+ *  pair evaluation, which grows with the volume of the Verlet range,
+ *  the extra time of the steps with resort as the cost of a list
+ *  rebuild, the frequency of which is inversely proportional to the
+ *  skin. The skin is moved towards the minimum of this model,
+ *  see @ref optimal_skin. Has to be called on all nodes.
+ */
+void adaptive_skin_step();
+
+/** @brief Skin that minimizes the modelled time per step
+ *  @f[ t_\text{pair} \left(\frac{r_c + s}{r_c + s_0}\right)^3
+ *      + t_\text{rebuild} \, f_\text{rebuild} \frac{s_0}{s}. @f]
+ *
+ *  @param cutoff Maximal interaction cutoff @f$ r_c @f$.
+ *  @param skin Skin @f$ s_0 @f$ of the measurement.
+ *  @param pair_time Time per step of the pair evaluation.
+ *  @param rebuild_time Time of a rebuild of the lists.
+ *  @param rebuild_rate Rebuilds per step.
+ *  @param min_skin Lower bound of the result.
+ *  @param max_skin Upper bound of the result.
+ *  @return Optimal skin in [@p min_skin, @p max_skin].
+ */
+double optimal_skin(double cutoff, double skin, double pair_time,
+                    double rebuild_time, double rebuild_rate, double min_skin,
+                    double max_skin);
+
 #endif
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ClusterPairList test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "Cell.hpp"
+#include "ClusterPairList.hpp"
+#include "Particle.hpp"
+#include "ParticleSoA.hpp"
+#include "algorithm/link_cell.hpp"
+#include "config.hpp"
+#include "exclusions.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "nonbonded_interactions/soa_pair_kernels.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/math/sqr.hpp>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+std::pair<int, int> id_pair(Particle const &p1, Particle const &p2) {
+  return std::minmax(p1.identity(), p2.identity());
+}
+
+/* A row of cells, each cell is a neighbor of all others,
+ * the last cell holds ghosts. */
+struct TestCells {
+  static constexpr int n_cells = 4;
+  std::vector<Cell> cells = std::vector<Cell>(n_cells);
+  std::vector<Cell *> local;
+  std::vector<Cell *> ghost;
+
+  TestCells(int n_part_per_cell, double box_l) {
+    for (int i = 0; i < n_cells; i++) {
+      std::vector<Cell *> red, black;
+      for (int j = 0; j < n_cells; j++) {
+        if (j > i)
+          red.push_back(&cells[j]);
+        if (j < i)
+          black.push_back(&cells[j]);
+      }
+      cells[i].m_neighbors = Neighbors<Cell *>(red, black);
+      ((i < n_cells - 1) ? local : ghost).push_back(&cells[i]);
+    }
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> pos(0., box_l);
+    auto id = 0;
+    for (auto &c : cells) {
+      c.particles().resize(n_part_per_cell);
+      for (auto &p : c.particles()) {
+        p.p.identity = id++;
+        p.r.p = {pos(gen), pos(gen), pos(gen)};
+      }
+    }
+  }
+
+  /* All pairs of the link cell algorithm for which the criterion holds,
+   * as sorted pairs of ids. */
+  template <class Criterion> auto pairs(Criterion const &criterion) {
+    std::vector<std::pair<int, int>> result;
+    Algorithm::link_cell(boost::make_indirect_iterator(local.begin()),
+                         boost::make_indirect_iterator(local.end()),
+                         [&](Particle const &p1, Particle const &p2) {
+                           if (criterion(p1, p2))
+                             result.push_back(id_pair(p1, p2));
+                         });
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+};
+
+auto const within = [](double range) {
+  return [range](Particle const &p1, Particle const &p2) {
+    return (p1.r.p - p2.r.p).norm2() <= Utils::sqr(range);
+  };
+};
+
+BOOST_AUTO_TEST_CASE(pairs) {
+  /* Odd number of particles per cell to have padding */
+  TestCells cells(13, 2.);
+
+  ParticleSoA soa;
+  soa.rebuild(Utils::make_span(cells.local), Utils::make_span(cells.ghost),
+              ClusterPairList::cluster_size);
+
+  for (auto const range : {0.5, 1.0, 10.}) {
+    ClusterPairList list;
+    list.build(soa, within(range));
+
+    std::vector<std::pair<int, int>> list_pairs;
+    list.for_each_pair(
+        soa, [&](Particle const &p1, Particle const &p2, bool excluded) {
+          BOOST_CHECK(not excluded);
+          list_pairs.push_back(id_pair(p1, p2));
+        });
+    std::sort(list_pairs.begin(), list_pairs.end());
+
+    auto const expected = cells.pairs(within(range));
+    BOOST_CHECK(list_pairs == expected);
+
+    for (auto const &cp : list.pairs()) {
+      BOOST_CHECK(cp.pair_mask != 0);
+      BOOST_CHECK_EQUAL(cp.pair_mask, cp.nonbonded_mask);
+    }
+  }
+}
+
+#ifdef EXCLUSIONS
+BOOST_AUTO_TEST_CASE(exclusions) {
+  TestCells cells(8, 1.);
+  auto &p1 = cells.cells[0].particles().begin()[1];
+  auto &p2 = cells.cells[1].particles().begin()[2];
+  add_exclusion(&p1, p2.identity());
+  add_exclusion(&p2, p1.identity());
+
+  ParticleSoA soa;
+  soa.rebuild(Utils::make_span(cells.local), Utils::make_span(cells.ghost),
+              ClusterPairList::cluster_size);
+  ClusterPairList list;
+  list.build(soa, within(10.));
+
+  int n_excluded = 0;
+  for (auto const &cp : list.pairs()) {
+    auto const excluded = cp.pair_mask & ~cp.nonbonded_mask;
+    for (std::size_t a = 0; a < ClusterPairList::cluster_size; a++) {
+      for (std::size_t b = 0; b < ClusterPairList::cluster_size; b++) {
+        if (excluded & (1u << (a * ClusterPairList::cluster_size + b))) {
+          n_excluded++;
+          auto const q1 = soa.particles[cp.i * ClusterPairList::cluster_size +
+                                        a];
+          auto const q2 = soa.particles[cp.j * ClusterPairList::cluster_size +
+                                        b];
+          BOOST_CHECK((q1 == &p1 and q2 == &p2) or (q1 == &p2 and q2 == &p1));
+        }
+      }
+    }
+  }
+  BOOST_CHECK_EQUAL(n_excluded, 1);
+
+  n_excluded = 0;
+  list.for_each_pair(
+      soa, [&](Particle const &q1, Particle const &q2, bool excluded) {
+        if (excluded) {
+          n_excluded++;
+          BOOST_CHECK((&q1 == &p1 and &q2 == &p2) or
+                      (&q1 == &p2 and &q2 == &p1));
+        }
+      });
+  BOOST_CHECK_EQUAL(n_excluded, 1);
+}
+#endif
+
+#if defined(LENNARD_JONES) && defined(WCA)
+BOOST_AUTO_TEST_CASE(forces) {
+  make_particle_type_exist_local(0);
+  get_ia_param(0, 0)->lj = LJ_Parameters{1.0, 0.5, 1.2, 0., 0., 0.};
+  get_ia_param(0, 0)->wca = WCA_Parameters{0.5, 0.4, 0.45};
+  maximal_cutoff_nonbonded();
+
+  TestCells cells(20, 2.);
+
+  ParticleSoA soa;
+  soa.rebuild(Utils::make_span(cells.local), Utils::make_span(cells.ghost),
+              ClusterPairList::cluster_size);
+
+  soa.gather();
+  soa_pair_forces(soa);
+  auto const fx = soa.fx, fy = soa.fy, fz = soa.fz;
+
+  ClusterPairList list;
+  list.build(soa, within(1.5));
+  soa.gather();
+  soa_pair_forces(soa, list);
+
+  for (std::size_t i = 0; i < soa.size(); i++) {
+    auto const expected = Utils::Vector3d{fx[i], fy[i], fz[i]};
+    auto const result = Utils::Vector3d{soa.fx[i], soa.fy[i], soa.fz[i]};
+    BOOST_CHECK_SMALL((result - expected).norm(),
+                      1e-12 * (1. + expected.norm()));
+  }
+}
+#endif
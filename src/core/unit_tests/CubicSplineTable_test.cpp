@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE CubicSplineTable test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "CubicSplineTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+auto const unit_weight = [](double) { return 1.; };
+
+BOOST_AUTO_TEST_CASE(empty_table) {
+  CubicSplineTable const table;
+  BOOST_CHECK(table.empty());
+  BOOST_CHECK_EQUAL(table.n_intervals(), 0);
+  BOOST_CHECK_EQUAL(table(0.5), 0.);
+
+  auto const degenerate =
+      CubicSplineTable([](double) { return 1.; }, {1., 1.}, 10);
+  BOOST_CHECK(degenerate.empty());
+}
+
+BOOST_AUTO_TEST_CASE(cubic_is_exact) {
+  auto const f = [](double x) { return 1. + x - 2. * x * x + 0.5 * x * x * x; };
+  auto const table = CubicSplineTable(f, {-1., 3.}, 20);
+
+  BOOST_CHECK_EQUAL(table.n_intervals(), 20);
+  BOOST_CHECK_EQUAL(table.begin(), -1.);
+  BOOST_CHECK_EQUAL(table.end(), 3.);
+  for (auto x = -1.; x < 3.; x += 0.037) {
+    BOOST_CHECK_SMALL(table(x) - f(x), 1e-11);
+  }
+  BOOST_CHECK_SMALL(table.max_error(f, unit_weight), 1e-11);
+}
+
+BOOST_AUTO_TEST_CASE(outside_of_range) {
+  auto const table = CubicSplineTable([](double) { return 1.; }, {1., 2.}, 8);
+  BOOST_CHECK_EQUAL(table(0.999), 0.);
+  BOOST_CHECK_EQUAL(table(2.), 0.);
+  BOOST_CHECK_EQUAL(table(5.), 0.);
+  BOOST_CHECK_CLOSE(table(1.), 1., 1e-10);
+  BOOST_CHECK_CLOSE(table(1.999), 1., 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(convergence) {
+  auto const f = [](double x) { return std::exp(-x) * std::sin(3. * x); };
+  auto const coarse =
+      CubicSplineTable(f, {0., 4.}, 50).max_error(f, unit_weight);
+  auto const fine =
+      CubicSplineTable(f, {0., 4.}, 100).max_error(f, unit_weight);
+
+  BOOST_CHECK_LT(coarse, 1e-3);
+  /* Fourth order: halving the step reduces the error about 16 times */
+  BOOST_CHECK_GT(coarse / fine, 10.);
+}
+
+BOOST_AUTO_TEST_CASE(breakpoints) {
+  /* Discontinuous function, the jump is on a breakpoint */
+  auto const f = [](double x) { return (x < 1.) ? std::cos(x) : 0.5 * x; };
+  auto const table = CubicSplineTable(f, {0., 1., 3.}, 60);
+
+  BOOST_CHECK_SMALL(table.max_error(f, unit_weight), 1e-6);
+  BOOST_CHECK_SMALL(table(0.9999) - std::cos(0.9999), 1e-6);
+  BOOST_CHECK_SMALL(table(1.0001) - 0.50005, 1e-6);
+
+  /* The intervals are distributed by the length of the segments */
+  BOOST_CHECK_EQUAL(table.n_intervals(), 20 + 40);
+}
+
+BOOST_AUTO_TEST_CASE(segment_lookup) {
+  /* Segments much shorter and longer than a cell of the lookup grid,
+   * the function is a different constant on every segment */
+  std::vector<double> const breakpoints = {0.,    1e-3, 2e-3, 0.5,
+                                           0.501, 0.75, 3.};
+  auto const f = [&breakpoints](double x) {
+    auto const it =
+        std::upper_bound(breakpoints.begin(), breakpoints.end(), x);
+    return static_cast<double>(it - breakpoints.begin());
+  };
+  auto const table = CubicSplineTable(f, breakpoints, 40);
+
+  for (std::size_t k = 0; k + 1 < breakpoints.size(); k++) {
+    auto const a = breakpoints[k];
+    auto const b = breakpoints[k + 1];
+    for (auto const x : {a, std::nextafter(b, a), 0.5 * (a + b)}) {
+      BOOST_CHECK_CLOSE(table(x), f(x), 1e-10);
+    }
+  }
+}
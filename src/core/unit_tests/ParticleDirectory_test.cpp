@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Unit tests for the ParticleDirectory class. */
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE ParticleDirectory test
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "ParticleDirectory.hpp"
+
+#include <boost/mpi.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace {
+int const n_part = 100;
+
+/* Ids on a rank, particle i is on rank (i + shift) % size */
+std::vector<int> local_ids(boost::mpi::communicator const &comm, int shift) {
+  std::vector<int> ids;
+  for (int i = 0; i < n_part; i++) {
+    if ((i + shift) % comm.size() == comm.rank())
+      ids.push_back(i);
+  }
+  return ids;
+}
+
+std::vector<int> all_ids() {
+  std::vector<int> ids;
+  for (int i = 0; i < n_part; i++)
+    ids.push_back(i);
+  return ids;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(migration) {
+  boost::mpi::communicator world;
+  ParticleDirectory directory;
+
+  for (int shift : {0, 1, 1, 5}) {
+    directory.update(world, local_ids(world, shift));
+
+    /* Every rank looks up different ids */
+    auto ids = all_ids();
+    ids.resize(n_part - world.rank());
+    auto const owners = directory.owners(world, ids);
+    for (std::size_t i = 0; i < ids.size(); i++) {
+      BOOST_CHECK_EQUAL(owners[i], (ids[i] + shift) % world.size());
+    }
+  }
+
+  /* Only the home rank knows the owner */
+  directory.update(world, local_ids(world, 0));
+  for (int i = 0; i < n_part; i++) {
+    if (ParticleDirectory::home(i, world.size()) == world.rank()) {
+      BOOST_CHECK_EQUAL(directory.owner(i), i % world.size());
+    } else {
+      BOOST_CHECK_EQUAL(directory.owner(i), -1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(add_and_remove) {
+  boost::mpi::communicator world;
+  ParticleDirectory directory;
+  directory.update(world, local_ids(world, 0));
+
+  /* New particle on the last rank */
+  directory.add(world, n_part, world.rank() == world.size() - 1);
+  /* Removed on all ranks */
+  directory.remove(3);
+
+  auto const owners = directory.owners(world, {3, n_part, n_part + 1});
+  BOOST_CHECK_EQUAL(owners[0], -1);
+  BOOST_CHECK_EQUAL(owners[1], world.size() - 1);
+  BOOST_CHECK_EQUAL(owners[2], -1);
+
+  /* The added particle is not reported again, and the
+   * removed one is not reported as a departure. */
+  auto ids = local_ids(world, 0);
+  ids.erase(std::remove(ids.begin(), ids.end(), 3), ids.end());
+  if (world.rank() == world.size() - 1)
+    ids.push_back(n_part);
+  directory.update(world, ids);
+  BOOST_CHECK(directory.owners(world, {3, n_part}) ==
+              (std::vector<int>{-1, world.size() - 1}));
+
+  directory.clear();
+  BOOST_CHECK(directory.owners(world, {0, n_part}) ==
+              (std::vector<int>{-1, -1}));
+}
+
+int main(int argc, char **argv) {
+  boost::mpi::environment mpi_env(argc, argv);
+
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE ParticleSoA test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "Cell.hpp"
+#include "Particle.hpp"
+#include "ParticleSoA.hpp"
+#include "algorithm/link_cell.hpp"
+#include "config.hpp"
+#include "nonbonded_interactions/lj.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+#include "nonbonded_interactions/soa_pair_kernels.hpp"
+#include "nonbonded_interactions/wca.hpp"
+
+#include <utils/Vector.hpp>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/* Three local cells which are all neighbors of each other,
+ * and a ghost cell that is a neighbor of the first one. */
+struct TestCells {
+  std::vector<Cell> cells = std::vector<Cell>(4);
+  std::vector<Cell *> local = {&cells[0], &cells[1], &cells[2]};
+  std::vector<Cell *> ghost = {&cells[3]};
+
+  TestCells() {
+    set_neighbors(0, {1, 2, 3}, {});
+    set_neighbors(1, {2}, {0});
+    set_neighbors(2, {}, {0, 1});
+  }
+
+  void set_neighbors(int cell, std::vector<int> const &red,
+                     std::vector<int> const &black) {
+    std::vector<Cell *> red_cells, black_cells;
+    for (auto i : red)
+      red_cells.push_back(&cells[i]);
+    for (auto i : black)
+      black_cells.push_back(&cells[i]);
+    cells[cell].m_neighbors = Neighbors<Cell *>(red_cells, black_cells);
+  }
+
+  void fill(int n_part_per_cell, double box_l, int n_types) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> pos(0., box_l);
+    std::uniform_int_distribution<int> type(0, n_types - 1);
+
+    auto id = 0;
+    for (auto &c : cells) {
+      c.particles().resize(n_part_per_cell);
+      for (auto &p : c.particles()) {
+        p.p.identity = id++;
+        p.p.type = type(gen);
+        p.r.p = {pos(gen), pos(gen), pos(gen)};
+      }
+    }
+  }
+};
+
+BOOST_AUTO_TEST_CASE(layout) {
+  TestCells cells;
+  cells.fill(5, 1., 1);
+
+  ParticleSoA soa;
+  soa.rebuild(Utils::make_span(cells.local), Utils::make_span(cells.ghost));
+
+  BOOST_CHECK_EQUAL(soa.size(), 20u);
+  BOOST_CHECK_EQUAL(soa.n_local_cells, 3u);
+  BOOST_CHECK((soa.cell_begin == std::vector<std::size_t>{0, 5, 10, 15}));
+  BOOST_CHECK((soa.cell_end == std::vector<std::size_t>{5, 10, 15, 20}));
+  BOOST_CHECK((soa.neighbor_begin == std::vector<std::size_t>{0, 3, 4, 4}));
+  BOOST_CHECK((soa.neighbors == std::vector<std::size_t>{1, 2, 3, 2}));
+
+  soa.gather();
+  for (std::size_t i = 0; i < soa.size(); i++) {
+    auto const &p = *soa.particles[i];
+    BOOST_CHECK_EQUAL(p.identity(), static_cast<int>(i));
+    BOOST_CHECK((Utils::Vector3d{soa.x[i], soa.y[i], soa.z[i]} == p.r.p));
+    BOOST_CHECK_EQUAL(soa.fx[i], 0.);
+  }
+
+  soa.fx[3] = 1.;
+  soa.fy[3] = 2.;
+  soa.fz[3] = 3.;
+  soa.scatter_forces();
+  BOOST_CHECK((soa.particles[3]->f.f == Utils::Vector3d{1., 2., 3.}));
+  BOOST_CHECK((soa.particles[4]->f.f == Utils::Vector3d{}));
+}
+
+BOOST_AUTO_TEST_CASE(cluster_layout) {
+  TestCells cells;
+  cells.fill(5, 1., 1);
+
+  ParticleSoA soa;
+  soa.rebuild(Utils::make_span(cells.local), Utils::make_span(cells.ghost),
+              4);
+
+  BOOST_CHECK_EQUAL(soa.size(), 32u);
+  BOOST_CHECK((soa.cell_begin == std::vector<std::size_t>{0, 8, 16, 24}));
+  BOOST_CHECK((soa.cell_end == std::vector<std::size_t>{5, 13, 21, 29}));
+
+  for (std::size_t c = 0; c < cells.cells.size(); c++) {
+    auto const &cell = cells.cells[c];
+    for (auto i = soa.cell_begin[c]; i < soa.cell_end[c]; i++) {
+      auto const p = soa.particles[i];
+      BOOST_REQUIRE(p);
+      BOOST_CHECK(p >= cell.particles().begin() and
+                  p < cell.particles().end());
+    }
+    for (auto i = soa.cell_end[c]; i < soa.cell_begin[c] + 8; i++) {
+      BOOST_CHECK(soa.particles[i] == nullptr);
+    }
+  }
+
+  /* Padding is ignored */
+  soa.gather();
+  soa.fx.assign(soa.size(), 1.);
+  soa.scatter_forces();
+  for (auto const &c : cells.cells) {
+    for (auto const &p : c.particles()) {
+      BOOST_CHECK_EQUAL(p.f.f[0], 1.);
+    }
+  }
+}
+
+#if defined(LENNARD_JONES) && defined(WCA)
+BOOST_AUTO_TEST_CASE(lj_wca_forces) {
+  make_particle_type_exist_local(2);
+  get_ia_param(0, 0)->lj = LJ_Parameters{1.0, 0.9, 2.0, 0., 0., 0.};
+  get_ia_param(0, 1)->lj = LJ_Parameters{0.6, 1.0, 2.5, 0., 0., 0.3};
+  auto const wca_cut = std::pow(2., 1. / 6.);
+  get_ia_param(1, 2)->wca = WCA_Parameters{1.2, 0.8, 0.8 * wca_cut};
+  get_ia_param(2, 2)->wca = WCA_Parameters{0.8, 1.0, wca_cut};
+  maximal_cutoff_nonbonded();
+
+  TestCells cells;
+  cells.fill(20, 3., 3);
+
+  ParticleSoA soa;
+  soa.rebuild(Utils::make_span(cells.local), Utils::make_span(cells.ghost));
+  soa.gather();
+  soa_pair_forces(soa);
+  soa.scatter_forces();
+
+  std::vector<Utils::Vector3d> expected(soa.size());
+  Algorithm::link_cell(
+      boost::make_indirect_iterator(cells.local.begin()),
+      boost::make_indirect_iterator(cells.local.end()),
+      [&expected](Particle const &p1, Particle const &p2) {
+        auto const &ia = *get_ia_param(p1.p.type, p2.p.type);
+        auto const d = p1.r.p - p2.r.p;
+        auto const dist = d.norm();
+        auto const f = (lj_pair_force_factor(ia, dist) +
+                        wca_pair_force_factor(ia, dist)) *
+                       d;
+        expected[p1.identity()] += f;
+        expected[p2.identity()] -= f;
+      });
+
+  for (std::size_t i = 0; i < soa.size(); i++) {
+    auto const &p = *soa.particles[i];
+    auto const tol = 1e-12 * (1. + expected[p.identity()].norm());
+    BOOST_CHECK_SMALL((p.f.f - expected[p.identity()]).norm(), tol);
+  }
+}
+#endif
@@ -72,6 +72,9 @@ BOOST_AUTO_TEST_CASE(serialization) {
 #ifdef EXCLUSIONS
   p.exclusions() = el;
 #endif
+#ifdef EXTERNAL_FORCES
+  p.c.ext_force = {1., 2., 3.};
+#endif
 
   std::stringstream stream;
   boost::archive::text_oarchive out_ar(stream);
@@ -87,6 +90,9 @@ BOOST_AUTO_TEST_CASE(serialization) {
 #ifdef EXCLUSIONS
   BOOST_CHECK(q.exclusions() == el);
 #endif
+#ifdef EXTERNAL_FORCES
+  BOOST_CHECK(q.c.ext_force == p.c.ext_force);
+#endif
 }
 
 namespace Utils {
@@ -122,3 +128,33 @@ BOOST_AUTO_TEST_CASE(properties_serialization) {
     BOOST_CHECK_EQUAL(out.identity, prop.identity);
   }
 }
+
+BOOST_AUTO_TEST_CASE(cold_properties_serialization) {
+  static_assert(
+      Utils::is_statically_serializable<ParticleColdProperties>::value, "");
+  auto const expected_size =
+      Utils::MemcpyOArchive::packing_size<ParticleColdProperties>();
+
+  std::vector<char> buf(expected_size);
+
+  auto prop = ParticleColdProperties{};
+#ifdef EXTERNAL_FORCES
+  prop.ext_force = {1., 2., 3.};
+#endif
+
+  {
+    auto oa = Utils::MemcpyOArchive{Utils::make_span(buf)};
+    oa << prop;
+    BOOST_CHECK_EQUAL(oa.bytes_written(), expected_size);
+  }
+
+  {
+    auto ia = Utils::MemcpyIArchive{Utils::make_span(buf)};
+    ParticleColdProperties out;
+    ia >> out;
+    BOOST_CHECK_EQUAL(ia.bytes_read(), expected_size);
+#ifdef EXTERNAL_FORCES
+    BOOST_CHECK(out.ext_force == prop.ext_force);
+#endif
+  }
+}
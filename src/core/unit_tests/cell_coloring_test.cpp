@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE cell_coloring test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "algorithm/cell_coloring.hpp"
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+/* Write sets of a periodic n^3 grid of cells, where every
+ * cell modifies itself and the half of its neighbors. */
+std::vector<std::vector<int>> half_shell_grid(int n) {
+  auto const index = [n](int x, int y, int z) {
+    return ((x + n) % n) + n * (((y + n) % n) + n * ((z + n) % n));
+  };
+
+  std::vector<std::vector<int>> write_sets(n * n * n);
+  for (int x = 0; x < n; x++)
+    for (int y = 0; y < n; y++)
+      for (int z = 0; z < n; z++) {
+        auto &targets = write_sets[index(x, y, z)];
+        for (int dz = -1; dz <= 1; dz++)
+          for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++) {
+              auto const offset = dx + 3 * (dy + 3 * dz);
+              if (offset >= 0)
+                targets.push_back(index(x + dx, y + dy, z + dz));
+            }
+      }
+  return write_sets;
+}
+
+BOOST_AUTO_TEST_CASE(color_cells) {
+  auto const n = 6;
+  auto const write_sets = half_shell_grid(n);
+
+  std::vector<int> cells(write_sets.size());
+  for (std::size_t i = 0; i < cells.size(); i++)
+    cells[i] = static_cast<int>(i);
+
+  auto const colors = Algorithm::color_cells(
+      cells, [&write_sets](int cell) { return write_sets[cell]; });
+
+  /* Every cell has exactly one color */
+  std::vector<int> n_colors(cells.size(), 0);
+  for (auto const &color : colors) {
+    BOOST_CHECK(not color.empty());
+    for (auto const i : color)
+      n_colors.at(i)++;
+  }
+  for (auto const n_color : n_colors)
+    BOOST_CHECK_EQUAL(n_color, 1);
+
+  /* Cells of the same color do not modify the same cell */
+  for (auto const &color : colors) {
+    std::set<int> modified;
+    for (auto const i : color) {
+      for (auto const target : write_sets[i]) {
+        BOOST_CHECK(modified.insert(target).second);
+      }
+    }
+  }
+
+  /* Some cells can be processed concurrently */
+  BOOST_CHECK_LT(colors.size(), cells.size());
+}
+
+BOOST_AUTO_TEST_CASE(independent_cells) {
+  std::vector<int> cells = {0, 1, 2, 3};
+  auto const colors = Algorithm::color_cells(
+      cells, [](int cell) { return std::vector<int>{cell}; });
+
+  BOOST_REQUIRE_EQUAL(colors.size(), 1u);
+  BOOST_CHECK((colors[0] == std::vector<std::size_t>{0, 1, 2, 3}));
+}
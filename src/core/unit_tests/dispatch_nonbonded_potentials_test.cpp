@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Unit tests for the selection of the specialized pair kernels. */
+
+#define BOOST_TEST_MODULE dispatch nonbonded potentials test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "forces_inline.hpp"
+#include "nonbonded_interactions/nonbonded_interaction_data.hpp"
+
+namespace {
+unsigned dispatched(unsigned active, bool spline_tables = false) {
+  unsigned potentials = 0u;
+  dispatch_nonbonded_potentials(active, spline_tables, [&](auto constant) {
+    potentials = decltype(constant)::value;
+  });
+  return potentials;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(single_potentials) {
+  BOOST_CHECK_EQUAL(dispatched(NB_NONE), NB_NONE);
+  for (unsigned flag = 1u; flag < NB_ALL; flag <<= 1u) {
+    BOOST_CHECK_EQUAL(dispatched(flag), flag);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(combinations) {
+  BOOST_CHECK_EQUAL(dispatched(NB_LJ | NB_WCA), NB_LJ | NB_WCA);
+  BOOST_CHECK_EQUAL(dispatched(NB_WCA | NB_THOLE), NB_WCA | NB_THOLE);
+  BOOST_CHECK_EQUAL(dispatched(NB_WCA | NB_TABULATED),
+                    NB_WCA | NB_TABULATED);
+  /* combinations without a specialization */
+  BOOST_CHECK_EQUAL(dispatched(NB_GAUSSIAN | NB_HAT), NB_ALL);
+  BOOST_CHECK_EQUAL(dispatched(NB_LJ | NB_WCA | NB_THOLE), NB_ALL);
+}
+
+BOOST_AUTO_TEST_CASE(spline_tables) {
+  /* the potentials next to the tables are specialized as well */
+  BOOST_CHECK_EQUAL(dispatched(NB_LJ, true), NB_LJ | NB_SPLINE_TABLE);
+  BOOST_CHECK_EQUAL(dispatched(NB_WCA | NB_TABULATED, true),
+                    NB_WCA | NB_TABULATED | NB_SPLINE_TABLE);
+  BOOST_CHECK_EQUAL(dispatched(NB_GAUSSIAN | NB_HAT, true),
+                    NB_ALL | NB_SPLINE_TABLE);
+  /* nothing to tabulate */
+  BOOST_CHECK_EQUAL(dispatched(NB_TABULATED, true), NB_TABULATED);
+}
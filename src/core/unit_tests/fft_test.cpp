@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Unit tests for the parallel 3D-FFT. */
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_MODULE fft test
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "config.hpp"
+
+#include <boost/mpi.hpp>
+
+#if defined(P3M) || defined(DP3M)
+
+#include "electrostatics_magnetostatics/fft.hpp"
+
+#include <utils/Vector.hpp>
+#include <utils/constants.hpp>
+
+#include <mpi.h>
+
+#include <cmath>
+#include <complex>
+
+namespace {
+int const global_mesh[3] = {8, 6, 5};
+double const global_mesh_off[3] = {0.5, 0.5, 0.5};
+int const margin[6] = {1, 1, 1, 1, 1, 1};
+
+/* Real space data at a global mesh point */
+double value(int i0, int i1, int i2) {
+  return std::sin(1. + 0.1 * i0 + 0.37 * i1 * i1 + 0.05 * i2 * i0);
+}
+
+/* First point and size of the local real space mesh,
+ * as in the P3M domain decomposition. */
+void local_mesh(int const *pos, int const *grid, int *start, int *size) {
+  for (int i = 0; i < 3; i++) {
+    auto const ratio = global_mesh[i] / static_cast<double>(grid[i]);
+    start[i] = static_cast<int>(ceil(ratio * pos[i] - global_mesh_off[i]));
+    auto last = static_cast<int>(
+        floor(ratio * (pos[i] + 1) - global_mesh_off[i]));
+    if (ratio * (pos[i] + 1) - global_mesh_off[i] - last < 1.0e-15)
+      last--;
+    if (1.0 + ratio * pos[i] - global_mesh_off[i] - start[i] < 1.0e-15)
+      start[i]--;
+    size[i] = last - start[i] + 1;
+  }
+}
+
+boost::mpi::communicator cart_comm(Utils::Vector3i &grid) {
+  boost::mpi::communicator world;
+  int dims[3] = {0, 0, 0}, periods[3] = {1, 1, 1};
+  MPI_Dims_create(world.size(), 3, dims);
+  MPI_Comm cart;
+  MPI_Cart_create(world, 3, dims, periods, 0, &cart);
+  grid = {dims[0], dims[1], dims[2]};
+  return {cart, boost::mpi::comm_take_ownership};
+}
+
+/* Transform forward and back, and compare to the direct transform */
+void check_fft(bool force_all_to_all) {
+  Utils::Vector3i grid;
+  auto const comm = cart_comm(grid);
+  int pos[3], start[3], size[3];
+  MPI_Cart_coords(comm, comm.rank(), 3, pos);
+  local_mesh(pos, grid.data(), start, size);
+  Utils::Vector3i const ca_mesh_dim = {size[0] + 2, size[1] + 2, size[2] + 2};
+
+  fft_data_struct fft;
+  fft.force_all_to_all = force_all_to_all;
+  int ks_pnum;
+  auto const mesh_size = fft_init(ca_mesh_dim, margin, global_mesh,
+                                  global_mesh_off, ks_pnum, fft, grid, comm);
+  BOOST_REQUIRE_EQUAL(ks_pnum, 4);
+  if (force_all_to_all) {
+    for (int i = 1; i < 4; i++)
+      BOOST_CHECK(fft.plan[i].all_to_all);
+  }
+
+  fft_vector<double> data(mesh_size, 0.);
+  auto ca_index = [&](int i0, int i1, int i2) {
+    return (i2 + 1) + ca_mesh_dim[2] * ((i1 + 1) + ca_mesh_dim[1] * (i0 + 1));
+  };
+  for (int i0 = 0; i0 < size[0]; i0++)
+    for (int i1 = 0; i1 < size[1]; i1++)
+      for (int i2 = 0; i2 < size[2]; i2++)
+        data[ca_index(i0, i1, i2)] =
+            value(start[0] + i0, start[1] + i1, start[2] + i2);
+
+  fft_perform_forw(data.data(), fft, comm);
+
+  /* The k-space mesh is in the order (y, z, x) */
+  auto const &ks_mesh = fft.plan[3].new_mesh;
+  auto const &ks_start = fft.plan[3].start;
+  for (int j0 = 0; j0 < ks_mesh[0]; j0++)
+    for (int j1 = 0; j1 < ks_mesh[1]; j1++)
+      for (int j2 = 0; j2 < ks_mesh[2]; j2++) {
+        int const k[3] = {ks_start[2] + j2, ks_start[0] + j0,
+                          ks_start[1] + j1};
+        std::complex<double> expected = 0.;
+        for (int r0 = 0; r0 < global_mesh[0]; r0++)
+          for (int r1 = 0; r1 < global_mesh[1]; r1++)
+            for (int r2 = 0; r2 < global_mesh[2]; r2++) {
+              auto const phase = -2. * Utils::pi() *
+                                 (k[0] * r0 / double(global_mesh[0]) +
+                                  k[1] * r1 / double(global_mesh[1]) +
+                                  k[2] * r2 / double(global_mesh[2]));
+              expected += value(r0, r1, r2) * std::polar(1., phase);
+            }
+        auto const ind = j2 + ks_mesh[2] * (j1 + ks_mesh[1] * j0);
+        BOOST_CHECK_SMALL(data[2 * ind] - expected.real(), 1e-10);
+        BOOST_CHECK_SMALL(data[2 * ind + 1] - expected.imag(), 1e-10);
+      }
+
+  fft_perform_back(data.data(), false, fft, comm);
+
+  /* The backward transform is not normalized */
+  auto const n_points = global_mesh[0] * global_mesh[1] * global_mesh[2];
+  for (int i0 = 0; i0 < size[0]; i0++)
+    for (int i1 = 0; i1 < size[1]; i1++)
+      for (int i2 = 0; i2 < size[2]; i2++)
+        BOOST_CHECK_SMALL(data[ca_index(i0, i1, i2)] / n_points -
+                              value(start[0] + i0, start[1] + i1,
+                                    start[2] + i2),
+                          1e-12);
+
+  for (int i = 1; i < 4; i++) {
+    fftw_destroy_plan(fft.plan[i].our_fftw_plan);
+    fftw_destroy_plan(fft.back[i].our_fftw_plan);
+  }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(group_communication) { check_fft(false); }
+
+BOOST_AUTO_TEST_CASE(all_to_all_communication) { check_fft(true); }
+
+#else
+BOOST_AUTO_TEST_CASE(no_fft) {}
+#endif
+
+int main(int argc, char **argv) {
+  boost::mpi::environment mpi_env(argc, argv);
+
+  return boost::unit_test::unit_test_main(init_unit_test, argc, argv);
+}
@@ -72,3 +72,33 @@ BOOST_AUTO_TEST_CASE(link_cell) {
       ++it;
     }
 }
+
+BOOST_AUTO_TEST_CASE(link_cell_neighbors) {
+  std::vector<Cell> cells(3);
+  std::vector<Cell *> const neighbors_0 = {&cells[1], &cells[2]};
+  std::vector<Cell *> const neighbors_1 = {&cells[2]};
+  cells[0].m_neighbors = Neighbors<Cell *>(neighbors_0, {});
+  cells[1].m_neighbors = Neighbors<Cell *>(neighbors_1, {});
+
+  auto id = 0;
+  for (auto &c : cells) {
+    c.particles().resize(3);
+    for (auto &p : c.particles()) {
+      p.p.identity = id++;
+    }
+  }
+
+  std::vector<std::pair<int, int>> pairs;
+  Algorithm::link_cell_neighbors(
+      cells.begin(), cells.begin() + 2,
+      [&pairs](Particle const &p1, Particle const &p2) {
+        pairs.emplace_back(p1.p.identity, p2.p.identity);
+      });
+
+  /* Only pairs between different cells, the pairs within cells are
+   * left out. */
+  BOOST_CHECK_EQUAL(pairs.size(), 3u * 6u + 3u * 3u);
+  for (auto const &pair : pairs) {
+    BOOST_CHECK_NE(pair.first / 3, pair.second / 3);
+  }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE load balancing test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "load_balancing.hpp"
+
+#include <cstddef>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(balanced_loads) {
+  std::vector<double> const cuts = {0., 0.25, 0.5, 0.75, 1.};
+  auto const new_cuts = balance_cuts(cuts, {1., 1., 1., 1.}, 0.1, 0.5);
+  BOOST_CHECK(new_cuts == cuts);
+}
+
+BOOST_AUTO_TEST_CASE(uniform_density) {
+  /* The load is proportional to the width of the slabs,
+   * so the balanced cuts are equidistant. */
+  std::vector<double> const cuts = {0., 0.1, 0.6, 1.};
+  auto const new_cuts = balance_cuts(cuts, {0.1, 0.5, 0.4}, 0., 1.);
+
+  BOOST_REQUIRE_EQUAL(new_cuts.size(), cuts.size());
+  BOOST_CHECK_EQUAL(new_cuts.front(), 0.);
+  BOOST_CHECK_EQUAL(new_cuts.back(), 1.);
+  BOOST_CHECK_CLOSE(new_cuts[1], 1. / 3., 1e-10);
+  BOOST_CHECK_CLOSE(new_cuts[2], 2. / 3., 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(relaxation) {
+  std::vector<double> const cuts = {0., 0.5, 1.};
+  /* Balanced at 0.25 */
+  auto const new_cuts = balance_cuts(cuts, {2., 0.}, 0., 0.5);
+  BOOST_CHECK_CLOSE(new_cuts[1], 0.375, 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(min_width) {
+  std::vector<double> const cuts = {0., 0.25, 0.5, 0.75, 1.};
+  /* All of the load is in the first slab */
+  auto const new_cuts = balance_cuts(cuts, {1., 0., 0., 0.}, 0.2, 1.);
+
+  for (std::size_t i = 1; i < new_cuts.size(); i++) {
+    BOOST_CHECK_GE(new_cuts[i] - new_cuts[i - 1], 0.2 - 1e-12);
+  }
+  BOOST_CHECK_EQUAL(new_cuts.back(), 1.);
+
+  /* No valid cuts */
+  BOOST_CHECK(balance_cuts(cuts, {1., 0., 0., 0.}, 0.3, 1.) == cuts);
+}
+
+BOOST_AUTO_TEST_CASE(no_load) {
+  std::vector<double> const cuts = {0., 0.3, 1.};
+  BOOST_CHECK(balance_cuts(cuts, {0., 0.}, 0., 0.5) == cuts);
+}
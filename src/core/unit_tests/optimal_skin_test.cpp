@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE optimal skin test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "tuning.hpp"
+
+#include <utils/math/int_pow.hpp>
+
+/* Modelled time per step, see optimal_skin() */
+double step_time(double cutoff, double skin0, double pair_time,
+                 double rebuild_time, double rebuild_rate, double skin) {
+  return pair_time * Utils::int_pow<3>((cutoff + skin) / (cutoff + skin0)) +
+         rebuild_time * rebuild_rate * skin0 / skin;
+}
+
+BOOST_AUTO_TEST_CASE(minimum) {
+  auto const cutoff = 1.5, skin0 = 0.4, pair_time = 1e-3,
+             rebuild_time = 4e-3, rebuild_rate = 0.1;
+  auto const skin = optimal_skin(cutoff, skin0, pair_time, rebuild_time,
+                                 rebuild_rate, 0.01, 5.);
+
+  BOOST_CHECK_GT(skin, 0.01);
+  BOOST_CHECK_LT(skin, 5.);
+
+  auto const t = [=](double s) {
+    return step_time(cutoff, skin0, pair_time, rebuild_time, rebuild_rate, s);
+  };
+  BOOST_CHECK_LT(t(skin), t(0.99 * skin));
+  BOOST_CHECK_LT(t(skin), t(1.01 * skin));
+}
+
+BOOST_AUTO_TEST_CASE(more_rebuilds_larger_skin) {
+  auto const skin_few = optimal_skin(1., 0.3, 1e-3, 1e-3, 0.05, 0.01, 5.);
+  auto const skin_many = optimal_skin(1., 0.3, 1e-3, 1e-3, 0.5, 0.01, 5.);
+  BOOST_CHECK_GT(skin_many, skin_few);
+}
+
+BOOST_AUTO_TEST_CASE(bounds) {
+  /* Rebuilds are free */
+  BOOST_CHECK_EQUAL(optimal_skin(1., 0.3, 1e-3, 0., 0.1, 0.01, 5.), 0.01);
+  /* Pair evaluation is free */
+  BOOST_CHECK_EQUAL(optimal_skin(1., 0.3, 0., 1e-3, 0.1, 0.01, 5.), 5.);
+}
@@ -54,3 +54,39 @@ BOOST_AUTO_TEST_CASE(calc_meshift_true) {
     }
   }
 }
+
+#if defined(P3M) || defined(DP3M)
+#include "electrostatics_magnetostatics/p3m_influence_function.hpp"
+
+#include <utils/Vector.hpp>
+
+BOOST_AUTO_TEST_CASE(G_opt_ad_without_aliasing) {
+  /* Without aliasing terms, the optimal influence functions for
+   * i*k and analytical differentiation are the same. */
+  auto const h = Utils::Vector3d{0.5, 0.4, 0.3};
+  for (auto const &k : {Utils::Vector3d{1.0, 0.0, 0.0},
+                        Utils::Vector3d{-2.0, 3.0, 0.5},
+                        Utils::Vector3d{0.1, -0.2, 4.0}}) {
+    for (size_t cao = 1; cao <= 7; cao++) {
+      BOOST_CHECK_CLOSE(G_opt_ad<0>(cao, 1.1, k, h),
+                        (G_opt<1, 0>(cao, 1.1, k, h)), 1e-10);
+    }
+  }
+
+  BOOST_CHECK_EQUAL(G_opt_ad<1>(5, 1.1, Utils::Vector3d{}, h), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(self_force_sums_ad_symmetry) {
+  /* The sums are even in k, so that the self force coefficients
+   * do not depend on the sign convention of the k-space mesh. */
+  auto const h = Utils::Vector3d{0.5, 0.4, 0.3};
+  auto const k = Utils::Vector3d{1.0, -2.0, 3.5};
+  for (size_t cao = 2; cao <= 7; cao++) {
+    auto const plus = detail::self_force_sums_ad<1>(cao, k, h);
+    auto const minus = detail::self_force_sums_ad<1>(cao, -k, h);
+    for (size_t i = 0; i < 6; i++) {
+      BOOST_CHECK_CLOSE(plus[i], minus[i], 1e-10);
+    }
+  }
+}
+#endif
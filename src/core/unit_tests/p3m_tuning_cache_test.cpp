@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Unit tests for the P3M tuning cache. */
+
+#define BOOST_TEST_MODULE p3m tuning cache test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "electrostatics_magnetostatics/p3m_tuning_cache.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+
+namespace {
+P3MTuningKey key(double box_l, int n_part, double accuracy) {
+  return {"p3m", {box_l, box_l, box_l}, {2, 1, 1}, n_part, 0.5 * n_part,
+          accuracy, 1.0, {0., 0., 0., 0., 0.1, 0.}};
+}
+
+P3MTuningResult result(int mesh, int cao) {
+  return {{mesh, mesh, mesh}, cao, 0.1, 1.2, 1e-4, 1.5};
+}
+
+struct TemporaryFile {
+  std::string const path =
+      (boost::filesystem::temp_directory_path() /
+       boost::filesystem::unique_path("p3m_tuning_cache_%%%%%%%%.txt"))
+          .string();
+  ~TemporaryFile() { boost::filesystem::remove(path); }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(missing_file) {
+  TemporaryFile file;
+  BOOST_CHECK(p3m_tuning_cache_read(file.path).empty());
+}
+
+BOOST_AUTO_TEST_CASE(roundtrip) {
+  TemporaryFile file;
+  BOOST_REQUIRE(p3m_tuning_cache_write(file.path, {key(10., 100, 1e-3),
+                                                   result(16, 5)}));
+  /* comments and malformed lines are skipped */
+  {
+    std::ofstream out(file.path, std::ios::app);
+    out << "# comment\n\np3m 1 2 3\n";
+  }
+  auto const k = key(10. / 3., 1000, 1e-4);
+  BOOST_REQUIRE(p3m_tuning_cache_write(file.path, {k, result(32, 7)}));
+
+  auto const entries = p3m_tuning_cache_read(file.path);
+  BOOST_REQUIRE_EQUAL(entries.size(), 2);
+  auto const &e = entries[1];
+  BOOST_CHECK_EQUAL(e.key.method, k.method);
+  BOOST_CHECK(e.key.box_l == k.box_l);
+  BOOST_CHECK(e.key.node_grid == k.node_grid);
+  BOOST_CHECK_EQUAL(e.key.n_part, k.n_part);
+  BOOST_CHECK_EQUAL(e.key.sum_sq, k.sum_sq);
+  BOOST_CHECK_EQUAL(e.key.accuracy, k.accuracy);
+  BOOST_CHECK(e.key.options == k.options);
+  BOOST_CHECK(e.result.mesh == Utils::Vector3i::broadcast(32));
+  BOOST_CHECK_EQUAL(e.result.cao, 7);
+  BOOST_CHECK_EQUAL(e.result.r_cut_iL, 0.1);
+  BOOST_CHECK_EQUAL(e.result.alpha_L, 1.2);
+  BOOST_CHECK_EQUAL(e.result.accuracy, 1e-4);
+  BOOST_CHECK_EQUAL(e.result.time, 1.5);
+}
+
+BOOST_AUTO_TEST_CASE(distance) {
+  BOOST_CHECK_EQUAL(
+      p3m_tuning_cache_distance(key(10., 100, 1e-3), key(10., 100, 1e-3)), 0.);
+  /* squared logarithms of the ratios of the particle numbers and the sums
+   * of the squared charges */
+  BOOST_CHECK_CLOSE(
+      p3m_tuning_cache_distance(key(10., 100, 1e-3), key(10., 200, 1e-3)),
+      2. * std::log(2.) * std::log(2.), 1e-10);
+  BOOST_CHECK_CLOSE(
+      p3m_tuning_cache_distance(key(10., 100, 1e-3), key(20., 100, 1e-3)),
+      std::log(8.) * std::log(8.), 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE(find) {
+  std::vector<P3MTuningCacheEntry> const entries = {
+      {key(10., 100, 1e-3), result(16, 5)},
+      {key(20., 800, 1e-3), result(32, 5)},
+      {key(10., 100, 1e-3), result(18, 6)}};
+
+  /* the most recent result for the same system */
+  auto const same = p3m_tuning_cache_find(entries, key(10., 100, 1e-3));
+  BOOST_REQUIRE(same);
+  BOOST_CHECK_EQUAL(same->cao, 6);
+
+  BOOST_CHECK(not p3m_tuning_cache_find(entries, key(10., 101, 1e-3)));
+  BOOST_CHECK(not p3m_tuning_cache_find(entries, key(10., 100, 2e-3)));
+
+  auto similar = p3m_tuning_cache_find_similar(entries, key(19., 700, 1e-3));
+  BOOST_REQUIRE(similar);
+  BOOST_CHECK_EQUAL(similar->result.mesh[0], 32);
+  similar = p3m_tuning_cache_find_similar(entries, key(10., 120, 1e-3));
+  BOOST_REQUIRE(similar);
+  BOOST_CHECK_EQUAL(similar->result.mesh[0], 18);
+
+  /* different setups are never used */
+  auto other = key(10., 100, 1e-3);
+  other.node_grid = {1, 2, 1};
+  BOOST_CHECK(not p3m_tuning_cache_find(entries, other));
+  BOOST_CHECK(not p3m_tuning_cache_find_similar(entries, other));
+  other = key(10., 100, 1e-3);
+  other.options[3] = 7.;
+  BOOST_CHECK(not p3m_tuning_cache_find_similar(entries, other));
+  other = key(10., 100, 1e-3);
+  other.method = "dp3m";
+  BOOST_CHECK(not p3m_tuning_cache_find_similar(entries, other));
+}
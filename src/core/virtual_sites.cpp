@@ -128,9 +128,9 @@ calculate_vs_relate_to_params(Particle const &p_current,
 void local_vs_relate_to(Particle &p_current, Particle const &p_relate_to) {
   // Set the particle id of the particle we want to relate to, the distance
   // and the relative orientation
-  p_current.p.vs_relative.to_particle_id = p_relate_to.identity();
-  std::tie(p_current.p.vs_relative.rel_orientation,
-           p_current.p.vs_relative.distance) =
+  p_current.c.vs_relative.to_particle_id = p_relate_to.identity();
+  std::tie(p_current.c.vs_relative.rel_orientation,
+           p_current.c.vs_relative.distance) =
       calculate_vs_relate_to_params(p_current, p_relate_to);
 }
 
@@ -36,13 +36,15 @@ void set_virtual_sites(std::shared_ptr<VirtualSites> const &v);
 
 #ifdef VIRTUAL_SITES_RELATIVE
 
-/** Setup the @ref ParticleProperties::vs_relative "vs_relative" of a particle
- *  so that the given virtual particle will follow the given real particle.
+/** Setup the @ref ParticleColdProperties::vs_relative "vs_relative" of a
+ *  particle so that the given virtual particle will follow the given real
+ *  particle.
  */
 void vs_relate_to(int part_num, int relate_to);
 
-/** Setup the @ref ParticleProperties::vs_relative "vs_relative" of a particle
- *  so that the given virtual particle will follow the given real particle.
+/** Setup the @ref ParticleColdProperties::vs_relative "vs_relative" of a
+ *  particle so that the given virtual particle will follow the given real
+ *  particle.
  */
 void local_vs_relate_to(Particle &p_current, Particle const &p_relate_to);
 
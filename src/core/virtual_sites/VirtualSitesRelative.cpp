@@ -156,18 +156,18 @@ void VirtualSitesRelative::update() const {
     if (!p.p.is_virtual)
       continue;
 
-    const Particle *p_ref = get_reference_particle(p.p.vs_relative);
+    const Particle *p_ref = get_reference_particle(p.c.vs_relative);
 
-    auto const new_pos = position(p_ref, p.p.vs_relative);
+    auto const new_pos = position(p_ref, p.c.vs_relative);
     /* The shift has to respect periodic boundaries: if the reference
      * particles is not in the same image box, we potentially avoid to shift
      * to the other side of the box. */
     p.r.p += get_mi_vector(new_pos, p.r.p, box_geo);
 
-    p.m.v = velocity(p_ref, p.p.vs_relative);
+    p.m.v = velocity(p_ref, p.c.vs_relative);
 
     if (get_have_quaternion())
-      p.r.quat = orientation(p_ref, p.p.vs_relative);
+      p.r.quat = orientation(p_ref, p.c.vs_relative);
 
     if ((p.r.p - p.l.p_old).norm2() > Utils::sqr(0.5 * skin))
       cell_structure.set_resort_particles(Cells::RESORT_LOCAL);
@@ -186,10 +186,10 @@ void VirtualSitesRelative::back_transfer_forces_and_torques() const {
     // We only care about virtual particles
     if (p.p.is_virtual) {
       // First obtain the real particle responsible for this virtual particle:
-      Particle *p_ref = get_reference_particle(p.p.vs_relative);
+      Particle *p_ref = get_reference_particle(p.c.vs_relative);
 
       // Add forces and torques
-      p_ref->f += constraint_force(p.f, p_ref, p.p.vs_relative);
+      p_ref->f += constraint_force(p.f, p_ref, p.c.vs_relative);
     }
   }
 }
@@ -203,9 +203,9 @@ Utils::Matrix<double, 3, 3> VirtualSitesRelative::pressure_tensor() const {
       continue;
 
     // First obtain the real particle responsible for this virtual particle:
-    const Particle *p_ref = get_reference_particle(p.p.vs_relative);
+    const Particle *p_ref = get_reference_particle(p.c.vs_relative);
 
-    pressure_tensor += constraint_stress(p.f.f, p_ref, p.p.vs_relative);
+    pressure_tensor += constraint_stress(p.f.f, p_ref, p.c.vs_relative);
   }
 
   return pressure_tensor;
@@ -28,10 +28,19 @@ cdef extern from "communication.hpp":
 cdef extern from "cells.hpp":
     int CELL_STRUCTURE_DOMDEC
     int CELL_STRUCTURE_NSQUARE
+    int CELL_STRUCTURE_EIGHTH_SHELL
 
     ctypedef struct CellStructure:
         int decomposition_type()
         bool use_verlet_list
+        bool use_cluster_pair_list
+        bool use_pair_class_lists
+        bool use_ghost_overlap
+        bool use_ghost_position_deltas
+        bool use_soa_kernels
+        bool use_morton_order
+        bool use_neighbor_collectives
+        bool use_shared_memory
 
     CellStructure cell_structure
 
@@ -42,11 +51,31 @@ cdef extern from "cells.hpp":
     vector[int] mpi_resort_particles(int global_flag)
     void mpi_bcast_cell_structure(int cs)
     void mpi_set_use_verlet_lists(bool use_verlet_lists)
+    void mpi_set_use_cluster_pair_list(bool use_cluster_pair_list)
+    void mpi_set_use_pair_class_lists(bool use_pair_class_lists)
+    void mpi_set_use_ghost_overlap(bool use_ghost_overlap)
+    void mpi_set_use_ghost_position_deltas(bool use_ghost_position_deltas)
+    void mpi_set_use_soa_kernels(bool use_soa_kernels)
+    void mpi_set_use_morton_order(bool use_morton_order)
+    void mpi_set_use_neighbor_collectives(bool use_neighbor_collectives)
+    void mpi_set_use_shared_memory(bool use_shared_memory)
+
+cdef extern from "forces.hpp":
+    double mpi_ghost_position_deltas_force_error() except +
+
+cdef extern from "load_balancing.hpp":
+    int load_balancing_interval
+    void mpi_set_load_balancing_interval(int interval)
 
 cdef extern from "tuning.hpp":
     cdef void c_tune_skin "tune_skin" (double min_skin, double max_skin, double tol, int int_steps, bool adjust_max_skin)
+    int adaptive_skin_interval
+    void mpi_set_adaptive_skin_interval(int interval)
 
 cdef extern from "DomainDecomposition.hpp":
     cppclass  DomainDecomposition:
         Vector3i cell_grid
         double cell_size[3]
+        bool morton_order()
+        bool neighbor_collectives()
+        bool shared_memory()
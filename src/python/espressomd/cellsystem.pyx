@@ -29,7 +29,10 @@ from .utils cimport handle_errors, Vector3i, check_type_or_throw_except
 
 
 cdef class CellSystem:
-    def set_domain_decomposition(self, use_verlet_lists=True):
+    def set_domain_decomposition(self, use_verlet_lists=True,
+                                 use_morton_order=False,
+                                 use_neighbor_collectives=False,
+                                 use_shared_memory=False):
         """
         Activates domain decomposition cell system.
 
@@ -38,14 +41,64 @@ cdef class CellSystem:
         use_verlet_lists : :obj:`bool`, optional
             Activates or deactivates the usage of Verlet lists
             in the algorithm.
+        use_morton_order : :obj:`bool`, optional
+            Traverse the cells in Morton order and sort the particles
+            within the cells in Morton order on every resort.
+        use_neighbor_collectives : :obj:`bool`, optional
+            Exchange the ghosts of every direction by one neighborhood
+            collective instead of point-to-point messages.
+        use_shared_memory : :obj:`bool`, optional
+            Exchange the ghosts with the nodes on the same host through
+            a shared-memory window instead of messages.
 
         """
         mpi_set_use_verlet_lists(use_verlet_lists)
+        mpi_set_use_morton_order(use_morton_order)
+        mpi_set_use_neighbor_collectives(use_neighbor_collectives)
+        mpi_set_use_shared_memory(use_shared_memory)
         mpi_bcast_cell_structure(CELL_STRUCTURE_DOMDEC)
 
         handle_errors("Error while initializing the cell system.")
         return True
 
+    def set_eighth_shell(self, use_verlet_lists=True,
+                         use_morton_order=False,
+                         use_neighbor_collectives=False,
+                         use_shared_memory=False):
+        """
+        Activates the domain decomposition cell system with the
+        eighth-shell method: the ghosts are only imported from the
+        upper neighbors, which roughly halves the ghost communication
+        and the force reduction. The partners of a particle across the
+        lower boundaries of the local box are not among its ghosts, so
+        the integration fails if there are bonds or virtual sites, or if
+        collision detection is active.
+
+        Parameters
+        ----------
+        use_verlet_lists : :obj:`bool`, optional
+            Activates or deactivates the usage of Verlet lists
+            in the algorithm.
+        use_morton_order : :obj:`bool`, optional
+            Traverse the cells in Morton order and sort the particles
+            within the cells in Morton order on every resort.
+        use_neighbor_collectives : :obj:`bool`, optional
+            Exchange the ghosts of every direction by one neighborhood
+            collective instead of point-to-point messages.
+        use_shared_memory : :obj:`bool`, optional
+            Exchange the ghosts with the nodes on the same host through
+            a shared-memory window instead of messages.
+
+        """
+        mpi_set_use_verlet_lists(use_verlet_lists)
+        mpi_set_use_morton_order(use_morton_order)
+        mpi_set_use_neighbor_collectives(use_neighbor_collectives)
+        mpi_set_use_shared_memory(use_shared_memory)
+        mpi_bcast_cell_structure(CELL_STRUCTURE_EIGHTH_SHELL)
+
+        handle_errors("Error while initializing the cell system.")
+        return True
+
     def set_n_square(self, use_verlet_lists=True):
         """
         Activates the nsquare force calculation.
@@ -65,49 +118,110 @@ cdef class CellSystem:
     def get_state(self):
         s = {"use_verlet_list": cell_structure.use_verlet_list}
 
-        if cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC:
+        if cell_structure.decomposition_type() in (
+                CELL_STRUCTURE_DOMDEC, CELL_STRUCTURE_EIGHTH_SHELL):
             dd = get_domain_decomposition()
             s["type"] = "domain_decomposition"
+            if cell_structure.decomposition_type() == \
+                    CELL_STRUCTURE_EIGHTH_SHELL:
+                s["type"] = "eighth_shell"
             s["cell_grid"] = np.array(
                 [dd.cell_grid[0], dd.cell_grid[1], dd.cell_grid[2]])
             s["cell_size"] = np.array(
                 [dd.cell_size[0], dd.cell_size[1], dd.cell_size[2]])
+            s["use_morton_order"] = dd.morton_order()
+            s["use_neighbor_collectives"] = dd.neighbor_collectives()
+            s["use_shared_memory"] = dd.shared_memory()
 
         if cell_structure.decomposition_type() == CELL_STRUCTURE_NSQUARE:
             s["type"] = "nsquare"
 
         s["skin"] = skin
         s["verlet_reuse"] = verlet_reuse
+        s["use_cluster_pair_list"] = cell_structure.use_cluster_pair_list
+        s["use_pair_class_lists"] = cell_structure.use_pair_class_lists
+        s["use_ghost_overlap"] = cell_structure.use_ghost_overlap
+        s["use_ghost_position_deltas"] = \
+            cell_structure.use_ghost_position_deltas
+        s["use_soa_kernels"] = cell_structure.use_soa_kernels
+        s["load_balancing_interval"] = load_balancing_interval
+        s["adaptive_skin_interval"] = adaptive_skin_interval
         s["n_nodes"] = n_nodes
         s["node_grid"] = np.array([node_grid[0], node_grid[1], node_grid[2]])
 
         return s
 
     def __getstate__(self):
-        s = {"use_verlet_list": cell_structure.use_verlet_list}
+        s = {"use_verlet_list": cell_structure.use_verlet_list,
+             "use_morton_order": cell_structure.use_morton_order,
+             "use_neighbor_collectives":
+                 cell_structure.use_neighbor_collectives,
+             "use_shared_memory": cell_structure.use_shared_memory}
 
         if cell_structure.decomposition_type() == CELL_STRUCTURE_DOMDEC:
             s["type"] = "domain_decomposition"
+        if cell_structure.decomposition_type() == CELL_STRUCTURE_EIGHTH_SHELL:
+            s["type"] = "eighth_shell"
         if cell_structure.decomposition_type() == CELL_STRUCTURE_NSQUARE:
             s["type"] = "nsquare"
 
         s["skin"] = skin
         s["node_grid"] = np.array([node_grid[0], node_grid[1], node_grid[2]])
+        s["use_cluster_pair_list"] = cell_structure.use_cluster_pair_list
+        s["use_pair_class_lists"] = cell_structure.use_pair_class_lists
+        s["use_ghost_overlap"] = cell_structure.use_ghost_overlap
+        s["use_ghost_position_deltas"] = \
+            cell_structure.use_ghost_position_deltas
+        s["use_soa_kernels"] = cell_structure.use_soa_kernels
+        s["load_balancing_interval"] = load_balancing_interval
+        s["adaptive_skin_interval"] = adaptive_skin_interval
         return s
 
     def __setstate__(self, d):
         use_verlet_lists = None
+        use_morton_order = False
+        use_neighbor_collectives = False
+        use_shared_memory = False
         for key in d:
             if key == "use_verlet_list":
                 use_verlet_lists = d[key]
+            elif key == "use_morton_order":
+                use_morton_order = d[key]
+            elif key == "use_neighbor_collectives":
+                use_neighbor_collectives = d[key]
+            elif key == "use_shared_memory":
+                use_shared_memory = d[key]
             elif key == "type":
                 if d[key] == "domain_decomposition":
                     self.set_domain_decomposition(
-                        use_verlet_lists=use_verlet_lists)
+                        use_verlet_lists=use_verlet_lists,
+                        use_morton_order=use_morton_order,
+                        use_neighbor_collectives=use_neighbor_collectives,
+                        use_shared_memory=use_shared_memory)
+                elif d[key] == "eighth_shell":
+                    self.set_eighth_shell(
+                        use_verlet_lists=use_verlet_lists,
+                        use_morton_order=use_morton_order,
+                        use_neighbor_collectives=use_neighbor_collectives,
+                        use_shared_memory=use_shared_memory)
                 elif d[key] == "nsquare":
                     self.set_n_square(use_verlet_lists=use_verlet_lists)
         self.skin = d['skin']
         self.node_grid = d['node_grid']
+        if "use_cluster_pair_list" in d:
+            self.use_cluster_pair_list = d["use_cluster_pair_list"]
+        if "use_pair_class_lists" in d:
+            self.use_pair_class_lists = d["use_pair_class_lists"]
+        if "use_ghost_overlap" in d:
+            self.use_ghost_overlap = d["use_ghost_overlap"]
+        if "use_ghost_position_deltas" in d:
+            self.use_ghost_position_deltas = d["use_ghost_position_deltas"]
+        if "use_soa_kernels" in d:
+            self.use_soa_kernels = d["use_soa_kernels"]
+        if "load_balancing_interval" in d:
+            self.load_balancing_interval = d["load_balancing_interval"]
+        if "adaptive_skin_interval" in d:
+            self.adaptive_skin_interval = d["adaptive_skin_interval"]
 
     def get_pairs(self, distance, types='all'):
         """
@@ -216,6 +330,145 @@ cdef class CellSystem:
         def __get__(self):
             return skin
 
+    property use_cluster_pair_list:
+        """
+        Store the Verlet lists as pairs of clusters of four particles
+        with a bitmask of the particle pairs, instead of one entry per
+        particle pair. Only used with the domain decomposition.
+
+        """
+
+        def __set__(self, bool _use_cluster_pair_list):
+            mpi_set_use_cluster_pair_list(_use_cluster_pair_list)
+
+        def __get__(self):
+            return cell_structure.use_cluster_pair_list
+
+    property use_pair_class_lists:
+        """
+        Keep the particle pairs that are only within the cutoff of the
+        electrostatic or magnetostatic interactions in separate Verlet
+        lists, for which the short-range potentials are not evaluated.
+
+        """
+
+        def __set__(self, bool _use_pair_class_lists):
+            mpi_set_use_pair_class_lists(_use_pair_class_lists)
+
+        def __get__(self):
+            return cell_structure.use_pair_class_lists
+
+    property use_ghost_overlap:
+        """
+        Overlap the ghost communication of the integration steps with
+        the force calculation. The exchange of the ghost positions is
+        started before the forces are calculated, and is only waited
+        for after the pairs of the cells that need no ghosts. If no
+        other module adds forces to the ghosts, the ghost forces are
+        sent while the long-range forces are calculated. The
+        summation order of the forces differs from the default.
+
+        """
+
+        def __set__(self, bool _use_ghost_overlap):
+            mpi_set_use_ghost_overlap(_use_ghost_overlap)
+
+        def __get__(self):
+            return cell_structure.use_ghost_overlap
+
+    property use_ghost_position_deltas:
+        """
+        Send the ghost positions of the force calculation between two
+        resorts as single precision displacements from the positions
+        at the last resort, which roughly halves the size of these
+        messages. The positions are sent in full precision with every
+        resort. Not used with the NpT integrator or rigid bonds. The
+        resulting force error can be checked with
+        :meth:`ghost_position_deltas_force_error`.
+
+        """
+
+        def __set__(self, bool _use_ghost_position_deltas):
+            mpi_set_use_ghost_position_deltas(_use_ghost_position_deltas)
+
+        def __get__(self):
+            return cell_structure.use_ghost_position_deltas
+
+    def ghost_position_deltas_force_error(self):
+        """
+        Largest deviation of the force on a particle with
+        :attr:`use_ghost_position_deltas` from the force with full
+        precision ghost positions, in the current state. Only the
+        short-range forces depend on the ghost positions, they are
+        calculated twice. The forces on the particles are not changed.
+
+        Returns
+        -------
+        :obj:`float` :
+            The largest norm of the force difference.
+
+        """
+        return mpi_ghost_position_deltas_force_error()
+
+    property use_soa_kernels:
+        """
+        Compute the non-bonded forces with the structure-of-arrays
+        pair kernels. They support Lennard-Jones without offset, WCA
+        and the real-space part of P3M on the domain decomposition
+        cell system; for any other setup the generic pair loop is used.
+        Exclusions are only supported together with
+        :attr:`use_cluster_pair_list`.
+
+        """
+
+        def __set__(self, bool _use_soa_kernels):
+            mpi_set_use_soa_kernels(_use_soa_kernels)
+
+        def __get__(self):
+            return cell_structure.use_soa_kernels
+
+    property adaptive_skin_interval:
+        """
+        Number of integration steps between two adjustments of the
+        :attr:`skin` during the integration, ``0`` disables the
+        adjustment. The time of the steps with and without a rebuild
+        of the cell system and Verlet lists is measured, and the skin
+        is moved towards the value that minimizes the time per step
+        according to a simple cost model. Unlike :meth:`tune_skin`,
+        this follows changes of the density or temperature in long
+        simulations.
+
+        """
+
+        def __set__(self, int _interval):
+            if _interval < 0:
+                raise ValueError("adaptive_skin_interval must be >= 0")
+            mpi_set_adaptive_skin_interval(_interval)
+
+        def __get__(self):
+            return adaptive_skin_interval
+
+    property load_balancing_interval:
+        """
+        Number of integration steps between two load balancing steps
+        of the domain decomposition, ``0`` disables load balancing.
+        In a load balancing step, the boundaries between the local
+        boxes of the nodes are moved along each direction of the
+        :attr:`node_grid`, such that the time spent in the short-range
+        force calculation becomes equal on all nodes. Disabling load
+        balancing restores equally sized local boxes. Not supported
+        with P3M, ScaFaCoS and lattice-Boltzmann.
+
+        """
+
+        def __set__(self, int _interval):
+            if _interval < 0:
+                raise ValueError("load_balancing_interval must be >= 0")
+            mpi_set_load_balancing_interval(_interval)
+
+        def __get__(self):
+            return load_balancing_interval
+
     def tune_skin(self, min_skin=None, max_skin=None, tol=None,
                   int_steps=None, adjust_max_skin=False):
         """
@@ -21,6 +21,8 @@ include "myconfig.pxi"
 from .utils import is_valid_type, to_str, handle_errors
 from .utils cimport handle_errors
 from libcpp cimport bool
+from libcpp.string cimport string
+from .utils import to_char_pointer
 
 cdef extern from "SystemInterface.hpp":
     cdef cppclass SystemInterface:
@@ -72,7 +74,8 @@ IF ELECTROSTATICS:
             void p3m_set_tune_params(double r_cut, int mesh[3], int cao, double alpha, double accuracy)
             int p3m_set_mesh_offset(double x, double y, double z)
             int p3m_set_eps(double eps)
-            int p3m_adaptive_tune(bool verbose)
+            int p3m_set_analytic_diff(bint analytic_diff)
+            int p3m_adaptive_tune(bool verbose, string cache_file)
 
             ctypedef struct p3m_data_struct:
                 P3MParameters params
@@ -108,8 +111,9 @@ IF ELECTROSTATICS:
             return p3m_set_mesh_offset(
                 mesh_offset[0], mesh_offset[1], mesh_offset[2])
 
-        cdef inline python_p3m_adaptive_tune(bool verbose):
-            cdef int response = p3m_adaptive_tune(verbose)
+        cdef inline python_p3m_adaptive_tune(bool verbose, cache_file):
+            cdef int response = p3m_adaptive_tune(
+                verbose, to_char_pointer(cache_file))
             if response:
                 handle_errors("python_p3m_adaptive_tune")
 
@@ -225,6 +225,16 @@ IF P3M == 1:
         check_neutrality : :obj:`bool`, optional
             Raise a warning if the system is not electrically neutral when
             set to ``True`` (default).
+        analytic_diff : :obj:`bool`, optional
+            Calculate the forces from the gradient of the charge assignment
+            function instead of by :math:`ik` differentiation (default
+            ``False``). This needs one instead of three backward FFTs, but
+            is less accurate for the same mesh and ``cao``, which is taken
+            into account by the tuning. Requires ``cao >= 2``.
+        tuning_cache : :obj:`str`, optional
+            Path of a file in which tuning results are stored. The tuning
+            reuses the result for the same system, or starts from the result
+            for the most similar one. No file is used by default.
 
         """
 
@@ -275,9 +285,20 @@ IF P3M == 1:
                     or self._params["alpha"] > 0):
                 raise ValueError("alpha should be positive")
 
+            check_type_or_throw_except(
+                self._params["analytic_diff"], 1, bool,
+                "analytic_diff should be a bool")
+            check_type_or_throw_except(
+                self._params["tuning_cache"], 1, str,
+                "tuning_cache should be a string")
+            if self._params["analytic_diff"] and self._params["cao"] == 1:
+                raise ValueError(
+                    "P3M analytic_diff requires a cao of at least 2")
+
         def valid_keys(self):
             return ["mesh", "cao", "accuracy", "epsilon", "alpha", "r_cut",
-                    "prefactor", "tune", "check_neutrality", "verbose"]
+                    "prefactor", "tune", "check_neutrality", "verbose",
+                    "analytic_diff", "tuning_cache"]
 
         def required_keys(self):
             return ["prefactor", "accuracy"]
@@ -292,7 +313,9 @@ IF P3M == 1:
                     "mesh_off": [-1, -1, -1],
                     "tune": True,
                     "check_neutrality": True,
-                    "verbose": True}
+                    "verbose": True,
+                    "analytic_diff": False,
+                    "tuning_cache": ""}
 
         def _get_params_from_es_core(self):
             params = {}
@@ -313,6 +336,7 @@ IF P3M == 1:
             #         which resets r_cut if lb is zero. OK.
             # Sets eps, bcast
             p3m_set_eps(self._params["epsilon"])
+            p3m_set_analytic_diff(self._params["analytic_diff"])
             python_p3m_set_mesh_offset(self._params["mesh_off"])
 
         def tune(self, **tune_params_subset):
@@ -327,12 +351,14 @@ IF P3M == 1:
         def _tune(self):
             set_prefactor(self._params["prefactor"])
             p3m_set_eps(self._params["epsilon"])
+            p3m_set_analytic_diff(self._params["analytic_diff"])
             python_p3m_set_tune_params(self._params["r_cut"],
                                        self._params["mesh"],
                                        self._params["cao"],
                                        -1.0,
                                        self._params["accuracy"])
-            python_p3m_adaptive_tune(self._params["verbose"])
+            python_p3m_adaptive_tune(self._params["verbose"],
+                                     self._params["tuning_cache"])
             self._params.update(self._get_params_from_es_core())
 
         def _activate_method(self):
@@ -375,6 +401,10 @@ IF P3M == 1:
             check_neutrality : :obj:`bool`, optional
                 Raise a warning if the system is not electrically neutral when
                 set to ``True`` (default).
+            tuning_cache : :obj:`str`, optional
+                Path of a file in which tuning results are stored. The tuning
+                reuses the result for the same system, or starts from the result
+                for the most similar one. No file is used by default.
 
             """
 
@@ -420,9 +450,14 @@ IF P3M == 1:
                     check_type_or_throw_except(self._params["mesh_off"], 3, float,
                                                "mesh_off should be a (3,) array_like of values between 0.0 and 1.0")
 
+                check_type_or_throw_except(
+                    self._params["tuning_cache"], 1, str,
+                    "tuning_cache should be a string")
+
             def valid_keys(self):
                 return ["mesh", "cao", "accuracy", "epsilon", "alpha", "r_cut",
-                        "prefactor", "tune", "check_neutrality", "verbose"]
+                        "prefactor", "tune", "check_neutrality", "verbose",
+                        "tuning_cache"]
 
             def required_keys(self):
                 return ["prefactor", "accuracy"]
@@ -437,7 +472,8 @@ IF P3M == 1:
                         "mesh_off": [-1, -1, -1],
                         "tune": True,
                         "check_neutrality": True,
-                        "verbose": True}
+                        "verbose": True,
+                        "tuning_cache": ""}
 
             def _get_params_from_es_core(self):
                 params = {}
@@ -459,12 +495,15 @@ IF P3M == 1:
             def _tune(self):
                 set_prefactor(self._params["prefactor"])
                 p3m_set_eps(self._params["epsilon"])
+                # the GPU implementation only has i*k differentiation
+                p3m_set_analytic_diff(False)
                 python_p3m_set_tune_params(self._params["r_cut"],
                                            self._params["mesh"],
                                            self._params["cao"],
                                            -1.0,
                                            self._params["accuracy"])
-                python_p3m_adaptive_tune(self._params["verbose"])
+                python_p3m_adaptive_tune(self._params["verbose"],
+                                         self._params["tuning_cache"])
                 self._params.update(self._get_params_from_es_core())
 
             def _activate_method(self):
@@ -484,6 +523,7 @@ IF P3M == 1:
                                       self._params["alpha"],
                                       self._params["accuracy"])
                 p3m_set_eps(self._params["epsilon"])
+                p3m_set_analytic_diff(False)
                 python_p3m_set_mesh_offset(self._params["mesh_off"])
                 handle_errors("p3m gpu init")
 
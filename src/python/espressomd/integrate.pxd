@@ -29,7 +29,7 @@ cdef extern from "integrate.hpp" nogil:
     cdef int python_integrate(int n_steps, cbool recalc_forces, int reuse_forces)
     cdef int mpi_steepest_descent(int max_steps)
     cdef void integrate_set_sd() except +
-    cdef void integrate_set_nvt()
+    cdef void integrate_set_nvt(int long_range_interval, cbool slow_corrections) except +
     cdef void integrate_set_steepest_descent(const double f_max, const double gamma,
                                              const double max_displacement) except +
     cdef extern cbool skin_set
@@ -67,21 +67,21 @@ cdef class IntegratorHandle:
         """
         self._integrator = SteepestDescent(*args, **kwargs)
 
-    def set_vv(self):
+    def set_vv(self, *args, **kwargs):
         """
         Set the integration method to velocity Verlet, which is suitable for
         simulations in the NVT ensemble (:class:`VelocityVerlet`).
 
         """
-        self._integrator = VelocityVerlet()
+        self._integrator = VelocityVerlet(*args, **kwargs)
 
-    def set_nvt(self):
+    def set_nvt(self, *args, **kwargs):
         """
         Set the integration method to velocity Verlet, which is suitable for
         simulations in the NVT ensemble (:class:`VelocityVerlet`).
 
         """
-        self._integrator = VelocityVerlet()
+        self._integrator = VelocityVerlet(*args, **kwargs)
 
     def set_isotropic_npt(self, *args, **kwargs):
         """
@@ -289,16 +289,27 @@ cdef class VelocityVerlet(Integrator):
     """
     Velocity Verlet integrator, suitable for simulations in the NVT ensemble.
 
+    Parameters
+    ----------
+    long_range_interval : :obj:`int`, optional
+        Calculate the long-range forces only every ``long_range_interval``
+        steps and apply them as impulses (multiple time stepping). See
+        :ref:`Multiple time stepping`. Default is 1.
+    slow_corrections : :obj:`bool`, optional
+        Calculate the ELC and MDLC corrections also only every
+        ``long_range_interval`` steps, instead of on every step.
+        Default is ``False``.
+
     """
 
     def default_params(self):
-        return {}
+        return {"long_range_interval": 1, "slow_corrections": False}
 
     def valid_keys(self):
         """All parameters that can be set.
 
         """
-        return {}
+        return {"long_range_interval", "slow_corrections"}
 
     def required_keys(self):
         """Parameters that have to be set.
@@ -307,10 +318,18 @@ cdef class VelocityVerlet(Integrator):
         return {}
 
     def validate_params(self):
-        return True
+        check_type_or_throw_except(
+            self._params["long_range_interval"], 1, int,
+            "long_range_interval must be an int")
+        if self._params["long_range_interval"] < 1:
+            raise ValueError("long_range_interval must be >= 1")
+        check_type_or_throw_except(
+            self._params["slow_corrections"], 1, bool,
+            "slow_corrections must be a bool")
 
     def _set_params_in_es_core(self):
-        integrate_set_nvt()
+        integrate_set_nvt(self._params["long_range_interval"],
+                          self._params["slow_corrections"])
 
 
 IF NPT:
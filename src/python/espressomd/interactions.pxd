@@ -194,6 +194,20 @@ cdef extern from "nonbonded_interactions/nonbonded_interaction_data.hpp":
     cdef void ia_params_set_state(string)
     cdef void reset_ia_params()
 
+cdef extern from "nonbonded_interactions/pair_spline_tables.hpp":
+    cdef struct PairSplineTableInfo:
+        int type_a
+        int type_b
+        double r_min
+        double r_cut
+        size_t n_intervals
+        double max_error
+
+    int pair_spline_tables_n_intervals
+    double pair_spline_tables_max_force
+    vector[PairSplineTableInfo] pair_spline_tables_info()
+    void mpi_set_pair_spline_tables(int n_intervals, double max_force)
+
 cdef extern from "bonded_interactions/bonded_interaction_data.hpp":
     cdef void make_bond_type_exist(int type)
 
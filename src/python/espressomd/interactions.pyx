@@ -1639,11 +1639,17 @@ cdef class NonBondedInteractions:
     def __getstate__(self):
         cdef string core_state
         core_state = ia_params_get_state()
-        return core_state
+        return (core_state, pair_spline_tables_n_intervals,
+                pair_spline_tables_max_force)
 
-    def __setstate__(self, core_state):
-        cdef string state = core_state
-        ia_params_set_state(state)
+    def __setstate__(self, state):
+        cdef string core_state
+        if isinstance(state, tuple):
+            core_state = state[0]
+            mpi_set_pair_spline_tables(state[1], state[2])
+        else:
+            core_state = state
+        ia_params_set_state(core_state)
 
     def reset(self):
         """
@@ -1652,6 +1658,56 @@ cdef class NonBondedInteractions:
 
         reset_ia_params()
 
+    def set_auto_tabulation(self, n_intervals=1000, max_force=1e4):
+        """
+        Tabulate the isotropic pair potentials of every pair of particle
+        types as a function of the squared distance, and evaluate the
+        forces by cubic spline interpolation. The Gay-Berne, Thole and
+        tabulated interactions, the energies and the pressure are always
+        calculated analytically.
+
+        Parameters
+        ----------
+        n_intervals : :obj:`int`
+            Number of interpolation intervals per pair of types,
+            0 disables the tables.
+        max_force : :obj:`float`
+            The tables start at the distance where the magnitude of the
+            force exceeds this value, closer pairs are calculated
+            analytically.
+
+        """
+        check_type_or_throw_except(
+            n_intervals, 1, int, "n_intervals has to be an integer")
+        check_type_or_throw_except(
+            max_force, 1, float, "max_force has to be a float")
+        if n_intervals < 0:
+            raise ValueError("n_intervals has to be >= 0")
+        if max_force <= 0.:
+            raise ValueError("max_force has to be > 0")
+        mpi_set_pair_spline_tables(n_intervals, max_force)
+
+    def get_auto_tabulation(self):
+        """
+        Parameters, resolution and accuracy of the automatic tables, see
+        :meth:`set_auto_tabulation`. The entry ``tables`` holds for every
+        pair of types with tabulated potentials the range of the table,
+        the number of intervals and the largest deviation of the
+        interpolated force from the analytic one, sampled between the
+        grid points.
+
+        """
+        tables = []
+        for info in pair_spline_tables_info():
+            tables.append({"types": (info.type_a, info.type_b),
+                           "r_min": info.r_min,
+                           "r_cut": info.r_cut,
+                           "n_intervals": info.n_intervals,
+                           "max_error": info.max_error})
+        return {"n_intervals": pair_spline_tables_n_intervals,
+                "max_force": pair_spline_tables_max_force,
+                "tables": tables}
+
 cdef class BondedInteraction:
     """
     Base class for bonded interactions.
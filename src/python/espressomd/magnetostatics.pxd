@@ -16,7 +16,9 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 from libcpp cimport bool
+from libcpp.string cimport string
 from .utils cimport handle_errors
+from .utils import to_char_pointer
 
 include "myconfig.pxi"
 
@@ -67,7 +69,7 @@ IF DP3M == 1:
         void dp3m_set_tune_params(double r_cut, int mesh, int cao, double alpha, double accuracy)
         int dp3m_set_mesh_offset(double x, double y, double z)
         int dp3m_set_eps(double eps)
-        int dp3m_adaptive_tune(bool verbose)
+        int dp3m_adaptive_tune(bool verbose, string cache_file)
         int dp3m_deactivate()
 
         ctypedef struct dp3m_data_struct:
@@ -75,7 +77,8 @@ IF DP3M == 1:
 
         cdef extern dp3m_data_struct dp3m
 
-    cdef inline python_dp3m_adaptive_tune(bool verbose):
-        cdef int response = dp3m_adaptive_tune(verbose)
+    cdef inline python_dp3m_adaptive_tune(bool verbose, cache_file):
+        cdef int response = dp3m_adaptive_tune(
+            verbose, to_char_pointer(cache_file))
         if response:
             handle_errors("python_dp3m_adaptive_tune")
@@ -86,6 +86,10 @@ IF DP3M == 1:
         tune : :obj:`bool`, optional
             Activate/deactivate the tuning method on activation
             (default is ``True``, i.e., activated).
+        tuning_cache : :obj:`str`, optional
+            Path of a file in which tuning results are stored. The tuning
+            reuses the result for the same system, or starts from the result
+            for the most similar one. No file is used by default.
 
         """
 
@@ -96,6 +100,10 @@ IF DP3M == 1:
             super().validate_params()
             default_params = self.default_params()
 
+            check_type_or_throw_except(
+                self._params["tuning_cache"], 1, str,
+                "tuning_cache should be a string")
+
             if not (self._params["r_cut"] >= 0
                     or self._params["r_cut"] == default_params["r_cut"]):
                 raise ValueError("P3M r_cut has to be >=0")
@@ -131,7 +139,8 @@ IF DP3M == 1:
         def valid_keys(self):
             return ["prefactor", "alpha_L", "r_cut_iL", "mesh", "mesh_off",
                     "cao", "accuracy", "epsilon", "cao_cut", "a", "ai",
-                    "alpha", "r_cut", "cao3", "additional_mesh", "tune", "verbose"]
+                    "alpha", "r_cut", "cao3", "additional_mesh", "tune",
+                    "verbose", "tuning_cache"]
 
         def required_keys(self):
             return ["accuracy", ]
@@ -144,7 +153,8 @@ IF DP3M == 1:
                     "epsilon": 0.0,
                     "mesh_off": [-1, -1, -1],
                     "tune": True,
-                    "verbose": True}
+                    "verbose": True,
+                    "tuning_cache": ""}
 
         def _get_params_from_es_core(self):
             params = {}
@@ -167,7 +177,8 @@ IF DP3M == 1:
             self.python_dp3m_set_tune_params(
                 self._params["r_cut"], self._params["mesh"],
                 self._params["cao"], -1., self._params["accuracy"])
-            python_dp3m_adaptive_tune(self._params["verbose"])
+            python_dp3m_adaptive_tune(self._params["verbose"],
+                                      self._params["tuning_cache"])
             self._params.update(self._get_params_from_es_core())
 
         def _activate_method(self):
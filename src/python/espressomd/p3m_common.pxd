@@ -26,6 +26,7 @@ IF P3M == 1 or DP3M == 1:
             int    cao
             double accuracy
             double epsilon
+            bint   analytic_diff
             double cao_cut[3]
             double a[3]
             double alpha
@@ -83,15 +83,20 @@ cdef extern from "particle_data.hpp":
 
     int place_particle(int part, double p[3])
 
+    void place_new_particles(vector[particle] particles) except +
+
     void set_particle_v(int part, double v[3])
+    void set_particles_v(const vector[int] & ids, const vector[Vector3d] & v) except +
 
     void set_particle_f(int part, const Vector3d & F)
+    void set_particles_f(const vector[int] & ids, const vector[Vector3d] & F) except +
 
     IF ROTATION:
         void set_particle_rotation(int part, int rot)
 
     IF MASS:
         void set_particle_mass(int part, double mass)
+        void set_particles_mass(const vector[int] & ids, const vector[double] & mass) except +
 
     IF ROTATIONAL_INERTIA:
         void set_particle_rotational_inertia(int part, double rinertia[3])
@@ -101,14 +106,17 @@ cdef extern from "particle_data.hpp":
         void set_particle_rotation(int part, int rot)
 
     void set_particle_q(int part, double q)
+    void set_particles_q(const vector[int] & ids, const vector[double] & q) except +
 
     IF LB_ELECTROHYDRODYNAMICS:
         void set_particle_mu_E(int part, const Vector3d & mu_E)
         void get_particle_mu_E(int part, Vector3d & mu_E)
 
     void set_particle_type(int part, int type)
+    void set_particles_type(const vector[int] & ids, const vector[int] & types) except +
 
     void set_particle_mol_id(int part, int mid)
+    void set_particles_mol_id(const vector[int] & ids, const vector[int] & mid) except +
 
     IF ROTATION:
         void set_particle_quat(int part, double quat[4])
@@ -182,6 +190,8 @@ cdef extern from "particle_data.hpp":
 
     void remove_all_particles() except +
 
+    void remove_particles(const vector[int] & ids) except +
+
     void remove_all_bonds_to(int part)
 
     bool particle_exists(int part)
@@ -191,6 +201,10 @@ cdef extern from "particle_data.hpp":
     const particle & get_particle_data(int id) except +
 
     vector[int] get_particle_ids() except +
+    vector[double] gather_particle_positions(vector[int] & ids)
+    vector[double] gather_particle_velocities(vector[int] & ids)
+    vector[double] gather_particle_forces(vector[int] & ids)
+    vector[int] gather_particle_types(vector[int] & ids)
 
     int get_maximal_particle_id()
     int get_n_part()
@@ -1683,8 +1683,7 @@ cdef class _ParticleSliceImpl:
         :meth:`espressomd.particle_data.ParticleList.add`
 
         """
-        for id in self.id_selection:
-            ParticleHandle(id).remove()
+        remove_particles(self.id_selection)
 
 
 class ParticleSlice(_ParticleSliceImpl):
@@ -1900,15 +1899,45 @@ Set quat and scalar dipole moment (dipm) instead.")
             first_id = get_maximal_particle_id() + 1
             Ps["id"] = range(first_id, first_id + n_parts)
 
-        # Place the particles
+        IF DIPOLES:
+            if 'dip' in Ps and 'dipm' in Ps:
+                raise ValueError("Contradicting attributes: dip and dipm. Setting \
+dip is sufficient as the length of the vector defines the scalar dipole moment.")
+            IF ROTATION:
+                if 'dip' in Ps and 'quat' in Ps:
+                    raise ValueError("Contradicting attributes: dip and quat. \
+Setting dip overwrites the rotation of the particle around the dipole axis. \
+Set quat and scalar dipole moment (dipm) instead.")
+
+        # Create all particles at their positions with one collective
+        ids = list(Ps["id"])
+        for pid in ids:
+            if not is_valid_type(pid, int):
+                raise TypeError(
+                    f"Particle id must be an integer but got {pid}")
+        pos = np.array(Ps["pos"], dtype=float)
+        if pos.shape != (n_parts, 3):
+            raise ValueError("Position must be 3 floats.")
+
+        cdef vector[particle] particles
+        cdef particle p
+        cdef Vector3d r
+        particles.reserve(n_parts)
         for i in range(n_parts):
-            P = {}
-            for k in Ps:
-                P[k] = Ps[k][i]
-            self._place_new_particle(P)
+            p.p.identity = ids[i]
+            for j in range(3):
+                r[j] = pos[i, j]
+            p.r.p = r
+            particles.push_back(p)
+        place_new_particles(particles)
+
+        # Set the other properties on all new particles at once
+        added = self[ids]
+        for k in Ps:
+            if k not in ("id", "pos"):
+                setattr(added, k, Ps[k])
 
-        # Return slice of added particles
-        return self[Ps["id"]]
+        return added
 
     # Iteration over all existing particles
     def __iter__(self):
@@ -2099,15 +2128,117 @@ Set quat and scalar dipole moment (dipm) instead.")
 
 
 def set_slice_one_for_all(particle_slice, attribute, values):
+    if attribute in batched_attributes:
+        set_slice_batched(particle_slice, attribute,
+                          len(particle_slice.id_selection) * [values])
+        return
     for i in particle_slice.id_selection:
         setattr(ParticleHandle(i), attribute, values)
 
 
 def set_slice_one_for_each(particle_slice, attribute, values):
+    if attribute in batched_attributes:
+        set_slice_batched(particle_slice, attribute, values)
+        return
     for i, v in zip(particle_slice.id_selection, values):
         setattr(ParticleHandle(i), attribute, v)
 
 
+# Attributes that are set on all particles of a slice with one message per
+# node instead of one message per particle
+batched_attributes = {"type", "mol_id", "q", "mass", "v", "f"}
+
+
+def set_slice_batched(particle_slice, attribute, values):
+    """
+    Set an attribute in :attr:`batched_attributes` to one value per
+    member of particle_slice. The values are checked like in the setters
+    of :class:`ParticleHandle`.
+
+    """
+    cdef vector[int] ids = particle_slice.id_selection
+    cdef vector[int] ints
+    cdef vector[double] doubles
+    cdef vector[Vector3d] vectors
+    cdef Vector3d vec
+    messages = {"q": "Charge has to be floats.",
+                "mass": "Mass has to be 1 float",
+                "v": "Velocity has to be floats",
+                "f": "Force has to be floats"}
+
+    if attribute in ("type", "mol_id"):
+        for x in values:
+            if not (is_valid_type(x, int) and x >= 0):
+                raise ValueError(f"{attribute} must be an integer >= 0")
+            ints.push_back(x)
+        if attribute == "type":
+            set_particles_type(ids, ints)
+        else:
+            set_particles_mol_id(ids, ints)
+    elif attribute in ("q", "mass"):
+        for x in values:
+            check_type_or_throw_except(
+                x, 1, float, messages[attribute])
+            doubles.push_back(x)
+        if attribute == "q":
+            set_particles_q(ids, doubles)
+        else:
+            IF MASS == 1:
+                set_particles_mass(ids, doubles)
+            ELSE:
+                raise AttributeError("You are trying to set the particle mass \
+                                     but the mass feature is not compiled in.")
+    elif attribute in ("v", "f"):
+        for x in values:
+            check_type_or_throw_except(
+                x, 3, float, messages[attribute])
+            for i in range(3):
+                vec[i] = x[i]
+            vectors.push_back(vec)
+        if attribute == "v":
+            set_particles_v(ids, vectors)
+        else:
+            set_particles_f(ids, vectors)
+
+
+# Attributes that are read for large slices from contiguous arrays of all
+# particles, which are gathered with one collective per attribute
+gathered_attributes = {"pos", "v", "f", "type"}
+
+
+def get_slice_gathered(particle_slice, attribute):
+    """
+    Get an attribute in :attr:`gathered_attributes` of all members of
+    particle_slice from the array of the attribute of all particles.
+
+    """
+    cdef vector[int] ids
+    cdef vector[double] doubles
+    cdef vector[int] ints
+    cdef np.ndarray[double, ndim=1] double_values
+    cdef np.ndarray[long, ndim=1] long_values
+    cdef size_t i
+    if attribute == "type":
+        ints = gather_particle_types(ids)
+        long_values = np.empty(ints.size(), dtype=int)
+        for i in range(ints.size()):
+            long_values[i] = ints[i]
+        values = long_values
+    else:
+        if attribute == "pos":
+            doubles = gather_particle_positions(ids)
+        elif attribute == "v":
+            doubles = gather_particle_velocities(ids)
+        else:
+            doubles = gather_particle_forces(ids)
+        double_values = np.empty(doubles.size(), dtype=float)
+        for i in range(doubles.size()):
+            double_values[i] = doubles[i]
+        values = double_values.reshape((-1, 3))
+
+    return values[np.searchsorted(ids, particle_slice.id_selection)]
+
+
 def _add_particle_slice_properties():
     """
     Automatically add all of ParticleHandle's properties to ParticleSlice.
@@ -2204,6 +2335,11 @@ def _add_particle_slice_properties():
         if N == 0:
             return np.empty(0, dtype=type(None))
 
+        # slices that fit into one prefetch chunk are fetched with a
+        # single collective as well, which sends only their members
+        if attribute in gathered_attributes and N > particle_slice._chunk_size:
+            return get_slice_gathered(particle_slice, attribute)
+
         # get first slice member to determine its type
         target = getattr(ParticleHandle(
             particle_slice.id_selection[0]), attribute)
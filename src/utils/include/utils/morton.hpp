@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * This file is part of ESPResSo.
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef UTILS_MORTON_HPP
+#define UTILS_MORTON_HPP
+
+#include "Vector.hpp"
+
+#include <cstdint>
+
+namespace Utils {
+namespace detail {
+/** Insert two zero bits in front of each of the lower 21 bits. */
+constexpr inline uint64_t spread_bits_3(uint64_t x) {
+  x &= 0x1fffffu;
+  x = (x | x << 32) & 0x1f00000000ffffu;
+  x = (x | x << 16) & 0x1f0000ff0000ffu;
+  x = (x | x << 8) & 0x100f00f00f00f00fu;
+  x = (x | x << 4) & 0x10c30c30c30c30c3u;
+  x = (x | x << 2) & 0x1249249249249249u;
+  return x;
+}
+} // namespace detail
+
+/**
+ * @brief Morton (Z-order) index of a point on a 3d grid.
+ *
+ * The bits of the coordinates are interleaved, with the first
+ * coordinate in the lowest bit. Points that are close on the
+ * grid mostly have close indices. Only the lower 21 bits of
+ * every coordinate are used.
+ *
+ * @param x First coordinate.
+ * @param y Second coordinate.
+ * @param z Third coordinate.
+ * @return Morton index.
+ */
+constexpr inline uint64_t morton_index(uint32_t x, uint32_t y, uint32_t z) {
+  return detail::spread_bits_3(x) | (detail::spread_bits_3(y) << 1) |
+         (detail::spread_bits_3(z) << 2);
+}
+
+/**
+ * @brief Morton (Z-order) index of a point on a 3d grid.
+ */
+inline uint64_t morton_index(Vector<unsigned, 3> const &pos) {
+  return morton_index(pos[0], pos[1], pos[2]);
+}
+} // namespace Utils
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2020 The ESPResSo project
+ *
+ * ESPResSo is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ESPResSo is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Utils::morton_index test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "utils/morton.hpp"
+
+#include <cstdint>
+#include <set>
+
+BOOST_AUTO_TEST_CASE(interleave) {
+  static_assert(Utils::morton_index(0u, 0u, 0u) == 0u, "");
+  static_assert(Utils::morton_index(1u, 0u, 0u) == 1u, "");
+  static_assert(Utils::morton_index(0u, 1u, 0u) == 2u, "");
+  static_assert(Utils::morton_index(0u, 0u, 1u) == 4u, "");
+  static_assert(Utils::morton_index(2u, 0u, 0u) == 8u, "");
+
+  BOOST_CHECK_EQUAL(Utils::morton_index(5u, 3u, 6u),
+                    (1u << 0) | (1u << 1) | (1u << 4) | (1u << 5) | (1u << 6) |
+                        (1u << 8));
+  BOOST_CHECK_EQUAL(Utils::morton_index(Utils::Vector<unsigned, 3>{5, 3, 6}),
+                    Utils::morton_index(5u, 3u, 6u));
+
+  /* all 21 bits per coordinate are used */
+  auto const max = (1u << 21) - 1u;
+  BOOST_CHECK_EQUAL(Utils::morton_index(max, max, max),
+                    (uint64_t{1} << 63) - 1u);
+  BOOST_CHECK_EQUAL(Utils::morton_index(0u, 0u, 1u << 20), uint64_t{1} << 62);
+  /* higher bits are ignored */
+  BOOST_CHECK_EQUAL(Utils::morton_index(1u << 21, 0u, 0u), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(bijective) {
+  std::set<uint64_t> indices;
+  for (unsigned x = 0; x < 8; x++)
+    for (unsigned y = 0; y < 8; y++)
+      for (unsigned z = 0; z < 8; z++)
+        indices.insert(Utils::morton_index(x, y, z));
+
+  BOOST_CHECK_EQUAL(indices.size(), 512u);
+  BOOST_CHECK_EQUAL(*indices.rbegin(), 511u);
+}
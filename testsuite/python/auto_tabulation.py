@@ -0,0 +1,105 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+import espressomd
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES", "SOFT_SPHERE", "GAUSSIAN"])
+class AutoTabulation(ut.TestCase):
+    """Compare the forces from the automatic spline tables
+    with the analytic potentials."""
+    system = espressomd.System(box_l=[7.0, 7.0, 7.0])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.3
+
+    def setUp(self):
+        np.random.seed(17)
+        n_part = 250
+        self.system.part.add(
+            pos=np.random.random((n_part, 3)) * self.system.box_l,
+            type=np.random.randint(0, 2, n_part))
+
+        inter = self.system.non_bonded_inter
+        inter[0, 0].lennard_jones.set_params(
+            epsilon=1.0, sigma=1.0, cutoff=2.5, shift="auto")
+        inter[0, 0].soft_sphere.set_params(a=0.5, n=6, cutoff=1.5)
+        inter[0, 1].lennard_jones.set_params(
+            epsilon=0.8, sigma=0.9, cutoff=2**(1. / 6.) * 0.9, shift="auto")
+        inter[0, 1].gaussian.set_params(eps=0.4, sig=0.8, cutoff=2.0)
+
+        # remove overlaps so that the forces are well conditioned
+        self.system.integrator.set_steepest_descent(
+            f_max=0, gamma=0.1, max_displacement=0.01)
+        self.system.integrator.run(100)
+        self.system.integrator.set_vv()
+
+    def tearDown(self):
+        self.system.non_bonded_inter.set_auto_tabulation(n_intervals=0)
+        self.system.part.clear()
+        self.system.non_bonded_inter.reset()
+
+    def test_forces(self):
+        self.system.integrator.run(0, recalc_forces=True)
+        ref_forces = np.copy(self.system.part[:].f)
+
+        self.system.non_bonded_inter.set_auto_tabulation(n_intervals=2000)
+        self.system.integrator.run(0, recalc_forces=True)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].f), ref_forces, atol=1e-3)
+
+        # the tables follow changes of the interactions
+        self.system.non_bonded_inter[1, 1].gaussian.set_params(
+            eps=0.3, sig=1.0, cutoff=2.5)
+        self.system.non_bonded_inter.set_auto_tabulation(n_intervals=0)
+        self.system.integrator.run(0, recalc_forces=True)
+        ref_forces = np.copy(self.system.part[:].f)
+        self.system.non_bonded_inter.set_auto_tabulation(n_intervals=2000)
+        self.system.integrator.run(0, recalc_forces=True)
+        np.testing.assert_allclose(
+            np.copy(self.system.part[:].f), ref_forces, atol=1e-3)
+
+    def test_report(self):
+        inter = self.system.non_bonded_inter
+        with self.assertRaises(ValueError):
+            inter.set_auto_tabulation(n_intervals=-1)
+        with self.assertRaises(ValueError):
+            inter.set_auto_tabulation(max_force=0.)
+
+        self.assertEqual(inter.get_auto_tabulation()["tables"], [])
+
+        inter.set_auto_tabulation(n_intervals=200, max_force=1e3)
+        state = inter.get_auto_tabulation()
+        self.assertEqual(state["n_intervals"], 200)
+        self.assertEqual(state["max_force"], 1e3)
+        tables = {t["types"]: t for t in state["tables"]}
+        self.assertEqual(set(tables.keys()), {(0, 0), (0, 1)})
+        self.assertAlmostEqual(tables[(0, 0)]["r_cut"], 2.5)
+        self.assertAlmostEqual(tables[(0, 1)]["r_cut"], 2.0)
+        coarse_error = tables[(0, 0)]["max_error"]
+        self.assertGreaterEqual(tables[(0, 0)]["n_intervals"], 200)
+
+        inter.set_auto_tabulation(n_intervals=2000, max_force=1e3)
+        fine = {t["types"]: t for t in inter.get_auto_tabulation()["tables"]}
+        self.assertLess(fine[(0, 0)]["max_error"], 0.1 * coarse_error)
+
+
+if __name__ == "__main__":
+    ut.main()
@@ -17,7 +17,10 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 import unittest as ut
+import unittest_decorators as utx
 import espressomd
+import espressomd.electrostatics
+import espressomd.interactions
 import numpy as np
 
 
@@ -33,6 +36,12 @@ class CellSystem(ut.TestCase):
         s = self.system.cell_system.get_state()
         self.assertEqual(
             [s['use_verlet_list'], s['type']], [1, "domain_decomposition"])
+        self.assertFalse(s['use_morton_order'])
+        self.system.cell_system.set_domain_decomposition(
+            use_morton_order=True)
+        s = self.system.cell_system.get_state()
+        self.assertTrue(s['use_morton_order'])
+        self.system.cell_system.set_domain_decomposition()
 
     def test_node_grid(self):
         self.system.cell_system.set_domain_decomposition()
@@ -44,6 +53,218 @@ class CellSystem(ut.TestCase):
         np.testing.assert_array_equal(
             s['node_grid'], [n_nodes, 1, 1])
 
+    @utx.skipIfMissingFeatures(["LENNARD_JONES"])
+    def test_adaptive_skin(self):
+        system = self.system
+        system.cell_system.set_domain_decomposition()
+        system.box_l = [8.0, 8.0, 8.0]
+        system.time_step = 0.01
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1.0, sigma=1.0, cutoff=2**(1. / 6.), shift="auto")
+        np.random.seed(42)
+        system.part.add(pos=np.random.random((200, 3)) * system.box_l,
+                        v=np.random.normal(size=(200, 3)))
+        system.integrator.set_steepest_descent(
+            f_max=0, gamma=0.1, max_displacement=0.01)
+        system.integrator.run(100)
+        system.integrator.set_vv()
+
+        with self.assertRaises(ValueError):
+            system.cell_system.adaptive_skin_interval = -1
+        # A skin this small requires a resort in every step
+        system.cell_system.skin = 0.01
+        system.cell_system.adaptive_skin_interval = 10
+        self.assertEqual(
+            system.cell_system.get_state()["adaptive_skin_interval"], 10)
+        system.integrator.run(200)
+        skin = system.cell_system.skin
+        self.assertGreater(skin, 0.01)
+        self.assertLessEqual(skin, 0.5 * system.box_l[0])
+
+        system.cell_system.adaptive_skin_interval = 0
+        system.part.clear()
+        system.non_bonded_inter[0, 0].lennard_jones.deactivate()
+        system.box_l = [5.0, 5.0, 5.0]
+        system.cell_system.skin = 0.0
+
+    @utx.skipIfMissingFeatures(["ELECTROSTATICS", "WCA"])
+    def test_pair_class_lists(self):
+        system = self.system
+        system.cell_system.set_domain_decomposition(use_verlet_lists=True)
+        system.box_l = [8.0, 8.0, 8.0]
+        system.cell_system.skin = 0.3
+        system.non_bonded_inter[0, 0].wca.set_params(epsilon=1.0, sigma=1.0)
+        np.random.seed(17)
+        n_part = 200
+        system.part.add(pos=np.random.random((n_part, 3)) * system.box_l,
+                        q=np.resize([1., -1.], n_part),
+                        type=np.resize([0, 0, 1, 1], n_part))
+        dh = espressomd.electrostatics.DH(prefactor=1.0, kappa=0.5, r_cut=3.0)
+        system.actors.add(dh)
+
+        self.assertFalse(system.cell_system.use_pair_class_lists)
+        system.integrator.run(0, recalc_forces=True)
+        ref_forces = np.copy(system.part[:].f)
+
+        system.cell_system.use_pair_class_lists = True
+        self.assertTrue(system.cell_system.get_state()["use_pair_class_lists"])
+        # rebuild the lists with the classes
+        system.cell_system.skin = 0.3
+        system.integrator.run(0, recalc_forces=True)
+        np.testing.assert_allclose(
+            np.copy(system.part[:].f), ref_forces, atol=1e-10)
+
+        system.cell_system.use_pair_class_lists = False
+        system.actors.clear()
+        system.part.clear()
+        system.non_bonded_inter[0, 0].wca.deactivate()
+        system.box_l = [5.0, 5.0, 5.0]
+        system.cell_system.skin = 0.0
+
+    def compare_trajectories(self, set_cell_system, n_steps=100,
+                             check=None):
+        """
+        Integrate a perturbed WCA lattice once with the cell system set by
+        ``set_cell_system(False)`` and once with ``set_cell_system(True)``.
+        ``check(value)`` is called after each run. Returns the positions,
+        forces and total energies of both runs.
+
+        """
+        system = self.system
+        system.box_l = [6.0, 6.0, 6.0]
+        system.cell_system.skin = 0.3
+        system.time_step = 0.01
+        system.non_bonded_inter[0, 0].wca.set_params(epsilon=1.0, sigma=1.0)
+        np.random.seed(42)
+        lattice = np.mgrid[0:6, 0:6, 0:6].reshape(3, -1).T + 0.5
+        pos = lattice + 0.1 * (np.random.random(lattice.shape) - 0.5)
+        vel = np.random.random(lattice.shape) - 0.5
+
+        results = []
+        for value in (False, True):
+            set_cell_system(value)
+            system.part.add(pos=pos, v=vel)
+            system.integrator.run(n_steps)
+            results.append((np.copy(system.part[:].pos),
+                            np.copy(system.part[:].f),
+                            system.analysis.energy()["total"]))
+            if check is not None:
+                check(value)
+            system.part.clear()
+
+        set_cell_system(False)
+        system.cell_system.set_domain_decomposition()
+        system.non_bonded_inter[0, 0].wca.deactivate()
+        system.box_l = [5.0, 5.0, 5.0]
+        system.cell_system.skin = 0.0
+        return results
+
+    @utx.skipIfMissingFeatures(["WCA"])
+    def test_ghost_overlap(self):
+        def set_cell_system(value):
+            self.system.cell_system.use_ghost_overlap = value
+            self.assertEqual(
+                self.system.cell_system.get_state()["use_ghost_overlap"],
+                value)
+
+        results = self.compare_trajectories(set_cell_system)
+        # same trajectory up to the order of the force summation
+        np.testing.assert_allclose(results[1][0], results[0][0], atol=1e-8)
+        np.testing.assert_allclose(results[1][1], results[0][1], atol=1e-6)
+
+    def check_ghost_exchange(self, option):
+        """
+        Integrate with and without a ghost exchange option of the
+        domain decomposition and compare the trajectories.
+
+        """
+        def set_cell_system(value):
+            self.system.cell_system.set_domain_decomposition(
+                **{option: value})
+            self.assertEqual(
+                self.system.cell_system.get_state()[option], value)
+
+        results = self.compare_trajectories(set_cell_system)
+        np.testing.assert_allclose(results[1][0], results[0][0], atol=1e-10)
+        np.testing.assert_allclose(results[1][1], results[0][1], atol=1e-8)
+
+    @utx.skipIfMissingFeatures(["WCA"])
+    def test_neighbor_collectives(self):
+        self.check_ghost_exchange("use_neighbor_collectives")
+
+    @utx.skipIfMissingFeatures(["WCA"])
+    def test_shared_memory(self):
+        self.check_ghost_exchange("use_shared_memory")
+
+    @utx.skipIfMissingFeatures(["WCA"])
+    def test_eighth_shell(self):
+        def set_cell_system(eighth_shell):
+            if eighth_shell:
+                self.system.cell_system.set_eighth_shell()
+                self.assertEqual(
+                    self.system.cell_system.get_state()["type"],
+                    "eighth_shell")
+            else:
+                self.system.cell_system.set_domain_decomposition()
+
+        results = self.compare_trajectories(set_cell_system)
+        # same trajectory up to the order of the force summation
+        np.testing.assert_allclose(results[1][0], results[0][0], atol=1e-8)
+        np.testing.assert_allclose(results[1][1], results[0][1], atol=1e-6)
+        self.assertAlmostEqual(results[1][2], results[0][2], delta=1e-6)
+
+    def test_eighth_shell_exceptions(self):
+        # the partners of bonds, virtual sites and collisions beyond the
+        # lower boundaries of the local box have no ghosts
+        system = self.system
+        system.time_step = 0.01
+        system.cell_system.set_eighth_shell()
+        msg = "The eighth-shell decomposition does not support "
+        harmonic = espressomd.interactions.HarmonicBond(k=1., r_0=0.5)
+        system.bonded_inter.add(harmonic)
+
+        system.part.add(id=0, pos=[0.1, 0.1, 0.1])
+        system.part.add(id=1, pos=[4.9, 0.1, 0.1])
+        system.part[0].add_bond((harmonic, 1))
+        with self.assertRaisesRegex(Exception, msg + "bonds"):
+            system.integrator.run(0)
+        system.part[0].delete_all_bonds()
+        system.integrator.run(0)
+
+        if espressomd.has_features("VIRTUAL_SITES"):
+            system.part[1].virtual = True
+            with self.assertRaisesRegex(Exception, msg + "bonds and virtual"):
+                system.integrator.run(0)
+            system.part[1].virtual = False
+
+        if espressomd.has_features("COLLISION_DETECTION"):
+            system.collision_detection.set_params(
+                mode="bind_centers", distance=0.1, bond_centers=harmonic)
+            with self.assertRaisesRegex(Exception, msg + "collision"):
+                system.integrator.run(0)
+            system.collision_detection.set_params(mode="off")
+
+        system.part.clear()
+        system.cell_system.set_domain_decomposition()
+
+    @utx.skipIfMissingFeatures(["WCA"])
+    def test_ghost_position_deltas(self):
+        def set_cell_system(value):
+            self.system.cell_system.use_ghost_position_deltas = value
+            self.assertEqual(
+                self.system.cell_system.get_state()[
+                    "use_ghost_position_deltas"], value)
+
+        def check(value):
+            cell_system = self.system.cell_system
+            if value:
+                self.assertLess(
+                    cell_system.ghost_position_deltas_force_error(), 1e-4)
+
+        results = self.compare_trajectories(set_cell_system, n_steps=20,
+                                            check=check)
+        np.testing.assert_allclose(results[1][0], results[0][0], atol=1e-5)
+
 
 if __name__ == "__main__":
     ut.main()
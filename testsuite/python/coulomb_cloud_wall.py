@@ -101,6 +101,21 @@ class CoulombCloudWall(ut.TestCase):
         self.S.integrator.run(0)
         self.compare("p3m", energy=True, prefactor=3)
 
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m_analytic_diff(self):
+        """
+        This checks P3M with analytical differentiation.
+
+        """
+
+        self.S.actors.add(
+            espressomd.electrostatics.P3M(
+                prefactor=3, r_cut=1.001, accuracy=1e-3,
+                mesh=64, cao=7, alpha=2.70746, tune=False,
+                analytic_diff=True))
+        self.S.integrator.run(0)
+        self.compare("p3m_analytic_diff", energy=True, prefactor=3)
+
     @utx.skipIfMissingGPU()
     def test_p3m_gpu(self):
         self.S.actors.add(
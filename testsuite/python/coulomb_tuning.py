@@ -17,6 +17,8 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 import numpy as np
+import os
+import tempfile
 import unittest as ut
 import unittest_decorators as utx
 
@@ -73,6 +75,27 @@ class CoulombCloudWallTune(ut.TestCase):
         self.system.integrator.run(0)
         self.compare("p3m")
 
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m_tuning_cache(self):
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            cache = os.path.join(tmp_dir, "p3m_tuning.txt")
+            params = []
+            for _ in range(2):
+                p3m = espressomd.electrostatics.P3M(
+                    prefactor=1., accuracy=5e-4, tune=True,
+                    tuning_cache=cache)
+                self.system.actors.add(p3m)
+                self.system.integrator.run(0)
+                self.compare("p3m")
+                params.append(p3m.get_params())
+                self.system.actors.clear()
+            # the second run reuses the result stored by the first one
+            with open(cache) as f:
+                self.assertEqual(len(f.readlines()), 1)
+            for key in ("mesh", "cao", "alpha", "r_cut"):
+                np.testing.assert_allclose(
+                    np.copy(params[1][key]), np.copy(params[0][key]))
+
     @utx.skipIfMissingGPU()
     def test_p3m_gpu(self):
         # We have to add some tolerance here, because the reference
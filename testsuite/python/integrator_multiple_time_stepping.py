@@ -0,0 +1,128 @@
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import numpy as np
+import unittest as ut
+import unittest_decorators as utx
+
+import espressomd
+import espressomd.electrostatics
+
+
+@utx.skipIfMissingFeatures(["P3M", "LENNARD_JONES"])
+class MultipleTimeStepping(ut.TestCase):
+
+    """Velocity Verlet with the long-range forces calculated only every
+    few steps (r-RESPA)."""
+
+    system = espressomd.System(box_l=3 * [8.])
+    system.time_step = 0.005
+    system.cell_system.skin = 0.4
+
+    n_part = 150
+
+    @classmethod
+    def setUpClass(cls):
+        np.random.seed(42)
+        system = cls.system
+        system.part.add(pos=np.random.random((cls.n_part, 3)) * system.box_l,
+                        q=np.resize((1., -1.), cls.n_part))
+        system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=2**(1. / 6.), shift="auto")
+        system.integrator.set_steepest_descent(
+            f_max=0, gamma=0.01, max_displacement=0.05)
+        system.integrator.run(300)
+        system.part[:].v = np.random.normal(size=(cls.n_part, 3))
+        system.actors.add(espressomd.electrostatics.P3M(
+            prefactor=2., accuracy=1e-4, r_cut=2., mesh=24, cao=5))
+        cls.pos = np.copy(system.part[:].pos)
+        cls.vel = np.copy(system.part[:].v)
+
+    def setUp(self):
+        self.system.part[:].pos = self.pos
+        self.system.part[:].v = self.vel
+
+    def tearDown(self):
+        self.system.thermostat.turn_off()
+        self.system.integrator.set_vv()
+
+    def long_range_forces(self):
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=0., sigma=1., cutoff=2**(1. / 6.), shift="auto")
+        self.system.integrator.run(0, recalc_forces=True)
+        forces = np.copy(self.system.part[:].f)
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1., sigma=1., cutoff=2**(1. / 6.), shift="auto")
+        return forces
+
+    def test_impulses(self):
+        # the long-range forces are multiplied by the interval on the
+        # steps on which they are calculated
+        f_ref = self.long_range_forces()
+        self.system.integrator.set_vv(long_range_interval=3)
+        np.testing.assert_allclose(
+            self.long_range_forces(), 3. * f_ref, atol=1e-10)
+
+    def test_integrator_switch(self):
+        # the next integrator does not start from the forces with the
+        # multiples of the long-range forces
+        self.system.integrator.run(0, recalc_forces=True)
+        f_ref = np.copy(self.system.part[:].f)
+        self.system.integrator.set_vv(long_range_interval=3)
+        self.system.integrator.run(0)
+        self.assertGreater(
+            np.max(np.abs(self.system.part[:].f - f_ref)), 1e-3)
+        self.system.thermostat.set_brownian(kT=0., gamma=1., seed=42)
+        self.system.integrator.set_brownian_dynamics()
+        self.system.integrator.run(0)
+        np.testing.assert_allclose(self.system.part[:].f, f_ref, atol=1e-10)
+
+    def run_energy_drift(self, interval):
+        system = self.system
+        system.integrator.set_vv(long_range_interval=interval)
+        energy = [system.analysis.energy()["total"]]
+        for _ in range(10):
+            system.integrator.run(12)
+            energy.append(system.analysis.energy()["total"])
+        return np.max(np.abs(np.array(energy) - energy[0])) / self.n_part
+
+    def test_energy_conservation(self):
+        drift = self.run_energy_drift(1)
+        self.assertLess(drift, 1e-3)
+        for interval in (2, 3, 4):
+            self.setUp()
+            self.assertLess(self.run_energy_drift(interval), 5e-3)
+
+    def test_trajectory(self):
+        # the trajectories agree with the ones of plain velocity Verlet
+        # over a short time
+        self.system.integrator.set_vv()
+        self.system.integrator.run(24)
+        pos_ref = np.copy(self.system.part[:].pos)
+        self.setUp()
+        self.system.integrator.set_vv(long_range_interval=4)
+        self.system.integrator.run(24)
+        np.testing.assert_allclose(self.system.part[:].pos, pos_ref,
+                                   atol=1e-3)
+
+    def test_exceptions(self):
+        with self.assertRaisesRegex(ValueError, "long_range_interval"):
+            self.system.integrator.set_vv(long_range_interval=0)
+
+
+if __name__ == "__main__":
+    ut.main()
@@ -80,6 +80,32 @@ class LennardJonesTest(ut.TestCase):
         self.system.integrator.run(recalc_forces=True, steps=0)
         self.check()
 
+    def test_dd_morton_order(self):
+        self.system.cell_system.set_domain_decomposition(
+            use_morton_order=True)
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        self.system.cell_system.set_domain_decomposition()
+
+        self.check()
+
+    def test_dd_soa(self):
+        self.system.cell_system.set_domain_decomposition()
+        self.system.cell_system.use_soa_kernels = True
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        self.system.cell_system.use_soa_kernels = False
+
+        self.check()
+
+    def test_dd_cluster_pair_list(self):
+        self.system.cell_system.set_domain_decomposition()
+        self.system.cell_system.use_soa_kernels = True
+        self.system.cell_system.use_cluster_pair_list = True
+        self.system.integrator.run(recalc_forces=True, steps=0)
+        self.system.cell_system.use_cluster_pair_list = False
+        self.system.cell_system.use_soa_kernels = False
+
+        self.check()
+
 
 if __name__ == '__main__':
     ut.main()
@@ -0,0 +1,96 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+import espressomd
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES"])
+class LoadBalancing(ut.TestCase):
+    system = espressomd.System(box_l=[12.0, 12.0, 12.0])
+    system.time_step = 0.005
+    system.cell_system.skin = 0.3
+    system.non_bonded_inter[0, 0].lennard_jones.set_params(
+        epsilon=1.0, sigma=1.0, cutoff=2**(1. / 6.), shift="auto")
+    n_nodes = system.cell_system.get_state()["n_nodes"]
+
+    def setUp(self):
+        self.system.cell_system.set_domain_decomposition()
+        self.system.cell_system.node_grid = [self.n_nodes, 1, 1]
+        self.system.cell_system.load_balancing_interval = 0
+
+        # All particles are in the left quarter of the box
+        np.random.seed(42)
+        n_part = 300
+        pos = np.random.random((n_part, 3)) * self.system.box_l
+        pos[:, 0] *= 0.25
+        self.system.part.add(pos=pos, v=np.random.random((n_part, 3)) - 0.5)
+        self.system.integrator.set_steepest_descent(
+            f_max=0, gamma=0.1, max_displacement=0.01)
+        self.system.integrator.run(100)
+        self.system.integrator.set_vv()
+
+    def tearDown(self):
+        self.system.cell_system.load_balancing_interval = 0
+        self.system.part.clear()
+
+    def run_trajectory(self, interval):
+        self.system.cell_system.load_balancing_interval = interval
+        self.system.integrator.run(40)
+        return np.copy(self.system.part[:].pos), np.copy(
+            self.system.part[:].f)
+
+    def test_state(self):
+        self.assertEqual(
+            self.system.cell_system.get_state()["load_balancing_interval"],
+            0)
+        self.system.cell_system.load_balancing_interval = 5
+        self.assertEqual(
+            self.system.cell_system.load_balancing_interval, 5)
+        with self.assertRaises(ValueError):
+            self.system.cell_system.load_balancing_interval = -1
+
+    def test_trajectory(self):
+        pos0 = np.copy(self.system.part[:].pos)
+        v0 = np.copy(self.system.part[:].v)
+        n_part_regular = self.system.cell_system.resort()
+        pos_ref, f_ref = self.run_trajectory(0)
+
+        self.system.part[:].pos = pos0
+        self.system.part[:].v = v0
+        pos, f = self.run_trajectory(5)
+        n_part_balanced = self.system.cell_system.resort()
+
+        # The boundaries of the local boxes do not change the physics
+        np.testing.assert_allclose(pos, pos_ref, atol=1e-8)
+        np.testing.assert_allclose(f, f_ref, atol=1e-6)
+
+        if self.n_nodes > 1:
+            # The particles are distributed more evenly
+            self.assertLess(max(n_part_balanced), max(n_part_regular))
+
+        # Disabling the load balancing restores the regular boxes
+        self.system.cell_system.load_balancing_interval = 0
+        self.system.part[:].pos = pos0
+        self.assertEqual(
+            list(self.system.cell_system.resort()), list(n_part_regular))
+
+
+if __name__ == "__main__":
+    ut.main()
@@ -19,6 +19,7 @@
 import unittest as ut
 import unittest_decorators as utx
 import espressomd
+import espressomd.particle_data
 import numpy as np
 from espressomd.interactions import FeneBond
 
@@ -293,6 +294,78 @@ class ParticleProperties(ut.TestCase):
             # Cause a different mpi callback to uncover deadlock immediately
             _ = getattr(s.part[:], p)
 
+    def test_batched_slice_setters(self):
+        """Tests the properties that slices set in one message per node."""
+
+        s = self.system
+        s.part.clear()
+        n_part = 50
+        s.part.add(pos=s.box_l * np.random.random((n_part, 3)))
+        ids = np.random.permutation(n_part)
+        v = np.random.random((n_part, 3))
+        types = np.random.randint(0, 3, n_part)
+        s.setup_type_map([0, 1, 2, 5])
+
+        s.part[ids].v = v
+        s.part[ids].f = 2 * v
+        s.part[ids].type = types
+        s.part[ids].mol_id = types + 1
+        np.testing.assert_allclose(s.part[ids].v, v, atol=self.tol)
+        np.testing.assert_allclose(s.part[ids].f, 2 * v, atol=self.tol)
+        np.testing.assert_equal(s.part[ids].type, types)
+        np.testing.assert_equal(s.part[ids].mol_id, types + 1)
+        for t in range(3):
+            self.assertEqual(s.number_of_particles(type=t),
+                             np.sum(types == t))
+        s.part[:].type = 5
+        self.assertEqual(s.number_of_particles(type=5), n_part)
+        self.assertEqual(s.number_of_particles(type=0), 0)
+        if espressomd.has_features("ELECTROSTATICS"):
+            q = np.random.random(n_part)
+            s.part[ids].q = q
+            np.testing.assert_allclose(s.part[ids].q, q, atol=self.tol)
+            s.part[:].q = -1
+            np.testing.assert_equal(s.part[:].q, -np.ones(n_part))
+        if espressomd.has_features("MASS"):
+            s.part[:].mass = 2.
+            np.testing.assert_equal(s.part[:].mass, 2. * np.ones(n_part))
+
+        # invalid values are rejected before any particle is changed
+        with self.assertRaises(ValueError):
+            s.part[:].type = np.resize([1, -1], n_part)
+        self.assertEqual(s.number_of_particles(type=5), n_part)
+        with self.assertRaises(ValueError):
+            s.part[:].mol_id = 1.5
+
+    def test_gathered_slice_getters(self):
+        """Tests the properties that large slices gather in one collective."""
+
+        s = self.system
+        s.part.clear()
+        n_part = 200
+        ids = np.random.permutation(3 * n_part)[:n_part]
+        pos = 3 * s.box_l * (np.random.random((n_part, 3)) - 0.3)
+        s.part.add(id=ids, pos=pos, v=pos[::-1], f=2 * pos,
+                   type=ids % 4)
+        # slices larger than the prefetch chunk are gathered
+        for chunk_size in (10000, 50):
+            for sel in (ids, np.sort(ids), ids[:n_part // 2]):
+                part_slice = espressomd.particle_data.ParticleSlice(
+                    sel, prefetch_chunk_size=chunk_size)
+                for name in ("pos", "v", "f", "type"):
+                    ref = [getattr(s.part[pid], name) for pid in sel]
+                    values = getattr(part_slice, name)
+                    np.testing.assert_allclose(values, ref, atol=self.tol)
+        np.testing.assert_allclose(s.part[:].pos, pos[np.argsort(ids)],
+                                   atol=self.tol)
+
+        # ranks without particles take part in the collective
+        s.part[:].pos = np.zeros((n_part, 3))
+        part_slice = espressomd.particle_data.ParticleSlice(
+            ids, prefetch_chunk_size=50)
+        np.testing.assert_allclose(part_slice.pos, np.zeros((n_part, 3)),
+                                   atol=self.tol)
+
     def test_remove_particle(self):
         """Tests that if a particle is removed,
         it no longer exists and bonds to the removed particle are
@@ -305,6 +378,41 @@ class ParticleProperties(ut.TestCase):
         self.assertFalse(self.system.part.exists(self.pid))
         self.assertEqual(len(p2.bonds), 0)
 
+    def test_bulk_add_remove(self):
+        """Tests adding and removing many particles at once."""
+
+        system = self.system
+        system.part.clear()
+        n_part = 100
+        ids = np.arange(2 * n_part, step=2)
+        pos = np.random.random((n_part, 3)) * system.box_l
+        v = np.random.random((n_part, 3))
+        types = np.resize([0, 1, 2], n_part)
+        system.part.add(id=ids, pos=pos, v=v, type=types)
+        self.assertEqual(len(system.part), n_part)
+        np.testing.assert_equal(system.part[:].id, ids)
+        np.testing.assert_allclose(system.part[:].pos, pos, atol=self.tol)
+        np.testing.assert_allclose(system.part[:].v, v, atol=self.tol)
+        np.testing.assert_equal(system.part[:].type, types)
+        # existing and duplicate ids are rejected as a whole
+        with self.assertRaises(Exception):
+            system.part.add(id=[1000, 0], pos=np.zeros((2, 3)))
+        with self.assertRaises(Exception):
+            system.part.add(id=[1000, 1000], pos=np.zeros((2, 3)))
+        self.assertEqual(len(system.part), n_part)
+
+        system.setup_type_map([0])
+        # removing a slice removes the bonds to its particles
+        system.part[2].add_bond((self.f1, 0))
+        system.part[4].add_bond((self.f1, 6))
+        system.part[0:2 * n_part:4].remove()
+        self.assertEqual(len(system.part), n_part // 2)
+        np.testing.assert_equal(system.part[:].id, ids[1::2])
+        self.assertEqual(len(system.part[2].bonds), 0)
+        self.assertEqual(len(system.part[6].bonds), 0)
+        self.assertEqual(system.number_of_particles(type=0),
+                         np.sum(types[1::2] == 0))
+
     def test_bonds(self):
         """Tests bond addition and removal."""
 
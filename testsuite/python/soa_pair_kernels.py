@@ -0,0 +1,104 @@
+#
+# Copyright (C) 2020 The ESPResSo project
+#
+# This file is part of ESPResSo.
+#
+# ESPResSo is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ESPResSo is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+import unittest as ut
+import unittest_decorators as utx
+import numpy as np
+import espressomd
+import espressomd.electrostatics
+
+
+@utx.skipIfMissingFeatures(["LENNARD_JONES", "WCA"])
+class SoAPairKernels(ut.TestCase):
+    """Compare the forces of the structure-of-arrays pair kernels
+    with the generic pair loop."""
+    system = espressomd.System(box_l=[6.0, 7.0, 8.0])
+    system.time_step = 0.01
+    system.cell_system.skin = 0.3
+
+    def setUp(self):
+        np.random.seed(42)
+        n_part = 300
+        self.system.part.add(
+            pos=np.random.random((n_part, 3)) * self.system.box_l,
+            type=np.random.randint(0, 3, n_part))
+
+        self.system.non_bonded_inter[0, 0].lennard_jones.set_params(
+            epsilon=1.0, sigma=0.9, cutoff=2.0, shift="auto")
+        self.system.non_bonded_inter[0, 1].lennard_jones.set_params(
+            epsilon=0.6, sigma=1.0, cutoff=2.5, shift=0., min=0.3)
+        self.system.non_bonded_inter[1, 2].wca.set_params(
+            epsilon=1.2, sigma=0.8)
+        self.system.non_bonded_inter[2, 2].wca.set_params(
+            epsilon=0.8, sigma=1.0)
+
+        # remove overlaps so that the forces are well conditioned
+        self.system.integrator.set_steepest_descent(
+            f_max=0, gamma=0.1, max_displacement=0.01)
+        self.system.integrator.run(100)
+        self.system.integrator.set_vv()
+
+    def tearDown(self):
+        self.system.cell_system.use_soa_kernels = False
+        self.system.cell_system.use_cluster_pair_list = False
+        self.system.actors.clear()
+        self.system.part.clear()
+        self.system.non_bonded_inter.reset()
+
+    def forces(self, use_soa_kernels):
+        self.system.cell_system.use_soa_kernels = use_soa_kernels
+        self.system.integrator.run(0, recalc_forces=True)
+        return np.copy(self.system.part[:].f)
+
+    def check(self):
+        self.system.cell_system.set_domain_decomposition(use_verlet_lists=True)
+        f_ref = self.forces(False)
+        self.assertGreater(np.max(np.abs(f_ref)), 0.)
+        np.testing.assert_allclose(self.forces(True), f_ref, atol=1e-10)
+        # forces after a resort, the layout of the mirror is rebuilt
+        self.system.part[:].pos = self.system.part[:].pos + 0.5
+        f_ref = self.forces(False)
+        np.testing.assert_allclose(self.forces(True), f_ref, atol=1e-10)
+
+    def test_short_range(self):
+        self.check()
+
+    def test_cluster_pair_list(self):
+        self.system.cell_system.use_cluster_pair_list = True
+        self.check()
+
+    @utx.skipIfMissingFeatures(["EXCLUSIONS"])
+    def test_exclusions(self):
+        for pid in range(0, 100, 2):
+            self.system.part[pid].add_exclusion(pid + 1)
+        self.system.cell_system.use_cluster_pair_list = True
+        self.check()
+
+    @utx.skipIfMissingFeatures(["P3M"])
+    def test_p3m(self):
+        self.system.part[:].q = np.resize([1, -1], len(self.system.part))
+        self.system.actors.add(espressomd.electrostatics.P3M(
+            prefactor=2., r_cut=1.5, accuracy=1e-3, mesh=16, cao=5,
+            alpha=2.0, tune=False))
+        self.check()
+        self.system.cell_system.use_cluster_pair_list = True
+        self.check()
+
+
+if __name__ == "__main__":
+    ut.main()